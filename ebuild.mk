@@ -145,6 +145,25 @@ pkgconfigs                   += $(call kconf_enabled,ETUX_TIMER_HWHEEL, \
                                   libetux_timer_hwheel.pc)
 libetux_timer_hwheel.pc-tmpl := libetux_timer_hwheel_pkgconf_tmpl
 
+define libetux_timer_hybrid_pkgconf_tmpl
+prefix=$(PREFIX)
+exec_prefix=$${prefix}
+libdir=$${exec_prefix}/lib
+includedir=$${prefix}/include
+
+Name: libetux_timer_hybrid
+Description: eTux hybrid timer wheel / heap library
+Version: $(VERSION)
+Requires: libutils libstroll
+Cflags: -I$${includedir}
+Libs: -L$${libdir} \
+      -Wl,--push-state,--as-needed -letux_timer_hybrid -Wl,--pop-state
+endef
+
+pkgconfigs                   += $(call kconf_enabled,ETUX_TIMER_HYBRID, \
+                                  libetux_timer_hybrid.pc)
+libetux_timer_hybrid.pc-tmpl := libetux_timer_hybrid_pkgconf_tmpl
+
 ################################################################################
 # Source code tags generation
 ################################################################################
@@ -42,4 +42,20 @@
 #define atomic_dec_and_fetch(_atom) \
 	atomic_dec(_atom)
 
+#define atomic_xchg(_atom, _val) \
+	__atomic_exchange_n(_atom, _val, __ATOMIC_ACQ_REL)
+
+/*
+ * Store `_val' into `_atom' if it still holds the value pointed to by
+ * `_expect', otherwise load current value into `_expect'. Return true on
+ * success.
+ */
+#define atomic_cmpxchg(_atom, _expect, _val) \
+	__atomic_compare_exchange_n(_atom, \
+	                            _expect, \
+	                            _val, \
+	                            false, \
+	                            __ATOMIC_ACQ_REL, \
+	                            __ATOMIC_ACQUIRE)
+
 #endif /* _UTILS_ATOMIC_H */
@@ -20,6 +20,8 @@
 #define _UTILS_POLL_H
 
 #include <utils/cdefs.h>
+#include <stroll/dlist.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <sys/epoll.h>
 
@@ -56,12 +58,62 @@ typedef int (upoll_dispatch_fn)(struct upoll_worker *,
                                 uint32_t,
                                 const struct upoll *);
 
+/*
+ * Number of worker dispatching priorities, 0 being the highest one.
+ */
+#define UPOLL_PRIO_NR   (4U)
+#define UPOLL_DFLT_PRIO (UPOLL_PRIO_NR / 2)
+
+/*
+ * Events a worker may watch.
+ */
+#define UPOLL_WATCH_EVENTS \
+	((uint32_t)(EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLPRI))
+
+/*
+ * Operating mode flags a worker may be registered with, i.e.:
+ * - EPOLLET: edge-triggered notification ;
+ * - EPOLLONESHOT: the kernel disables the file descriptor once an event has
+ *   been reported. upoll re-arms it from next upoll_wait() call on, with
+ *   the watch set modified by the dispatch function using upoll_apply() if
+ *   any ;
+ * - EPOLLEXCLUSIVE: wake up a single poller out of all pollers watching the
+ *   same file descriptor. May only be combined with EPOLLIN, EPOLLOUT and
+ *   EPOLLET and the watch set of such worker cannot be modified once
+ *   registered.
+ *
+ * Mode flags are preserved by the upoll_*_watch() helpers.
+ */
+#define UPOLL_MODE_FLAGS \
+	((uint32_t)(EPOLLET | EPOLLONESHOT | EPOLLEXCLUSIVE))
+
 struct upoll_worker {
-	upoll_dispatch_fn * dispatch;
-	uint32_t            user;
-	uint32_t            kernel;
+	upoll_dispatch_fn *      dispatch;
+	int                      fd;
+	uint32_t                 user;
+	uint32_t                 kernel;
+	uint32_t                 ready;
+	unsigned int             prio;
+	struct stroll_dlist_node ring;
+	struct stroll_dlist_node journal;
 };
 
+/*
+ * Setup priority a worker is dispatched with when the poller dispatch ring is
+ * enabled (see upoll_setup_ring()). Applies to events collected from next
+ * upoll_dispatch() call on.
+ */
+static inline __utils_nonull(1) __utils_nothrow
+void
+upoll_setup_prio(struct upoll_worker * __restrict worker, unsigned int prio)
+{
+	upoll_assert_api(worker);
+	upoll_assert_api(worker->dispatch);
+	upoll_assert_api(prio < UPOLL_PRIO_NR);
+
+	worker->prio = prio;
+}
+
 static inline __utils_nonull(1) __utils_pure __utils_nothrow
 uint32_t
 upoll_watched_events(const struct upoll_worker * __restrict worker)
@@ -69,10 +121,9 @@ upoll_watched_events(const struct upoll_worker * __restrict worker)
 	upoll_assert_api(worker);
 	upoll_assert_api(worker->dispatch);
 	upoll_assert_api(!(worker->user &
-	                   ~((uint32_t)
-	                     (EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLPRI))));
+	                   ~(UPOLL_WATCH_EVENTS | UPOLL_MODE_FLAGS)));
 
-	return worker->user;
+	return worker->user & UPOLL_WATCH_EVENTS;
 }
 
 static inline __utils_nonull(1) __utils_nothrow
@@ -82,11 +133,9 @@ upoll_setup_watch(struct upoll_worker * __restrict worker, uint32_t events)
 	upoll_assert_api(worker);
 	upoll_assert_api(worker->dispatch);
 	upoll_assert_api(events);
-	upoll_assert_api(!(events &
-	                   ~((uint32_t)
-	                     (EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLPRI))));
+	upoll_assert_api(!(events & ~UPOLL_WATCH_EVENTS));
 
-	worker->user = events;
+	worker->user = (worker->user & UPOLL_MODE_FLAGS) | events;
 }
 
 static inline __utils_nonull(1) __utils_nothrow
@@ -96,9 +145,7 @@ upoll_enable_watch(struct upoll_worker * __restrict worker, uint32_t events)
 	upoll_assert_api(worker);
 	upoll_assert_api(worker->dispatch);
 	upoll_assert_api(events);
-	upoll_assert_api(!(events &
-	                   ~((uint32_t)
-	                     (EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLPRI))));
+	upoll_assert_api(!(events & ~UPOLL_WATCH_EVENTS));
 
 	worker->user |= events;
 }
@@ -110,17 +157,108 @@ upoll_disable_watch(struct upoll_worker * __restrict worker, uint32_t events)
 	upoll_assert_api(worker);
 	upoll_assert_api(worker->dispatch);
 	upoll_assert_api(events);
-	upoll_assert_api(!(events &
-	                   ~((uint32_t)
-	                     (EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLPRI))));
+	upoll_assert_api(!(events & ~UPOLL_WATCH_EVENTS));
 
 	worker->user &= ~events;
 }
 
+/*
+ * Dispatch ring.
+ *
+ * Holds workers which events have been collected from the kernel but not yet
+ * dispatched, one FIFO per priority, as well as the journal of workers which
+ * watch set modifications are pending, including EPOLLONESHOT workers waiting
+ * for re-arming.
+ */
+struct upoll_ring {
+	bool                     enabled;
+	bool                     dispatching;
+	unsigned int             budget;
+	unsigned int             count;
+	struct stroll_dlist_node ready[UPOLL_PRIO_NR];
+	struct stroll_dlist_node journal;
+};
+
+#if defined(CONFIG_UTILS_POLL_URING)
+struct upoll_uring;
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+
+#if defined(CONFIG_UTILS_POLL_TASK)
+struct upoll_tasks;
+#endif /* defined(CONFIG_UTILS_POLL_TASK) */
+
+#if defined(CONFIG_UTILS_POLL_BATCH)
+
+/*
+ * Self-sizing events batch state.
+ *
+ * At most `cur' events are collected per upoll_wait() call, `cur' ranging from
+ * `min' up to the events array capacity. `peak' is the largest number of
+ * events collected over the last `window' calls. `size' and `gran' are the
+ * events array mapping size and page granularity in bytes. Remaining fields
+ * are counters of upoll_wait() calls, calls which filled the whole batch and
+ * batch size changes.
+ */
+struct upoll_batch {
+	unsigned int  min;
+	unsigned int  cur;
+	unsigned int  peak;
+	unsigned int  window;
+	size_t        size;
+	size_t        gran;
+	unsigned long waits;
+	unsigned long saturated;
+	unsigned long grows;
+	unsigned long shrinks;
+};
+
+#endif /* defined(CONFIG_UTILS_POLL_BATCH) */
+
+#if defined(CONFIG_UTILS_POLL_BUSY)
+
+/*
+ * Adaptive busy polling state.
+ *
+ * `idle' is an exponentially weighted moving average of the time spent
+ * waiting for events and `spin' the spin window derived from it, both
+ * expressed in nanoseconds. `hits' counts spin phases which collected events
+ * and `misses' spin phases which ended up blocking.
+ */
+struct upoll_busy {
+	uint64_t      budget;
+	uint64_t      spin;
+	uint64_t      idle;
+	unsigned long hits;
+	unsigned long misses;
+};
+
+#endif /* defined(CONFIG_UTILS_POLL_BUSY) */
+
+/*
+ * Poller state.
+ *
+ * `nr' is the capacity of the `events' array, i.e. the number of events given
+ * to upoll_open(). upoll_setup_batch() overwrites it with its `max' argument;
+ * the number of events actually collected per upoll_wait() call is then given
+ * by upoll_get_batch_size().
+ */
 struct upoll {
 	unsigned int         nr;
 	int                  fd;
 	struct epoll_event * events;
+	struct upoll_ring *  ring;
+#if defined(CONFIG_UTILS_POLL_URING)
+	struct upoll_uring * uring;
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+#if defined(CONFIG_UTILS_POLL_BUSY)
+	struct upoll_busy *  busy;
+#endif /* defined(CONFIG_UTILS_POLL_BUSY) */
+#if defined(CONFIG_UTILS_POLL_BATCH)
+	struct upoll_batch * batch;
+#endif /* defined(CONFIG_UTILS_POLL_BATCH) */
+#if defined(CONFIG_UTILS_POLL_TASK)
+	struct upoll_tasks * tasks;
+#endif /* defined(CONFIG_UTILS_POLL_TASK) */
 };
 
 static inline __utils_nonull(1) __utils_nothrow __utils_pure
@@ -136,6 +274,16 @@ upoll_get_fd(const struct upoll * __restrict poller)
 	return poller->fd;
 }
 
+/*
+ * Apply watch set modifications made to a worker using the upoll_*_watch()
+ * helpers.
+ *
+ * When called from within a dispatch function, modifications are journaled
+ * and applied right before next upoll_wait() collects events. Successive
+ * modifications of a worker made during a dispatch pass are thus coalesced
+ * into at most one system call, and into none at all when its watch set is
+ * eventually restored.
+ */
 extern void
 upoll_apply(const struct upoll * __restrict  poller,
             int                              fd,
@@ -157,6 +305,24 @@ upoll_register_dispatch(const struct upoll * __restrict poller,
                         upoll_dispatch_fn *             dispatch)
 	__utils_nonull(1, 4, 5) __utils_nothrow __leaf;
 
+extern void
+upoll_ring_forget(const struct upoll * __restrict poller, int fd)
+	__utils_nonull(1) __utils_nothrow __leaf;
+
+#if defined(CONFIG_UTILS_POLL_URING)
+
+extern void
+upoll_uring_unregister(const struct upoll * __restrict poller, int fd)
+	__utils_nonull(1) __utils_nothrow __leaf;
+
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+
+/*
+ * Unregister the worker watching the given file descriptor. Events collected
+ * for it but not yet dispatched as well as its pending watch set modifications
+ * are dropped.
+ */
+
 static inline __utils_nonull(1) __utils_nothrow
 void
 upoll_unregister(const struct upoll * __restrict poller, int fd)
@@ -170,6 +336,16 @@ upoll_unregister(const struct upoll * __restrict poller, int fd)
 
 	int err __unused;
 
+	if (poller->ring->count || !stroll_dlist_empty(&poller->ring->journal))
+		upoll_ring_forget(poller, fd);
+
+#if defined(CONFIG_UTILS_POLL_URING)
+	if (poller->uring) {
+		upoll_uring_unregister(poller, fd);
+		return;
+	}
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+
 	/*
 	 * Cannot fail if proper arguments are given...
 	 * See <linux>/fs/eventpoll.c
@@ -178,6 +354,21 @@ upoll_unregister(const struct upoll * __restrict poller, int fd)
 	upoll_assert_api(!err);
 }
 
+/*
+ * Drop events collected for the given worker but not yet dispatched and cancel
+ * its pending watch set modifications, including EPOLLONESHOT re-arming, if
+ * any.
+ *
+ * upoll_unregister() discards the worker automatically. When the dispatch ring
+ * is enabled, when registered with EPOLLONESHOT or when upoll_apply() has been
+ * called for it from within a dispatch function, a worker MUST be discarded
+ * before being released without being unregistered.
+ */
+extern void
+upoll_discard(const struct upoll * __restrict  poller,
+              struct upoll_worker * __restrict worker)
+	__utils_nonull(1, 2) __utils_nothrow __leaf;
+
 extern int
 upoll_dispatch(const struct upoll * poller, unsigned int nr)
 	__utils_nonull(1);
@@ -194,7 +385,381 @@ extern int
 upoll_open(struct upoll * __restrict poller, unsigned int nr)
 	__utils_nonull(1) __utils_nothrow __leaf;
 
+/*
+ * Enable the poller dispatch ring.
+ *
+ * Once enabled, upoll_dispatch() queues events reported by the kernel per
+ * worker, merging events of workers already queued, then dispatches workers in
+ * priority order (see upoll_setup_prio()) and FIFO order within a priority.
+ * At most `budget' workers are dispatched per upoll_dispatch() call, zero
+ * meaning no limit. Workers left over, because the budget is exhausted or a
+ * worker dispatch function returned a non-zero value, are kept queued for
+ * subsequent calls so that no readiness notification is lost, and
+ * upoll_wait() does not block while workers are queued.
+ */
+extern int
+upoll_setup_ring(struct upoll * __restrict poller, unsigned int budget)
+	__utils_nonull(1) __utils_nothrow __leaf;
+
+#if defined(CONFIG_UTILS_POLL_URING)
+
+/*
+ * Switch the poller to the io_uring backend.
+ *
+ * Instead of an epoll set, file descriptors are then watched using
+ * IORING_OP_POLL_ADD requests submitted to an io_uring instance of `entries'
+ * submission queue entries, multishot ones for edge-triggered workers.
+ * Registration changes and re-arming of level-triggered workers are queued and
+ * submitted along with the next upoll_wait() call, which collects readiness
+ * notifications into the poller events array. Workers are dispatched
+ * according to the usual upoll_worker contract, except that registering a
+ * worker with EPOLLEXCLUSIVE fails with -EOPNOTSUPP.
+ *
+ * MUST be called right after upoll_open(), before registering any worker.
+ * Once switched, upoll_get_fd() returns the io_uring file descriptor, which is
+ * readable when notifications are ready for collection.
+ *
+ * Return -ENOSYS, -EPERM or -EOPNOTSUPP when the running kernel does not
+ * support io_uring, prevents its use or lacks required features, in which case
+ * the poller keeps using the epoll backend and remains fully usable.
+ */
+extern int
+upoll_setup_uring(struct upoll * __restrict poller, unsigned int entries)
+	__utils_nonull(1) __utils_nothrow __leaf;
+
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+
+#if defined(CONFIG_UTILS_POLL_BATCH)
+
+/*
+ * Let the poller size its events batch according to load.
+ *
+ * The number of events given to upoll_open() becomes the initial and minimum
+ * number of events collected per upoll_wait() call. It doubles each time a
+ * call fills the whole batch, up to `max', and is halved back when the batch
+ * remains mostly unused over a window of calls. The events array is allocated
+ * once for `max' events using an anonymous mapping, aligned for transparent
+ * huge pages when large enough; pages beyond the current batch size are given
+ * back to the kernel when the batch shrinks.
+ *
+ * MUST be called right after upoll_open(), before registering any worker.
+ * Returns -ENOMEM when the events array cannot be allocated, or a negative
+ * errno when the system page size cannot be retrieved.
+ */
+extern int
+upoll_setup_batch(struct upoll * __restrict poller, unsigned int max)
+	__utils_nonull(1) __utils_nothrow __leaf;
+
+static inline __utils_nonull(1) __utils_pure __utils_nothrow
+unsigned int
+upoll_get_batch_size(const struct upoll * __restrict poller)
+{
+	upoll_assert_api(poller);
+	upoll_assert_api(poller->batch);
+
+	return poller->batch->cur;
+}
+
+/*
+ * Retrieve the number of upoll_wait() calls and how many of them filled the
+ * whole events batch.
+ */
+static inline __utils_nonull(1, 2, 3) __utils_nothrow
+void
+upoll_get_batch_stats(const struct upoll * __restrict poller,
+                      unsigned long * __restrict      waits,
+                      unsigned long * __restrict      saturated)
+{
+	upoll_assert_api(poller);
+	upoll_assert_api(poller->batch);
+	upoll_assert_api(waits);
+	upoll_assert_api(saturated);
+
+	*waits = poller->batch->waits;
+	*saturated = poller->batch->saturated;
+}
+
+#endif /* defined(CONFIG_UTILS_POLL_BATCH) */
+
+#if defined(CONFIG_UTILS_POLL_TASK)
+
+typedef void (upoll_task_fn)(void *, const struct upoll *);
+
+/*
+ * Cross-thread task.
+ *
+ * Meant to be embedded into caller's structures. Once posted, a task is owned
+ * by the poller till its `run' function is called: it MUST be neither modified
+ * nor released in the meantime. It may be posted again from `run' onwards.
+ */
+struct upoll_task {
+	struct upoll_task * next;
+	upoll_task_fn *     run;
+	void *              arg;
+};
+
+static inline __utils_nonull(1, 2) __utils_nothrow
+void
+upoll_init_task(struct upoll_task * __restrict task,
+                upoll_task_fn *                run,
+                void *                         arg)
+{
+	upoll_assert_api(task);
+	upoll_assert_api(run);
+
+	task->next = NULL;
+	task->run = run;
+	task->arg = arg;
+}
+
+/*
+ * Enable cross-thread task posting.
+ *
+ * Registers an internal eventfd worker which runs tasks posted by other
+ * threads using upoll_post() from within upoll_process(), in posting order.
+ * Tasks still pending at upoll_close() time are dropped without being run;
+ * releasing them is left to their owners.
+ *
+ * MUST be called from the thread owning the poller, before the poller is
+ * shared with posting threads.
+ */
+extern int
+upoll_setup_tasks(struct upoll * __restrict poller)
+	__utils_nonull(1) __utils_nothrow __leaf;
+
+/*
+ * Post a task to run `task->run(task->arg, poller)' from the thread owning the
+ * poller.
+ *
+ * May be called from any thread and cannot fail since tasks are linked
+ * in place. Posting costs a single atomic operation and only the first task
+ * posted since last time tasks were run writes to the eventfd to wake the
+ * poller up.
+ */
+extern void
+upoll_post(const struct upoll * __restrict poller,
+           struct upoll_task * __restrict  task)
+	__utils_nonull(1, 2) __utils_nothrow __leaf;
+
+/*
+ * Wake the thread blocked into upoll_wait() for the given poller up.
+ *
+ * May be called from any thread. The woken up upoll_process() call returns
+ * with no worker dispatched, unless some were ready, so that the caller may
+ * check its own termination conditions.
+ */
+extern void
+upoll_wake(const struct upoll * __restrict poller)
+	__utils_nonull(1) __utils_nothrow __leaf;
+
+#endif /* defined(CONFIG_UTILS_POLL_TASK) */
+
+#if defined(CONFIG_UTILS_POLL_BUSY)
+
+/*
+ * Enable adaptive busy polling.
+ *
+ * Before blocking, upoll_wait() then spins polling for events with a zero
+ * timeout for at most `budget' nanoseconds. The spin window adapts to the
+ * recent arrival rate: it is twice the average time spent waiting for events
+ * when this average fits within `budget', and zero otherwise, i.e. when events
+ * are too sparse for spinning to pay off.
+ *
+ * When `usecs' is not zero, kernel side busy polling of network device queues
+ * is also enabled for `usecs' microseconds using EPIOCSPARAMS (Linux >= 6.9).
+ * This is only relevant to sockets served by NAPI capable network devices and
+ * is not supported by the io_uring backend. Per socket busy polling may be
+ * enabled using SO_BUSY_POLL with etux_sock_setopt().
+ */
+extern int
+upoll_setup_busy(struct upoll * __restrict poller,
+                 unsigned long             budget,
+                 unsigned int              usecs)
+	__utils_nonull(1) __utils_nothrow __leaf;
+
+static inline __utils_nonull(1, 2, 3) __utils_nothrow
+void
+upoll_get_busy_stats(const struct upoll * __restrict poller,
+                     unsigned long * __restrict      hits,
+                     unsigned long * __restrict      misses)
+{
+	upoll_assert_api(poller);
+	upoll_assert_api(poller->busy);
+	upoll_assert_api(hits);
+	upoll_assert_api(misses);
+
+	*hits = poller->busy->hits;
+	*misses = poller->busy->misses;
+}
+
+#endif /* defined(CONFIG_UTILS_POLL_BUSY) */
+
 extern void
 upoll_close(const struct upoll * __restrict poller) __utils_nonull(1) __leaf;
 
+/******************************************************************************
+ * Polling groups
+ ******************************************************************************/
+
+#if defined(CONFIG_UTILS_POLL_GROUP)
+
+#include <pthread.h>
+
+/*
+ * Policies used to select the loop of a group a file descriptor is registered
+ * into.
+ */
+enum upoll_group_policy {
+	/* Select loops in turn. */
+	UPOLL_GROUP_RR_POLICY = 0,
+	/* Select the loop watching the lowest number of workers. */
+	UPOLL_GROUP_LOAD_POLICY,
+	/*
+	 * Select the loop pinned to the CPU the socket traffic is processed on
+	 * (see SO_INCOMING_CPU in socket(7)), falling back to
+	 * UPOLL_GROUP_LOAD_POLICY when no such loop exists or file descriptor
+	 * is not a socket.
+	 */
+	UPOLL_GROUP_CPU_POLICY,
+	UPOLL_GROUP_POLICY_NR
+};
+
+struct upoll_group;
+
+/*
+ * Polling loop, i.e. a poller running into its own thread.
+ */
+struct upoll_loop {
+	struct upoll         poll;
+	unsigned int         load;
+	int                  cpu;
+	int                  kfd;
+	struct upoll_worker  kick;
+	int                  status;
+	pthread_t            thread;
+	struct upoll_group * group;
+};
+
+struct upoll_group {
+	enum upoll_group_policy policy;
+	unsigned int            next;
+	bool                    run;
+	unsigned int            nr;
+	struct upoll_loop *     loops;
+};
+
+/*
+ * Return the poller run by the group loop which index is given.
+ *
+ * Returned poller may be used to tune the loop (see upoll_setup_ring() or
+ * upoll_setup_busy()) before the group is started, but MUST NOT be setup with
+ * upoll_setup_uring().
+ */
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __returns_nonull
+struct upoll *
+upoll_group_poller(struct upoll_group * __restrict group, unsigned int index)
+{
+	upoll_assert_api(group);
+	upoll_assert_api(group->policy < UPOLL_GROUP_POLICY_NR);
+	upoll_assert_api(group->nr);
+	upoll_assert_api(group->loops);
+	upoll_assert_api(index < group->nr);
+
+	return &group->loops[index].poll;
+}
+
+/*
+ * Register a file descriptor into the loop selected according to the group
+ * policy.
+ *
+ * May be called from any thread. Loops setup with upoll_setup_uring() are not
+ * supported: -EOPNOTSUPP is returned when such a loop is selected.
+ *
+ * Return the index of the loop the worker has been registered into (see
+ * upoll_group_poller()) or a negative errno like upoll_register().
+ */
+extern int
+upoll_group_register(struct upoll_group * __restrict  group,
+                     int                              fd,
+                     uint32_t                         events,
+                     struct upoll_worker * __restrict worker)
+	__utils_nonull(1, 4) __utils_nothrow __leaf;
+
+/*
+ * Unregister a file descriptor from the loop running the given poller.
+ *
+ * MUST be called from within a dispatch function run by this loop or while the
+ * group is stopped since the loop dispatch ring and journal are owned by the
+ * thread running it.
+ */
+extern void
+upoll_group_unregister(struct upoll_group * __restrict  group,
+                       const struct upoll * __restrict  poller,
+                       int                              fd,
+                       struct upoll_worker * __restrict worker)
+	__utils_nonull(1, 2, 4) __utils_nothrow __leaf;
+
+/*
+ * Move a worker from the loop running the given poller to the loop which index
+ * is `to', keeping its current watch set and mode flags.
+ *
+ * MUST be called from within the worker's own dispatch function or while the
+ * group is stopped since a worker has to be migrated by the thread owning it.
+ * Once this returns successfully, the worker is owned by the destination loop
+ * and the caller MUST NOT touch it anymore. The worker keeps its dispatch
+ * priority (see upoll_setup_prio()).
+ *
+ * Return -EOPNOTSUPP, leaving the worker untouched, when the destination loop
+ * has been setup with upoll_setup_uring(). On other errors, the worker is left
+ * unregistered.
+ */
+extern int
+upoll_group_handoff(struct upoll_group * __restrict  group,
+                    const struct upoll * __restrict  poller,
+                    unsigned int                     to,
+                    int                              fd,
+                    struct upoll_worker * __restrict worker)
+	__utils_nonull(1, 2, 5) __utils_nothrow __leaf;
+
+/*
+ * Spawn a thread per group loop.
+ *
+ * Each loop runs upoll_process() until stopped or until a dispatch function
+ * returns a non-zero value.
+ */
+extern int
+upoll_group_start(struct upoll_group * __restrict group)
+	__utils_nonull(1) __utils_nothrow __leaf;
+
+/*
+ * Stop and join all group loop threads.
+ *
+ * Return the first non-zero value returned by a dispatch function which made a
+ * loop exit, or zero.
+ */
+extern int
+upoll_group_stop(struct upoll_group * __restrict group)
+	__utils_nonull(1) __leaf;
+
+/*
+ * Open a group of `nr' loops, each one able to collect up to `events' events
+ * at a time.
+ *
+ * When `cpus' is not NULL, loop `i' thread is pinned to CPU `cpus[i]' once
+ * started.
+ */
+extern int
+upoll_group_open(struct upoll_group * __restrict group,
+                 unsigned int                    nr,
+                 const int * __restrict          cpus,
+                 unsigned int                    events,
+                 enum upoll_group_policy         policy)
+	__utils_nonull(1) __utils_nothrow __leaf;
+
+extern void
+upoll_group_close(struct upoll_group * __restrict group)
+	__utils_nonull(1) __leaf;
+
+#endif /* defined(CONFIG_UTILS_POLL_GROUP) */
+
 #endif /* _UTILS_POLL_H */
@@ -21,6 +21,7 @@
 
 #include <utils/cdefs.h>
 #include <stdbool.h>
+#include <string.h>
 #include <signal.h>
 
 #if defined(CONFIG_UTILS_ASSERT_API)
@@ -69,7 +70,13 @@ usig_isemptyset(const sigset_t * set)
 {
 	usig_assert_api(set);
 
-	return !!sigisemptyset(set);
+	/*
+	 * Do not rely upon sigisemptyset(): some Glibc releases report sets
+	 * holding realtime signals only as empty.
+	 */
+	static const sigset_t empty;
+
+	return !memcmp(set, &empty, sizeof(empty));
 }
 
 #if defined(CONFIG_UTILS_ASSERT_API)
@@ -277,4 +284,88 @@ usig_close_fd(int fd)
 
 #endif /* defined(CONFIG_UTILS_SIGNAL_FD) */
 
+#if defined(CONFIG_UTILS_POLL_SIGNAL)
+
+#include <utils/poll.h>
+
+/*
+ * Maximum number of signal information records read per signalfd wakeup.
+ */
+#define USIG_DISPATCH_BATCH (32U)
+
+/*
+ * Signal handler run from within upoll_process() for each signal information
+ * record read from the dispatcher signalfd.
+ *
+ * Note that standard signals of the same number are coalesced while pending,
+ * e.g., a SIGCHLD handler should reap all terminated children it may find
+ * using waitpid(WNOHANG) instead of a single one.
+ *
+ * Returning a non-zero value makes upoll_process() return this value once all
+ * records read along with the current one have been handled.
+ */
+typedef int (usig_handler_fn)(const struct signalfd_siginfo * __restrict,
+                              void *);
+
+struct usig_handler {
+	usig_handler_fn * handle;
+	void *            data;
+};
+
+/*
+ * upoll based signal dispatcher.
+ *
+ * Signals registered using usig_dispatch_register() are delivered through a
+ * signalfd and dispatched to their handler in batches of up to
+ * USIG_DISPATCH_BATCH records per read().
+ *
+ * Registered signals MUST be blocked in all threads of the process, e.g. using
+ * usig_procmask() before spawning any thread, so that they are not delivered
+ * in the usual asynchronous way.
+ */
+struct usig_dispatch {
+	struct upoll_worker work;
+	int                 fd;
+	sigset_t            mask;
+	struct usig_handler handlers[NSIG - 1];
+};
+
+extern void
+usig_dispatch_init(struct usig_dispatch * __restrict disp)
+	__utils_nonull(1) __utils_nothrow __leaf;
+
+/*
+ * Register `handle' for signal `signo'.
+ *
+ * May be called before or after usig_dispatch_open(), replacing any handler
+ * previously registered for `signo'.
+ */
+extern int
+usig_dispatch_register(struct usig_dispatch * __restrict disp,
+                       int                               signo,
+                       usig_handler_fn *                 handle,
+                       void *                            data)
+	__utils_nonull(1, 3) __utils_nothrow __leaf;
+
+extern int
+usig_dispatch_unregister(struct usig_dispatch * __restrict disp, int signo)
+	__utils_nonull(1) __utils_nothrow __leaf;
+
+/*
+ * Start dispatching registered signals from within `poller' loop.
+ *
+ * At least one signal MUST have been registered.
+ */
+extern int
+usig_dispatch_open(struct usig_dispatch * __restrict disp,
+                   const struct upoll * __restrict   poller)
+	__utils_nonull(1, 2) __utils_nothrow __leaf;
+
+extern void
+usig_dispatch_close(struct usig_dispatch * __restrict disp,
+                    const struct upoll * __restrict   poller)
+	__utils_nonull(1, 2) __leaf;
+
+#endif /* defined(CONFIG_UTILS_POLL_SIGNAL) */
+
 #endif /* _UTILS_SIGNAL_H */
@@ -21,9 +21,12 @@
 
 #include <utils/time.h>
 #include <stroll/dlist.h>
-#if defined(CONFIG_ETUX_TIMER_HEAP)
+#if defined(CONFIG_ETUX_TIMER_HEAP) || defined(CONFIG_ETUX_TIMER_WHEEL)
 #include <stroll/pprheap.h>
-#endif /* defined(CONFIG_ETUX_TIMER_HEAP) */
+#endif /* defined(CONFIG_ETUX_TIMER_HEAP) || defined(CONFIG_ETUX_TIMER_WHEEL) */
+#if defined(CONFIG_ETUX_TIMER_POOL)
+#include <utils/thread.h>
+#endif /* defined(CONFIG_ETUX_TIMER_POOL) */
 
 #if defined(CONFIG_UTILS_ASSERT_API)
 
@@ -49,20 +52,39 @@ typedef void (etux_timer_expire_fn)(struct etux_timer * __restrict);
 enum etux_timer_state {
 	ETUX_TIMER_IDLE_STAT,
 	ETUX_TIMER_PEND_STAT,
-	ETUX_TIMER_RUN_STAT
+	ETUX_TIMER_RUN_STAT,
+#if defined(CONFIG_ETUX_TIMER_HEAP_LAZY)
+	ETUX_TIMER_DEAD_STAT
+#endif /* defined(CONFIG_ETUX_TIMER_HEAP_LAZY) */
 };
 
 struct etux_timer {
 	enum etux_timer_state              state;
+	unsigned int                       slack;
 	union {
 		struct stroll_dlist_node   list;
-#if defined(CONFIG_ETUX_TIMER_HEAP)
+#if defined(CONFIG_ETUX_TIMER_HEAP) || defined(CONFIG_ETUX_TIMER_WHEEL)
 		struct stroll_pprheap_node heap;
-#endif /* defined(CONFIG_ETUX_TIMER_HEAP) */
+#endif /* defined(CONFIG_ETUX_TIMER_HEAP) || defined(CONFIG_ETUX_TIMER_WHEEL) */
 	};
 	int64_t                            tick;
 	struct timespec                    tspec;
 	etux_timer_expire_fn *             expire;
+	int64_t                            period;
+	unsigned int                       overrun;
+#if defined(CONFIG_ETUX_TIMER_WHEEL)
+	bool                               eternal;
+#endif /* defined(CONFIG_ETUX_TIMER_WHEEL) */
+#if defined(CONFIG_ETUX_TIMER_REMOTE)
+	struct etux_timer *                xnext;
+	int64_t                            xtick;
+	bool                               xpend;
+#endif /* defined(CONFIG_ETUX_TIMER_REMOTE) */
+#if defined(CONFIG_ETUX_TIMER_POOL)
+	struct etux_timer_base *           pbase;
+	struct etux_timer *                pnext;
+	bool                               pbusy;
+#endif /* defined(CONFIG_ETUX_TIMER_POOL) */
 };
 
 #define ETUX_TIMER_INIT(_timer, _expire) \
@@ -113,6 +135,29 @@ extern void
 etux_timer_cancel(struct etux_timer * __restrict timer)
 	__utils_nonull(1) __utils_nothrow __leaf __export_public;
 
+extern void
+etux_timer_arm_many_tspec(struct etux_timer * const * __restrict timers,
+                          unsigned int                           nr,
+                          const struct timespec * __restrict     tspec)
+	__utils_nonull(1, 3) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_arm_many_msec(struct etux_timer * const * __restrict timers,
+                         unsigned int                           nr,
+                         int                                    msec)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_arm_many_sec(struct etux_timer * const * __restrict timers,
+                        unsigned int                           nr,
+                        int                                    sec)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_cancel_many(struct etux_timer * const * __restrict timers,
+                       unsigned int                           nr)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
 static inline __utils_nonull(1, 2) __utils_nothrow
 void
 etux_timer_setup(struct etux_timer * __restrict timer,
@@ -132,7 +177,70 @@ etux_timer_init(struct etux_timer * __restrict timer,
 	etux_timer_assert_api(timer);
 
 	timer->state = ETUX_TIMER_IDLE_STAT;
+	timer->slack = 0;
 	timer->expire = expire;
+	timer->period = 0;
+	timer->overrun = 0;
+#if defined(CONFIG_ETUX_TIMER_WHEEL)
+	timer->eternal = false;
+#endif /* defined(CONFIG_ETUX_TIMER_WHEEL) */
+#if defined(CONFIG_ETUX_TIMER_REMOTE)
+	timer->xpend = false;
+#endif /* defined(CONFIG_ETUX_TIMER_REMOTE) */
+#if defined(CONFIG_ETUX_TIMER_POOL)
+	timer->pbusy = false;
+#endif /* defined(CONFIG_ETUX_TIMER_POOL) */
+}
+
+/*
+ * Setup the amount of time a timer expiry may be delayed by.
+ *
+ * At arming time, timer expiry is postponed onto the "roundest" tick of the
+ * [expiry, expiry + slack] window so that timers with overlapping windows are
+ * likely to be coalesced onto the same tick and expired in a single batch,
+ * reducing the number of wakeups.
+ * A zero slack (the default) disables coalescing. Slack is rounded down to
+ * the tick period and is applied at next arming time.
+ */
+extern void
+etux_timer_setup_slack_tspec(struct etux_timer * __restrict     timer,
+                             const struct timespec * __restrict slack)
+	__utils_nonull(1, 2) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_setup_slack_msec(struct etux_timer * __restrict timer, int msec)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
+/*
+ * Setup timer period.
+ *
+ * Once its expiry callback returns, a periodic timer is automatically rearmed
+ * by etux_timer_run() relative to its previous expiry date, i.e. without
+ * reading the clock and without accumulating drift, unless the callback has
+ * rearmed or canceled it.
+ * When expiries have been missed, the timer is rearmed onto the first period
+ * boundary located in the future and etux_timer_overrun() returns the number
+ * of missed periods from within the expiry callback.
+ * A zero period (the default) makes the timer one-shot. Period is rounded up
+ * to the tick period.
+ */
+extern void
+etux_timer_setup_period_tspec(struct etux_timer * __restrict     timer,
+                              const struct timespec * __restrict period)
+	__utils_nonull(1, 2) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_setup_period_msec(struct etux_timer * __restrict timer, int msec)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __warn_result
+unsigned int
+etux_timer_overrun(const struct etux_timer * __restrict timer)
+{
+	etux_timer_assert_timer_api(timer);
+	etux_timer_assert_api(timer->period > 0);
+
+	return timer->overrun;
 }
 
 extern struct timespec *
@@ -144,4 +252,713 @@ etux_timer_issue_msec(void) __utils_nothrow __warn_result __export_public;
 
 extern void etux_timer_run(void) __utils_nothrow __export_public;
 
+/******************************************************************************
+ * Timer base handling
+ ******************************************************************************/
+
+#if defined(CONFIG_ETUX_TIMER_WHEEL)
+
+#define ETUX_TIMER_HWHEEL_SLOT_BITS \
+	(6U)
+
+#define ETUX_TIMER_HWHEEL_SLOT_MASK \
+	((INT64_C(1) << ETUX_TIMER_HWHEEL_SLOT_BITS) - 1)
+
+#define ETUX_TIMER_HWHEEL_SLOTS_PER_WHEEL \
+	(1U << ETUX_TIMER_HWHEEL_SLOT_BITS)
+
+/*
+ * Setup maximum depth of hierarchical timing wheel.
+ *
+ * The table below gives time ranges that the hwheel may handle according to
+ * to allowed CONFIG_ETUX_TIMER_SUBSEC_BITS values:
+ *                                                      Tick                Time
+ *                                    Time period  frequency  Hierarchy    range
+ *  CONFIG_ETUX_TIMER_SUBSEC_BITS  (milliseconds)    (Hertz)     levels   (days)
+ *                              0     1000.000000          1          4     >194
+ *                              1      500.000000          2          4      >97
+ *                              2      250.000000          4          4      >48
+ *                              3      125.000000          8          4      >24
+ *                              4       62.500000         16          4      >12
+ *                              5       31.250000         32          5     >388
+ *                              6       15.625000         64          5     >194
+ *                              7        7.812500        128          5      >97
+ *                              8        3.906250        256          5      >48
+ *                              9        1.953125        512          5      >24
+ *                             10        0.976562       1024          6     >776
+ *                             11        0.488281       2048          6     >388
+ *                             12        0.244141       4096          6     >194
+ *                             13        0.122070       8192          6      >97
+ *                             14        0.061035      16384          6      >48
+ *                             15        0.030518      32768          6      >24
+ *                             16        0.015259      65536          7     >776
+ *                             17        0.007629     131072          7     >388
+ *                             18        0.003815     262144          7     >194
+ *                             19        0.001907     524288          7      >97
+ *                             20        0.000954    1048576          7      >48
+ */
+#if CONFIG_ETUX_TIMER_SUBSEC_BITS < 5
+#define ETUX_TIMER_HWHEEL_LEVELS_NR (4U)
+#elif CONFIG_ETUX_TIMER_SUBSEC_BITS < 10
+#define ETUX_TIMER_HWHEEL_LEVELS_NR (5U)
+#elif CONFIG_ETUX_TIMER_SUBSEC_BITS < 16
+#define ETUX_TIMER_HWHEEL_LEVELS_NR (6U)
+#else  /* !(CONFIG_ETUX_TIMER_SUBSEC_BITS < 16) */
+#define ETUX_TIMER_HWHEEL_LEVELS_NR (7U)
+#endif /* CONFIG_ETUX_TIMER_SUBSEC_BITS < 16 */
+
+/*
+ * Hierarchical timing wheel geometry limits (see
+ * etux_timer_base_init_hwheel()).
+ *
+ * Each level of the hierarchical timing wheel comes with a bitmap of occupied
+ * slots, i.e. bit N is set when slot N holds at least one timer. This allows
+ * to locate the next non-empty slot without probing empty ones. Hence a wheel
+ * cannot hold more than 64 slots.
+ */
+#define ETUX_TIMER_HWHEEL_SLOT_BITS_MAX  (6U)
+#define ETUX_TIMER_HWHEEL_LEVELS_MAX     (8U)
+#define ETUX_TIMER_HWHEEL_TICK_SHIFT_MAX (32U)
+
+#if ETUX_TIMER_HWHEEL_SLOT_BITS > ETUX_TIMER_HWHEEL_SLOT_BITS_MAX
+#error Hierarchical timing wheel occupancy bitmaps cannot exceed 64 bits !
+#endif
+
+/*
+ * Slots storage is embedded for the default geometry and for smaller ones.
+ * Larger geometries are allocated at etux_timer_base_init_hwheel() time.
+ *
+ * Timers expiring beyond the range of the highest level are kept into the
+ * `eternal' pairing heap, i.e. in expiry order at O(1) insertion cost.
+ */
+struct etux_timer_hwheel {
+	unsigned int               count;
+	unsigned int               bits;
+	unsigned int               levels;
+	unsigned int               shift;
+	int64_t                    tick;
+	int64_t                    issue;
+	uint64_t                   bitmaps[ETUX_TIMER_HWHEEL_LEVELS_MAX];
+	struct stroll_dlist_node * slots;
+	struct stroll_pprheap_base eternal;
+	struct stroll_dlist_node   dflt[ETUX_TIMER_HWHEEL_LEVELS_NR *
+	                                ETUX_TIMER_HWHEEL_SLOTS_PER_WHEEL];
+};
+
+#endif /* defined(CONFIG_ETUX_TIMER_WHEEL) */
+
+#if defined(CONFIG_ETUX_TIMER_STATS)
+
+/*
+ * Expiry lateness histogram geometry.
+ *
+ * Lateness is the number of ticks elapsed between a timer expiry tick and the
+ * tick at which its expiry callback is run. It is recorded into an HDR-like
+ * log-linear histogram: each power of 2 range of lateness values is split into
+ * 2^ETUX_TIMER_STATS_SUB_BITS linearly sized buckets. Lateness values lower
+ * than 2^ETUX_TIMER_STATS_SUB_BITS ticks get their own bucket and values
+ * exceeding the range of the last bucket are accounted into it.
+ *
+ * Use etux_timer_stats_bucket_tspec() to retrieve the lateness lower bound
+ * of a particular bucket.
+ */
+#define ETUX_TIMER_STATS_SUB_BITS   (2U)
+#define ETUX_TIMER_STATS_BUCKETS_NR (64U)
+
+/* Maximum number of timing wheel levels cascading statistics account for. */
+#define ETUX_TIMER_STATS_LEVELS_NR  (8U)
+
+/*
+ * Timer base statistics.
+ *
+ * Counters are maintained by the base owner thread with relaxed atomic stores
+ * only, i.e. at almost no cost. Retrieve them using etux_timer_base_get_stats()
+ * from any thread, without interrupting the base owner thread.
+ *
+ * arms, cancels, expiries, cascades and migrations are cumulative counters
+ * which wrap around. Compute rates from the difference of two snapshots
+ * divided by the difference of their stamp fields.
+ *
+ * pending is the number of timers currently armed (including the one whose
+ * expiry callback is being run if any) whereas eternals is the number of
+ * timers currently held into a timing wheel eternal heap.
+ * cascades[N] is the number of timers cascaded down from level N of a timing
+ * wheel and migrations the number of timers moved from the eternal heap to the
+ * wheel.
+ */
+struct etux_timer_stats {
+	struct timespec stamp;
+	unsigned long   arms;
+	unsigned long   cancels;
+	unsigned long   expiries;
+	unsigned int    pending;
+	unsigned int    eternals;
+	unsigned long   cascades[ETUX_TIMER_STATS_LEVELS_NR];
+	unsigned long   migrations;
+	unsigned long   lateness[ETUX_TIMER_STATS_BUCKETS_NR];
+};
+
+#endif /* defined(CONFIG_ETUX_TIMER_STATS) */
+
+#if defined(CONFIG_ETUX_TIMER_CLOCK_CACHE)
+
+/*
+ * Clock used to compute expiry dates of relatively armed timers, i.e. timers
+ * armed thanks to etux_timer_base_arm_msec(), etux_timer_base_arm_sec() and
+ * their batched variants:
+ * - ETUX_TIMER_PRECISE_CLOCK: CLOCK_MONOTONIC is read at arming time (the
+ *   default) ;
+ * - ETUX_TIMER_CACHED_CLOCK: the clock sample cached at the latest
+ *   etux_timer_base_refresh_clock() or etux_timer_base_run() call is used, i.e.
+ *   arming does not read the clock at all ;
+ * - ETUX_TIMER_COARSE_CLOCK: CLOCK_MONOTONIC_COARSE is read at arming time,
+ *   i.e. a cheaper clock with kernel jiffy resolution.
+ *
+ * Cached and coarse clocks lag behind the precise one, by the time elapsed
+ * since the latest refresh and by up to a kernel jiffy respectively. Relative
+ * timers may hence expire earlier than requested by this amount, which is
+ * harmless as long as it remains small compared to the timer tick period.
+ * Expiry processing always relies upon the precise clock.
+ */
+enum etux_timer_clock {
+	ETUX_TIMER_PRECISE_CLOCK,
+	ETUX_TIMER_CACHED_CLOCK,
+	ETUX_TIMER_COARSE_CLOCK
+};
+
+#endif /* defined(CONFIG_ETUX_TIMER_CLOCK_CACHE) */
+
+#if defined(CONFIG_ETUX_TIMER_HEAP_LAZY)
+
+/*
+ * Lazy heap timer cancelation state.
+ *
+ * nodes is the number of timers linked into the heap, including dead ones,
+ * i.e. timers canceled but not yet removed from the heap. ratio is the maximum
+ * percentage of dead timers tolerated before compacting the heap, zero meaning
+ * that timers are removed at cancelation time.
+ */
+struct etux_timer_lazy {
+	unsigned int nodes;
+	unsigned int dead;
+	unsigned int ratio;
+};
+
+#endif /* defined(CONFIG_ETUX_TIMER_HEAP_LAZY) */
+
+#if defined(CONFIG_ETUX_TIMER_POOL)
+
+/*
+ * Pool of worker threads running timer expiry callbacks on behalf of one or
+ * more timer bases (see etux_timer_base_setup_pool()).
+ *
+ * jobs is the FIFO of expired timers waiting for a worker, protected by lock.
+ */
+struct etux_timer_pool {
+	struct uthr_mutex        lock;
+	struct uthr_cond         cond;
+	struct stroll_dlist_node jobs;
+	bool                     quit;
+	unsigned int             nr;
+	pthread_t *              workers;
+};
+
+#endif /* defined(CONFIG_ETUX_TIMER_POOL) */
+
+/*
+ * A timer base holds the set of timers armed by a single event loop.
+ *
+ * Timer bases are not thread-safe: a base and the timers armed onto it MUST be
+ * operated from a single thread. Give each thread its own base to drive
+ * multiple event loops concurrently.
+ *
+ * etux_timer_arm_*(), etux_timer_cancel(), etux_timer_issue_*() and
+ * etux_timer_run() operate upon a process wide default base.
+ *
+ * When CONFIG_ETUX_TIMER_REMOTE is enabled, other threads may request to arm /
+ * cancel timers thanks to the etux_timer_base_remote_*() functions. Requests
+ * are pushed into a lock-free queue which is drained by the base owner thread
+ * at the start of etux_timer_base_run().
+ *
+ * When CONFIG_ETUX_TIMER_STATS is enabled, each base maintains statistics that
+ * may be retrieved using etux_timer_base_get_stats().
+ *
+ * When CONFIG_ETUX_TIMER_CLOCK_CACHE is enabled, the clock relative timer
+ * expiry dates are computed from may be selected per base using
+ * etux_timer_base_setup_clock().
+ *
+ * When CONFIG_ETUX_TIMER_HEAP_LAZY is enabled, heap based bases may be setup to
+ * cancel timers lazily using etux_timer_base_setup_lazy().
+ *
+ * When CONFIG_ETUX_TIMER_POOL is enabled, expiry callbacks may be run by a pool
+ * of worker threads using etux_timer_base_setup_pool().
+ */
+struct etux_timer_base {
+	union {
+#if defined(CONFIG_ETUX_TIMER_LIST)
+		struct stroll_dlist_node   list;
+#endif /* defined(CONFIG_ETUX_TIMER_LIST) */
+#if defined(CONFIG_ETUX_TIMER_HEAP)
+		struct stroll_pprheap_base heap;
+#endif /* defined(CONFIG_ETUX_TIMER_HEAP) */
+#if defined(CONFIG_ETUX_TIMER_WHEEL)
+		struct etux_timer_hwheel   hwheel;
+#endif /* defined(CONFIG_ETUX_TIMER_WHEEL) */
+	};
+#if defined(CONFIG_ETUX_TIMER_REMOTE)
+	struct etux_timer *                xreqs;
+	int                                xfd;
+#endif /* defined(CONFIG_ETUX_TIMER_REMOTE) */
+#if defined(CONFIG_ETUX_TIMER_STATS)
+	struct etux_timer_stats            stats;
+#endif /* defined(CONFIG_ETUX_TIMER_STATS) */
+#if defined(CONFIG_ETUX_TIMER_CLOCK_CACHE)
+	enum etux_timer_clock              clock;
+	struct timespec                    now;
+#endif /* defined(CONFIG_ETUX_TIMER_CLOCK_CACHE) */
+#if defined(CONFIG_ETUX_TIMER_HEAP_LAZY)
+	struct etux_timer_lazy             lazy;
+#endif /* defined(CONFIG_ETUX_TIMER_HEAP_LAZY) */
+#if defined(CONFIG_ETUX_TIMER_POOL)
+	struct etux_timer_pool *           pool;
+	struct etux_timer *                pdone;
+	unsigned int                       pbusy;
+#endif /* defined(CONFIG_ETUX_TIMER_POOL) */
+};
+
+extern void
+etux_timer_base_arm_tspec(struct etux_timer_base * __restrict base,
+                          struct etux_timer * __restrict      timer,
+                          const struct timespec * __restrict  tspec)
+	__utils_nonull(1, 2, 3) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_base_arm_msec(struct etux_timer_base * __restrict base,
+                         struct etux_timer * __restrict      timer,
+                         int                                 msec)
+	__utils_nonull(1, 2) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_base_arm_sec(struct etux_timer_base * __restrict base,
+                        struct etux_timer * __restrict      timer,
+                        int                                 sec)
+	__utils_nonull(1, 2) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_base_cancel(struct etux_timer_base * __restrict base,
+                       struct etux_timer * __restrict      timer)
+	__utils_nonull(1, 2) __utils_nothrow __leaf __export_public;
+
+/*
+ * Arm / cancel a batch of timers.
+ *
+ * Behave as if etux_timer_base_arm_*() / etux_timer_base_cancel() were called
+ * for each of the `nr' timers found into the `timers' array, all timers being
+ * armed with the same expiry date. The clock is sampled once per batch and
+ * base bookkeeping is updated once per batch whenever the backend allows it,
+ * which saves significant work when tearing down or re-arming the timeouts of
+ * large sets of connections for example.
+ */
+extern void
+etux_timer_base_arm_many_tspec(struct etux_timer_base * __restrict    base,
+                               struct etux_timer * const * __restrict timers,
+                               unsigned int                           nr,
+                               const struct timespec * __restrict     tspec)
+	__utils_nonull(1, 2, 4) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_base_arm_many_msec(struct etux_timer_base * __restrict    base,
+                              struct etux_timer * const * __restrict timers,
+                              unsigned int                           nr,
+                              int                                    msec)
+	__utils_nonull(1, 2) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_base_arm_many_sec(struct etux_timer_base * __restrict    base,
+                             struct etux_timer * const * __restrict timers,
+                             unsigned int                           nr,
+                             int                                    sec)
+	__utils_nonull(1, 2) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_base_cancel_many(struct etux_timer_base * __restrict    base,
+                            struct etux_timer * const * __restrict timers,
+                            unsigned int                           nr)
+	__utils_nonull(1, 2) __utils_nothrow __leaf __export_public;
+
+extern struct timespec *
+etux_timer_base_issue_tspec(struct etux_timer_base * __restrict base,
+                            struct timespec * __restrict        tspec)
+	__utils_nonull(1, 2)
+	__utils_nothrow
+	__leaf
+	__warn_result
+	__export_public;
+
+extern int
+etux_timer_base_issue_msec(struct etux_timer_base * __restrict base)
+	__utils_nonull(1) __utils_nothrow __leaf __warn_result __export_public;
+
+extern void
+etux_timer_base_run(struct etux_timer_base * base)
+	__utils_nonull(1) __utils_nothrow __export_public;
+
+extern void
+etux_timer_base_init(struct etux_timer_base * __restrict base)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_base_fini(struct etux_timer_base * __restrict base)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
+#if defined(CONFIG_ETUX_TIMER_CLOCK_CACHE)
+
+/*
+ * Select the clock relative timer expiry dates are computed from (see
+ * enum etux_timer_clock).
+ *
+ * When the cached clock is selected, the clock sample is refreshed at the start
+ * of each etux_timer_base_run() call. Since event loops usually process file
+ * descriptor events before running timers, call
+ * etux_timer_base_refresh_clock() right after waking up so that timers armed
+ * from event handlers are not computed from a stale sample
+ * (etux_timer_poll_process() does it for you).
+ */
+extern void
+etux_timer_base_setup_clock(struct etux_timer_base * __restrict base,
+                            enum etux_timer_clock               clock)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_base_refresh_clock(struct etux_timer_base * __restrict base)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_setup_clock(enum etux_timer_clock clock)
+	__utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_refresh_clock(void) __utils_nothrow __leaf __export_public;
+
+#endif /* defined(CONFIG_ETUX_TIMER_CLOCK_CACHE) */
+
+#if defined(CONFIG_ETUX_TIMER_HEAP_LAZY)
+
+/*
+ * Setup lazy cancelation of timers armed onto a heap based timer base.
+ *
+ * Once enabled, canceled timers are not removed from the heap right away but
+ * marked dead instead. Dead timers are removed from the heap once they reach
+ * its top or when compacting the heap, i.e. at etux_timer_base_run() time
+ * whenever dead timers make up more than `ratio' percent of heap nodes.
+ * Re-arming a dead timer simply moves it within the heap. This spares heap
+ * restructuring costs to workloads where most timers are canceled before
+ * expiry, e.g. I/O timeouts, at the expense of a heap holding up to `ratio'
+ * percent of extra nodes.
+ *
+ * `ratio' ranges from 0 to 100 percent. A zero ratio (the default) disables
+ * lazy cancelation and removes all dead timers from the heap.
+ *
+ * A dead timer remains linked into the heap: it MUST be detached using
+ * etux_timer_base_detach() before being released or re-initialized.
+ *
+ * Only available when linking against the heap backend.
+ */
+extern void
+etux_timer_base_setup_lazy(struct etux_timer_base * __restrict base,
+                           unsigned int                        ratio)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
+/*
+ * Cancel a timer and make sure it is removed from the heap, whatever the lazy
+ * cancelation setup is.
+ */
+extern void
+etux_timer_base_detach(struct etux_timer_base * __restrict base,
+                       struct etux_timer * __restrict      timer)
+	__utils_nonull(1, 2) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_setup_lazy(unsigned int ratio) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_detach(struct etux_timer * __restrict timer)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
+#endif /* defined(CONFIG_ETUX_TIMER_HEAP_LAZY) */
+
+#if defined(CONFIG_ETUX_TIMER_WHEEL)
+
+/*
+ * Initialize a hierarchical timing wheel based timer base with a custom
+ * geometry:
+ * - `slot_bits': log2 of the number of slots per wheel level ;
+ * - `levels': number of wheel levels ;
+ * - `tick_shift': log2 of the wheel tick period expressed in timer ticks (see
+ *   CONFIG_ETUX_TIMER_SUBSEC_BITS), i.e. wheel tick resolution.
+ *
+ * A base then covers (1 << (slot_bits * levels)) wheel ticks without resorting
+ * to its eternal timer heap. Timer expiries are rounded up to the wheel
+ * tick period.
+ *
+ * For example, with CONFIG_ETUX_TIMER_SUBSEC_BITS set to 9, a 6 / 3 / 0
+ * geometry gives a ~2 ms resolution wheel covering ~8.5 minutes suitable for
+ * RPC timeouts while a 6 / 3 / 9 geometry gives a 1 second resolution wheel
+ * covering ~3 days suitable for session expiries.
+ *
+ * Only available when linking against the hierarchical timing wheel or hybrid
+ * backends.
+ * Base MUST be released using etux_timer_base_fini().
+ */
+extern int
+etux_timer_base_init_hwheel(struct etux_timer_base * __restrict base,
+                            unsigned int                        slot_bits,
+                            unsigned int                        levels,
+                            unsigned int                        tick_shift)
+	__utils_nonull(1) __utils_nothrow __leaf __warn_result __export_public;
+
+#endif /* defined(CONFIG_ETUX_TIMER_WHEEL) */
+
+#if defined(CONFIG_ETUX_TIMER_REMOTE)
+
+/******************************************************************************
+ * Remote timer requests handling
+ ******************************************************************************/
+
+/*
+ * The functions below may be called from any thread to arm / cancel a timer
+ * owned by the thread running the given base. Requests are queued without
+ * locking and applied at the start of the next etux_timer_base_run() call.
+ *
+ * Only the latest request issued for a particular timer is retained, i.e.
+ * issuing a cancel request right after an arming one for the same timer
+ * cancels it. A timer MUST NOT be remotely operated upon concurrently with
+ * local etux_timer_base_arm_*() / etux_timer_base_cancel() calls that target
+ * another base.
+ *
+ * Remotely armed timers expire at a date rounded up to the next timer tick.
+ */
+extern void
+etux_timer_base_remote_arm_tspec(struct etux_timer_base * __restrict base,
+                                 struct etux_timer * __restrict      timer,
+                                 const struct timespec * __restrict  tspec)
+	__utils_nonull(1, 2, 3) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_base_remote_arm_msec(struct etux_timer_base * __restrict base,
+                                struct etux_timer * __restrict      timer,
+                                int                                 msec)
+	__utils_nonull(1, 2) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_base_remote_arm_sec(struct etux_timer_base * __restrict base,
+                               struct etux_timer * __restrict      timer,
+                               int                                 sec)
+	__utils_nonull(1, 2) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_base_remote_cancel(struct etux_timer_base * __restrict base,
+                              struct etux_timer * __restrict      timer)
+	__utils_nonull(1, 2) __utils_nothrow __leaf __export_public;
+
+/*
+ * Return an eventfd file descriptor that becomes readable when remote requests
+ * are pending so that a thread blocked into a poll loop may be woken up.
+ * Register it into the poll loop and call etux_timer_base_run() once readable.
+ *
+ * MUST be called by the base owner thread before remote threads may issue
+ * requests. The descriptor is released by etux_timer_base_close_kick() or
+ * etux_timer_base_fini().
+ */
+extern int
+etux_timer_base_open_kick(struct etux_timer_base * __restrict base)
+	__utils_nonull(1) __utils_nothrow __leaf __warn_result __export_public;
+
+extern void
+etux_timer_base_close_kick(struct etux_timer_base * __restrict base)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_remote_arm_tspec(struct etux_timer * __restrict     timer,
+                            const struct timespec * __restrict tspec)
+	__utils_nonull(1, 2) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_remote_arm_msec(struct etux_timer * __restrict timer, int msec)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_remote_arm_sec(struct etux_timer * __restrict timer, int sec)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_remote_cancel(struct etux_timer * __restrict timer)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
+extern int
+etux_timer_open_kick(void) __utils_nothrow __warn_result __export_public;
+
+extern void
+etux_timer_close_kick(void) __utils_nothrow __export_public;
+
+#endif /* defined(CONFIG_ETUX_TIMER_REMOTE) */
+
+#if defined(CONFIG_ETUX_TIMER_POOL)
+
+/******************************************************************************
+ * Timer expiry worker pool handling
+ ******************************************************************************/
+
+#define ETUX_TIMER_POOL_WORKERS_MAX (64U)
+
+/*
+ * Spawn a pool of `nr' worker threads running timer expiry callbacks.
+ *
+ * Workers inherit the signal mask of the calling thread.
+ * Pool MUST be released using etux_timer_pool_fini().
+ */
+extern int
+etux_timer_pool_init(struct etux_timer_pool * __restrict pool,
+                     unsigned int                        nr)
+	__utils_nonull(1) __utils_nothrow __leaf __warn_result __export_public;
+
+/*
+ * Run expiry callbacks still queued, then stop and join worker threads.
+ */
+extern void
+etux_timer_pool_fini(struct etux_timer_pool * __restrict pool)
+	__utils_nonull(1) __export_public;
+
+/*
+ * Hand the expiry callbacks of timers expired by etux_timer_base_run() over to
+ * the given pool instead of running them inline. A NULL pool (the default)
+ * restores inline callback execution.
+ *
+ * A timer dispatched to a pool is removed from its base and remains in
+ * ETUX_TIMER_RUN_STAT state until its callback completes. Completions are
+ * reported back to the base owner thread thanks to the remote kick file
+ * descriptor (see etux_timer_base_open_kick()) and applied at the start of the
+ * next etux_timer_base_run() call: a one-shot timer is then made idle whereas a
+ * periodic timer is re-armed for the period following completion.
+ *
+ * Until completion, the base owner thread MUST NOT arm nor cancel the timer.
+ * Remote requests targeting the timer (issued from its callback for instance)
+ * are deferred until completion.
+ * Expiry callbacks MUST NOT call timer base functions other than the
+ * etux_timer_base_remote_*() ones.
+ * Base MUST NOT be released while callbacks are still pending, i.e. until
+ * etux_timer_base_pool_busy() returns 0.
+ */
+extern void
+etux_timer_base_setup_pool(struct etux_timer_base * __restrict base,
+                           struct etux_timer_pool *            pool)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __warn_result
+unsigned int
+etux_timer_base_pool_busy(const struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_api(base);
+
+	return base->pbusy;
+}
+
+extern void
+etux_timer_setup_pool(struct etux_timer_pool * pool)
+	__utils_nothrow __leaf __export_public;
+
+#endif /* defined(CONFIG_ETUX_TIMER_POOL) */
+
+#if defined(CONFIG_ETUX_TIMER_STATS)
+
+/******************************************************************************
+ * Timer base statistics
+ ******************************************************************************/
+
+/*
+ * Retrieve a snapshot of timer base statistics.
+ *
+ * May be called from any thread while the base owner thread is running it.
+ * Counters are read one at a time, hence the snapshot is not guaranteed to be
+ * consistent across counters. stats->stamp is set to the current monotonic
+ * time.
+ */
+extern void
+etux_timer_base_get_stats(const struct etux_timer_base * __restrict base,
+                          struct etux_timer_stats * __restrict      stats)
+	__utils_nonull(1, 2) __utils_nothrow __leaf __export_public;
+
+extern void
+etux_timer_get_stats(struct etux_timer_stats * __restrict stats)
+	__utils_nonull(1) __utils_nothrow __leaf __export_public;
+
+/*
+ * Retrieve the lower bound of the lateness range accounted into the given
+ * histogram bucket.
+ */
+extern void
+etux_timer_stats_bucket_tspec(unsigned int                 bucket,
+                              struct timespec * __restrict tspec)
+	__utils_nonull(2) __utils_nothrow __leaf __export_public;
+
+#endif /* defined(CONFIG_ETUX_TIMER_STATS) */
+
+#if defined(CONFIG_ETUX_TIMER_POLL)
+
+#include <utils/poll.h>
+
+/******************************************************************************
+ * Poll'able timer driver
+ ******************************************************************************/
+
+/*
+ * Drive a timer base from within a upoll based event loop.
+ *
+ * A timerfd file descriptor is registered into the poller and programmed to
+ * expire at the base's next expiry date with timer tick precision. Once
+ * expired, the base is run from within the poller dispatching context.
+ *
+ * Call etux_timer_poll_update() once per loop iteration before waiting for
+ * events so that timers armed / canceled by other workers are taken into
+ * account (or use etux_timer_poll_process() that does it for you). The timerfd
+ * is reprogrammed only when the base's next expiry tick changes.
+ *
+ * etux_timer_poll_process() also refreshes the base's cached clock sample right
+ * after waking up when CONFIG_ETUX_TIMER_CLOCK_CACHE is enabled (see
+ * etux_timer_base_setup_clock()).
+ */
+struct etux_timer_poll {
+	struct upoll_worker      work;
+	int                      fd;
+	int64_t                  tick;
+	struct etux_timer_base * base;
+};
+
+extern void
+etux_timer_poll_update(struct etux_timer_poll * __restrict tpoll)
+	__utils_nonull(1) __utils_nothrow __export_public;
+
+extern int
+etux_timer_poll_process(struct etux_timer_poll * tpoll,
+                        const struct upoll *     poller)
+	__utils_nonull(1, 2) __export_public;
+
+extern int
+etux_timer_base_poll_open(struct etux_timer_poll * __restrict tpoll,
+                          struct etux_timer_base *            base,
+                          const struct upoll * __restrict     poller)
+	__utils_nonull(1, 2, 3) __utils_nothrow __warn_result __export_public;
+
+extern int
+etux_timer_poll_open(struct etux_timer_poll * __restrict tpoll,
+                     const struct upoll * __restrict     poller)
+	__utils_nonull(1, 2) __utils_nothrow __warn_result __export_public;
+
+extern void
+etux_timer_poll_close(struct etux_timer_poll * __restrict tpoll,
+                      const struct upoll * __restrict     poller)
+	__utils_nonull(1, 2) __utils_nothrow __export_public;
+
+#endif /* defined(CONFIG_ETUX_TIMER_POLL) */
+
 #endif /* _ETUX_TIMER_H */
@@ -864,6 +864,7 @@ int
 unsk_dgram_async_svc_close(struct unsk_async_svc * __restrict svc,
                            const struct upoll * __restrict    poller)
 {
+	upoll_discard(poller, &svc->work);
 	upoll_unregister(poller, svc->sock.fd);
 
 	return unsk_svc_close(&svc->sock);
@@ -32,6 +32,8 @@ endif # ($(CONFIG_ETUX_NET),y)
 solibs                 := libutils.so
 libutils.so-objs       := $(addprefix shared/,$(libutils-objects))
 shared/thread.o-cflags := -pthread $(shared-common-cflags)
+shared/poll.o-cflags   := $(call kconf_enabled,UTILS_POLL_GROUP,-pthread) \
+                          $(shared-common-cflags)
 libutils.so-cflags     := $(shared-common-cflags)
 libutils.so-ldflags    := $(call kconf_enabled,UTILS_THREAD,-pthread) \
                           $(shared-common-ldflags)
@@ -50,6 +52,8 @@ libutils.a-lots        := $(call kconf_enabled, \
                                  ETUX_NET, \
                                  ../net/static/builtin.a)
 static/thread.o-cflags := -pthread $(shared-common-cflags)
+static/poll.o-cflags   := $(call kconf_enabled,UTILS_POLL_GROUP,-pthread) \
+                          $(common-cflags)
 libutils.a-cflags      := $(common-cflags)
 libutils.a-pkgconf     := $(common-pkgconf)
 
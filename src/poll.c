@@ -9,163 +9,2116 @@
 #include "utils/fd.h"
 #include <string.h>
 
+/*
+ * Tell whether an event mask given at registration time is valid or not.
+ *
+ * See <linux>/fs/eventpoll.c for EPOLLEXCLUSIVE restrictions.
+ */
+static inline __utils_const __utils_nothrow __warn_result
+bool
+upoll_register_valid(uint32_t events)
+{
+	if (events & ~(UPOLL_WATCH_EVENTS | UPOLL_MODE_FLAGS))
+		return false;
+
+	if (events & EPOLLEXCLUSIVE)
+		return !(events & ~((uint32_t)(EPOLLIN | EPOLLOUT | EPOLLET |
+		                               EPOLLEXCLUSIVE)));
+
+	return true;
+}
+
+/******************************************************************************
+ * Events batch sizing
+ ******************************************************************************/
+
+#if defined(CONFIG_UTILS_POLL_BATCH)
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*
+ * Number of upoll_wait() calls over which the peak number of collected events
+ * is observed before deciding to shrink the batch.
+ */
+#define UPOLL_BATCH_WINDOW     (64U)
+
+/*
+ * Events arrays at least as large as a transparent huge page are aligned and
+ * released with huge page granularity.
+ */
+#define UPOLL_BATCH_HPAGE_SIZE (2UL << 20)
+
+/*
+ * Return the maximum number of events to collect per upoll_wait() call.
+ */
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __warn_result
+unsigned int
+upoll_batch_nr(const struct upoll * __restrict poller)
+{
+	upoll_assert_intern(poller);
+
+	return poller->batch ? poller->batch->cur : poller->nr;
+}
+
+/*
+ * Give pages lying beyond the current batch size back to the kernel. They
+ * are faulted in again on demand once the batch grows.
+ */
+static __utils_nonull(1) __utils_nothrow
+void
+upoll_batch_release(const struct upoll * __restrict poller)
+{
+	upoll_assert_intern(poller);
+	upoll_assert_intern(poller->batch);
+
+	const struct upoll_batch * batch = poller->batch;
+	size_t                     used;
+	int                        err __unused;
+
+	used = batch->cur * sizeof(poller->events[0]);
+	used = ((used + batch->gran - 1) / batch->gran) * batch->gran;
+	if (used >= batch->size)
+		return;
+
+	err = madvise((char *)poller->events + used,
+	              batch->size - used,
+	              MADV_DONTNEED);
+	upoll_assert_intern(!err);
+}
+
+/*
+ * Adjust the batch size according to the number of events collected by the
+ * last upoll_wait() call.
+ *
+ * The batch size doubles as soon as a call saturates it and is halved when
+ * the peak number of events collected over the last UPOLL_BATCH_WINDOW calls
+ * does not exceed a quarter of it.
+ */
+static __utils_nonull(1) __utils_nothrow
+void
+upoll_batch_adapt(const struct upoll * __restrict poller, unsigned int cnt)
+{
+	upoll_assert_intern(poller);
+	upoll_assert_intern(poller->batch);
+
+	struct upoll_batch * batch = poller->batch;
+
+	upoll_assert_intern(cnt <= batch->cur);
+
+	batch->waits++;
+
+	if (cnt == batch->cur) {
+		batch->saturated++;
+		if (batch->cur < poller->nr) {
+			batch->cur = stroll_min(2 * batch->cur, poller->nr);
+			batch->grows++;
+			batch->peak = 0;
+			batch->window = 0;
+			return;
+		}
+	}
+
+	batch->peak = stroll_max(batch->peak, cnt);
+	if (++batch->window < UPOLL_BATCH_WINDOW)
+		return;
+
+	if ((batch->cur > batch->min) && (batch->peak <= (batch->cur / 4))) {
+		batch->cur = stroll_max(batch->cur / 2, batch->min);
+		batch->shrinks++;
+		upoll_batch_release(poller);
+	}
+
+	batch->peak = 0;
+	batch->window = 0;
+}
+
+/*
+ * Map an anonymous events array of `size' bytes aligned on a `gran' bytes
+ * boundary.
+ */
+static __utils_nothrow __warn_result
+void *
+upoll_batch_map(size_t size, size_t gran)
+{
+	char *    map;
+	uintptr_t start;
+	size_t    head;
+
+	map = mmap(NULL,
+	           size + gran,
+	           PROT_READ | PROT_WRITE,
+	           MAP_PRIVATE | MAP_ANONYMOUS,
+	           -1,
+	           0);
+	if (map == MAP_FAILED)
+		return NULL;
+
+	start = (((uintptr_t)map + gran - 1) / gran) * gran;
+	head = start - (uintptr_t)map;
+	if (head)
+		munmap(map, head);
+	munmap((char *)start + size, gran - head);
+
+	return (void *)start;
+}
+
+int
+upoll_setup_batch(struct upoll * __restrict poller, unsigned int max)
+{
+	upoll_assert_api(poller);
+	upoll_assert_intern(poller->fd >= 0);
+	upoll_assert_intern(poller->nr > 0);
+	upoll_assert_intern(poller->events);
+	upoll_assert_api(!poller->batch);
+	upoll_assert_api(max >= poller->nr);
+	upoll_assert_api(max <= INT_MAX);
+
+	struct upoll_batch * batch;
+	size_t               size = max * sizeof(poller->events[0]);
+	size_t               gran;
+	struct epoll_event * evts;
+
+	if (size >= UPOLL_BATCH_HPAGE_SIZE)
+		gran = UPOLL_BATCH_HPAGE_SIZE;
+	else {
+		long pgsz;
+
+		pgsz = sysconf(_SC_PAGESIZE);
+		if (pgsz < 0)
+			return -errno;
+		gran = (size_t)pgsz;
+	}
+	size = ((size + gran - 1) / gran) * gran;
+
+	batch = malloc(sizeof(*batch));
+	if (!batch)
+		return -ENOMEM;
+
+	evts = upoll_batch_map(size, gran);
+	if (!evts) {
+		free(batch);
+		return -ENOMEM;
+	}
+
+	if (gran == UPOLL_BATCH_HPAGE_SIZE)
+		/* Kernels lacking transparent huge page support fail this. */
+		madvise(evts, size, MADV_HUGEPAGE);
+
+	batch->min = poller->nr;
+	batch->cur = poller->nr;
+	batch->peak = 0;
+	batch->window = 0;
+	batch->size = size;
+	batch->gran = gran;
+	batch->waits = 0;
+	batch->saturated = 0;
+	batch->grows = 0;
+	batch->shrinks = 0;
+
+	free(poller->events);
+	poller->events = evts;
+	poller->nr = max;
+	poller->batch = batch;
+
+	return 0;
+}
+
+static __utils_nonull(1) __utils_nothrow
+void
+upoll_batch_close(const struct upoll * __restrict poller)
+{
+	upoll_assert_intern(poller);
+	upoll_assert_intern(poller->batch);
+
+	int err __unused;
+
+	err = munmap(poller->events, poller->batch->size);
+	upoll_assert_intern(!err);
+
+	free(poller->batch);
+}
+
+#else  /* !defined(CONFIG_UTILS_POLL_BATCH) */
+
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __warn_result
+unsigned int
+upoll_batch_nr(const struct upoll * __restrict poller)
+{
+	upoll_assert_intern(poller);
+
+	return poller->nr;
+}
+
+#endif /* defined(CONFIG_UTILS_POLL_BATCH) */
+
+/******************************************************************************
+ * io_uring backend
+ ******************************************************************************/
+
+#if defined(CONFIG_UTILS_POLL_URING)
+
+#include "utils/atomic.h"
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <endian.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * User data of requests which completion is of no interest, i.e. cancelation
+ * requests.
+ */
+#define UPOLL_URING_CTL_DATA \
+	UINT64_MAX
+
+/*
+ * Per file descriptor registration state.
+ *
+ * Poll requests user data are made of the file descriptor and a generation
+ * counter bumped at registration time and when the watch set is modified so
+ * that completions still queued for a replaced request may be told apart.
+ *
+ * Requests which cannot be queued because the submission queue is full and
+ * cannot be submitted are deferred: the slot is then linked into the ring list
+ * of slots to process at next upoll_uring_wait() call. `cancel' and `cgen'
+ * record a deferred cancelation of the request of generation `cgen'.
+ */
+struct upoll_uring_slot {
+	struct upoll_worker * worker;
+	uint32_t              gen;
+	uint32_t              cgen;
+	bool                  armed;
+	bool                  cancel;
+	bool                  rearm;
+	int                   next;
+	unsigned int          batch;
+};
+
+struct upoll_uring {
+	unsigned int              sq_mask;
+	unsigned int              sq_entries;
+	unsigned int              sq_tail;
+	unsigned int              sq_pend;
+	unsigned int *            sq_khead;
+	unsigned int *            sq_ktail;
+	unsigned int *            sq_array;
+	struct io_uring_sqe *     sqes;
+	unsigned int              cq_mask;
+	unsigned int *            cq_khead;
+	unsigned int *            cq_ktail;
+	struct io_uring_cqe *     cqes;
+	void *                    sq_map;
+	size_t                    sq_size;
+	void *                    cq_map;
+	size_t                    cq_size;
+	size_t                    sqes_size;
+	int                       rearm;
+	unsigned int              nr;
+	struct upoll_uring_slot * slots;
+};
+
+static inline __utils_const __utils_nothrow __warn_result
+uint64_t
+upoll_uring_make_data(int fd, uint32_t gen)
+{
+	upoll_assert_intern(fd >= 0);
+
+	return ((uint64_t)gen << 32) | (uint64_t)(uint32_t)fd;
+}
+
+static inline __utils_const __utils_nothrow __warn_result
+int
+upoll_uring_data_fd(uint64_t data)
+{
+	return (int)(uint32_t)data;
+}
+
+static inline __utils_const __utils_nothrow __warn_result
+uint32_t
+upoll_uring_data_gen(uint64_t data)
+{
+	return (uint32_t)(data >> 32);
+}
+
+/*
+ * Kernel expects poll32_events to be word-reversed on big endian platforms.
+ * See <linux>/io_uring/poll.c.
+ */
+static inline __utils_const __utils_nothrow __warn_result
+uint32_t
+upoll_uring_poll_events(uint32_t events)
+{
+	events &= UPOLL_WATCH_EVENTS;
+#if __BYTE_ORDER == __BIG_ENDIAN
+	events = (events << 16) | (events >> 16);
+#endif /* __BYTE_ORDER == __BIG_ENDIAN */
+
+	return events;
+}
+
+/*
+ * Multishot poll requests are edge-triggered only. Level-triggered workers are
+ * watched using single-shot requests re-armed once completed instead (see
+ * upoll_uring_complete()).
+ */
+static inline __utils_const __utils_nothrow __warn_result
+uint32_t
+upoll_uring_poll_flags(uint32_t events)
+{
+	return ((events & (EPOLLET | EPOLLONESHOT)) == EPOLLET) ?
+	       IORING_POLL_ADD_MULTI : 0;
+}
+
+static __utils_nonull(5) __utils_nothrow __warn_result
+int
+upoll_uring_enter(int                                   fd,
+                  unsigned int                          submit,
+                  unsigned int                          complete,
+                  unsigned int                          flags,
+                  const struct io_uring_getevents_arg * arg)
+{
+	upoll_assert_intern(fd >= 0);
+	upoll_assert_intern(arg);
+
+	int ret;
+
+	ret = (int)syscall(__NR_io_uring_enter,
+	                   fd,
+	                   submit,
+	                   complete,
+	                   flags | IORING_ENTER_EXT_ARG,
+	                   arg,
+	                   sizeof(*arg));
+	if (ret < 0) {
+		upoll_assert_intern(errno != EBADF);
+		upoll_assert_intern(errno != EFAULT);
+		upoll_assert_intern(errno != EINVAL);
+		upoll_assert_intern(errno != EOPNOTSUPP);
+
+		return -errno;
+	}
+
+	return ret;
+}
+
+/*
+ * Submit all queued submission queue entries.
+ */
+static __utils_nonull(1) __utils_nothrow __warn_result
+int
+upoll_uring_submit(struct upoll_uring * __restrict ring, int fd)
+{
+	upoll_assert_intern(ring);
+	upoll_assert_intern(fd >= 0);
+
+	const struct io_uring_getevents_arg arg = { 0, };
+
+	while (ring->sq_pend) {
+		int ret;
+
+		ret = upoll_uring_enter(fd, ring->sq_pend, 0, 0, &arg);
+		if (ret < 0) {
+			if (ret == -EINTR)
+				continue;
+			return ret;
+		}
+
+		upoll_assert_intern((unsigned int)ret <= ring->sq_pend);
+		ring->sq_pend -= (unsigned int)ret;
+	}
+
+	return 0;
+}
+
+/*
+ * Return the next free submission queue entry, submitting queued ones first
+ * when the submission queue is full.
+ *
+ * Queued entries are only consumed by the kernel from within io_uring_enter(2)
+ * since the ring is not setup for kernel side polling.
+ */
+static __utils_nonull(1) __utils_nothrow
+struct io_uring_sqe *
+upoll_uring_get_sqe(struct upoll_uring * __restrict ring, int fd)
+{
+	upoll_assert_intern(ring);
+	upoll_assert_intern(fd >= 0);
+
+	struct io_uring_sqe * sqe;
+	unsigned int          idx;
+
+	if ((ring->sq_tail - atomic_load(ring->sq_khead)) == ring->sq_entries) {
+		if (upoll_uring_submit(ring, fd))
+			return NULL;
+	}
+
+	idx = ring->sq_tail & ring->sq_mask;
+	sqe = &ring->sqes[idx];
+	memset(sqe, 0, sizeof(*sqe));
+
+	ring->sq_array[idx] = idx;
+
+	return sqe;
+}
+
+static __utils_nonull(1) __utils_nothrow
+void
+upoll_uring_queue_sqe(struct upoll_uring * __restrict ring)
+{
+	upoll_assert_intern(ring);
+
+	atomic_store(ring->sq_ktail, ++ring->sq_tail);
+	ring->sq_pend++;
+}
+
+/*
+ * Link a slot into the list of slots which requests are to be queued at next
+ * upoll_uring_wait() call.
+ */
+static __utils_nonull(1) __utils_nothrow
+void
+upoll_uring_defer(struct upoll_uring * __restrict ring, int wfd)
+{
+	upoll_assert_intern(ring);
+	upoll_assert_intern(wfd >= 0);
+	upoll_assert_intern((unsigned int)wfd < ring->nr);
+
+	struct upoll_uring_slot * slot = &ring->slots[wfd];
+
+	if (slot->rearm)
+		return;
+
+	slot->rearm = true;
+	slot->next = ring->rearm;
+	ring->rearm = wfd;
+}
+
+static __utils_nonull(1, 3) __utils_nothrow __warn_result
+int
+upoll_uring_queue_poll(struct upoll_uring * __restrict      ring,
+                       int                                  fd,
+                       struct upoll_uring_slot * __restrict slot)
+{
+	upoll_assert_intern(ring);
+	upoll_assert_intern(fd >= 0);
+	upoll_assert_intern(slot);
+	upoll_assert_intern(slot->worker);
+	upoll_assert_intern(!slot->armed);
+	upoll_assert_intern(!slot->cancel);
+
+	struct io_uring_sqe * sqe;
+	uint32_t              evts = slot->worker->kernel;
+
+	sqe = upoll_uring_get_sqe(ring, fd);
+	if (!sqe)
+		return -EAGAIN;
+
+	sqe->opcode = IORING_OP_POLL_ADD;
+	sqe->fd = slot->worker->fd;
+	sqe->len = upoll_uring_poll_flags(evts);
+	sqe->poll32_events = upoll_uring_poll_events(evts);
+	sqe->user_data = upoll_uring_make_data(slot->worker->fd, slot->gen);
+	upoll_uring_queue_sqe(ring);
+
+	slot->armed = true;
+
+	return 0;
+}
+
+/*
+ * IORING_OP_ASYNC_CANCEL is used since, unlike IORING_OP_POLL_REMOVE, it
+ * cannot fail with -EALREADY while the request is being woken up.
+ */
+static __utils_nonull(1) __utils_nothrow __warn_result
+int
+upoll_uring_queue_cancel(struct upoll_uring * __restrict ring,
+                         int                             fd,
+                         int                             wfd,
+                         uint32_t                        gen)
+{
+	upoll_assert_intern(ring);
+	upoll_assert_intern(fd >= 0);
+	upoll_assert_intern(wfd >= 0);
+
+	struct io_uring_sqe * sqe;
+
+	sqe = upoll_uring_get_sqe(ring, fd);
+	if (!sqe)
+		return -EAGAIN;
+
+	sqe->opcode = IORING_OP_ASYNC_CANCEL;
+	sqe->fd = -1;
+	sqe->addr = upoll_uring_make_data(wfd, gen);
+	sqe->user_data = UPOLL_URING_CTL_DATA;
+	upoll_uring_queue_sqe(ring);
+
+	return 0;
+}
+
+/*
+ * Queue a poll request for a registration, deferring it when a cancelation of
+ * its previous request is still pending or when the submission queue is full.
+ */
+static __utils_nonull(1, 3) __utils_nothrow
+void
+upoll_uring_arm(struct upoll_uring * __restrict      ring,
+                int                                  fd,
+                struct upoll_uring_slot * __restrict slot)
+{
+	upoll_assert_intern(ring);
+	upoll_assert_intern(fd >= 0);
+	upoll_assert_intern(slot);
+	upoll_assert_intern(slot->worker);
+	upoll_assert_intern(!slot->armed);
+
+	if (slot->cancel || upoll_uring_queue_poll(ring, fd, slot))
+		upoll_uring_defer(ring, slot->worker->fd);
+}
+
+/*
+ * Cancel the running poll request of a registration, if any.
+ *
+ * Cancelation is deferred when the submission queue is full. The request is
+ * considered as released anyway since its completions are dropped once the
+ * registration is released or its generation bumped.
+ */
+static __utils_nonull(1, 3) __utils_nothrow
+void
+upoll_uring_cancel(struct upoll_uring * __restrict      ring,
+                   int                                  fd,
+                   struct upoll_uring_slot * __restrict slot,
+                   int                                  wfd)
+{
+	upoll_assert_intern(ring);
+	upoll_assert_intern(fd >= 0);
+	upoll_assert_intern(slot);
+	upoll_assert_intern(wfd >= 0);
+
+	if (!slot->armed)
+		return;
+
+	upoll_assert_intern(!slot->cancel);
+
+	slot->armed = false;
+	if (upoll_uring_queue_cancel(ring, fd, wfd, slot->gen)) {
+		slot->cancel = true;
+		slot->cgen = slot->gen;
+		upoll_uring_defer(ring, wfd);
+	}
+}
+
+static __utils_nonull(1) __utils_nothrow __warn_result
+struct upoll_uring_slot *
+upoll_uring_grow_slots(struct upoll_uring * __restrict ring, int fd)
+{
+	upoll_assert_intern(ring);
+	upoll_assert_intern(fd >= 0);
+
+	if ((unsigned int)fd >= ring->nr) {
+		unsigned int              nr = stroll_max(2 * ring->nr, 16U);
+		struct upoll_uring_slot * slots;
+
+		while (nr <= (unsigned int)fd)
+			nr *= 2;
+
+		slots = realloc(ring->slots, nr * sizeof(slots[0]));
+		if (!slots)
+			return NULL;
+
+		memset(&slots[ring->nr],
+		       0,
+		       (nr - ring->nr) * sizeof(slots[0]));
+		ring->slots = slots;
+		ring->nr = nr;
+	}
+
+	return &ring->slots[fd];
+}
+
+static __utils_nonull(1, 3) __utils_nothrow __warn_result
+int
+upoll_uring_register(const struct upoll * __restrict  poller,
+                     int                              fd,
+                     struct upoll_worker * __restrict worker)
+{
+	upoll_assert_intern(poller);
+	upoll_assert_intern(poller->uring);
+	upoll_assert_intern(fd >= 0);
+	upoll_assert_intern(worker);
+	upoll_assert_intern(worker->fd == fd);
+
+	struct upoll_uring *      ring = poller->uring;
+	struct upoll_uring_slot * slot;
+
+	if (worker->kernel & EPOLLEXCLUSIVE)
+		return -EOPNOTSUPP;
+
+	slot = upoll_uring_grow_slots(ring, fd);
+	if (!slot)
+		return -ENOMEM;
+
+	upoll_assert_api(!slot->worker);
+	upoll_assert_intern(!slot->armed);
+
+	slot->worker = worker;
+	slot->gen++;
+	slot->batch = 0;
+
+	upoll_uring_arm(ring, poller->fd, slot);
+
+	return 0;
+}
+
+void
+upoll_uring_unregister(const struct upoll * __restrict poller, int fd)
+{
+	upoll_assert_api(poller);
+	upoll_assert_intern(poller->uring);
+	upoll_assert_api(fd >= 0);
+	upoll_assert_api((unsigned int)fd < poller->uring->nr);
+	upoll_assert_api(poller->uring->slots[fd].worker);
+
+	struct upoll_uring_slot * slot = &poller->uring->slots[fd];
+
+	/*
+	 * Completions still queued for this registration are dropped at
+	 * collection time since the slot worker is cleared.
+	 */
+	upoll_uring_cancel(poller->uring, poller->fd, slot, fd);
+	slot->worker = NULL;
+}
+
+static __utils_nonull(1, 2) __utils_nothrow
+void
+upoll_uring_modify(const struct upoll * __restrict        poller,
+                   const struct upoll_worker * __restrict worker)
+{
+	upoll_assert_intern(poller);
+	upoll_assert_intern(poller->uring);
+	upoll_assert_intern(worker);
+	upoll_assert_intern(worker->kernel == worker->user);
+	upoll_assert_intern((unsigned int)worker->fd < poller->uring->nr);
+	upoll_assert_intern(poller->uring->slots[worker->fd].worker == worker);
+
+	struct upoll_uring_slot * slot = &poller->uring->slots[worker->fd];
+
+	/*
+	 * Replace the running request, if any. Bumping the generation makes
+	 * completions of the canceled request stale.
+	 */
+	upoll_uring_cancel(poller->uring, poller->fd, slot, worker->fd);
+	slot->gen++;
+
+	upoll_uring_arm(poller->uring, poller->fd, slot);
+}
+
+/*
+ * Turn a poll request completion into an event mask to dispatch to the worker
+ * it was submitted for.
+ *
+ * Return a null event mask for completions which must not be dispatched.
+ */
+static __utils_nonull(1, 2, 3) __utils_nothrow
+uint32_t
+upoll_uring_complete(struct upoll_uring * __restrict        ring,
+                     const struct io_uring_cqe * __restrict cqe,
+                     struct upoll_uring_slot **             slot)
+{
+	upoll_assert_intern(ring);
+	upoll_assert_intern(cqe);
+	upoll_assert_intern(slot);
+
+	int                       wfd;
+	struct upoll_uring_slot * slt;
+	uint32_t                  evts;
+
+	if (cqe->user_data == UPOLL_URING_CTL_DATA)
+		return 0;
+
+	wfd = upoll_uring_data_fd(cqe->user_data);
+	upoll_assert_intern(wfd >= 0);
+	if ((unsigned int)wfd >= ring->nr)
+		return 0;
+
+	slt = &ring->slots[wfd];
+	if (!slt->worker || (slt->gen != upoll_uring_data_gen(cqe->user_data)))
+		/* Stale completion for a released registration. */
+		return 0;
+
+	if (cqe->res == -ECANCELED)
+		evts = 0;
+	else if (cqe->res < 0)
+		evts = EPOLLERR;
+	else
+		evts = (uint32_t)cqe->res;
+
+	if (!(cqe->flags & IORING_CQE_F_MORE)) {
+		/* Poll request terminated. */
+		slt->armed = false;
+
+		if (!(slt->worker->kernel & EPOLLONESHOT) && (cqe->res >= 0))
+			/*
+			 * Re-arm level-triggered workers requests as well as
+			 * multishot requests the kernel may terminate, on
+			 * completion queue overflow for example.
+			 * Re-arming is deferred till next upoll_uring_wait()
+			 * call, i.e. once the worker has been dispatched, so
+			 * that the kernel checks whether the file descriptor is
+			 * still ready at that time.
+			 */
+			upoll_uring_defer(ring, wfd);
+	}
+
+	*slot = slt;
+
+	return evts;
+}
+
+/*
+ * Collect completions into the poller events array, merging events of a
+ * worker which completions are reported multiple times.
+ */
+static __utils_nonull(1) __utils_nothrow
+unsigned int
+upoll_uring_collect(const struct upoll * __restrict poller)
+{
+	upoll_assert_intern(poller);
+	upoll_assert_intern(poller->uring);
+
+	struct upoll_uring * ring = poller->uring;
+	unsigned int         head = *ring->cq_khead;
+	unsigned int         tail = atomic_load(ring->cq_ktail);
+	unsigned int         cnt = 0;
+	unsigned int         e;
+
+	while (head != tail) {
+		const struct io_uring_cqe * cqe;
+		struct upoll_uring_slot *   slot;
+		uint32_t                    evts;
+
+		cqe = &ring->cqes[head & ring->cq_mask];
+		if ((cqe->user_data != UPOLL_URING_CTL_DATA) &&
+		    (cnt == upoll_batch_nr(poller))) {
+			/*
+			 * Events array is full: leave remaining completions
+			 * for next call unless they may be merged.
+			 */
+			int wfd = upoll_uring_data_fd(cqe->user_data);
+
+			if (((unsigned int)wfd >= ring->nr) ||
+			    !ring->slots[wfd].batch)
+				break;
+		}
+
+		evts = upoll_uring_complete(ring, cqe, &slot);
+		head++;
+		if (!evts)
+			continue;
+
+		if (!slot->batch) {
+			poller->events[cnt].events = evts;
+			poller->events[cnt].data.ptr = slot->worker;
+			slot->batch = ++cnt;
+		}
+		else
+			poller->events[slot->batch - 1].events |= evts;
+	}
+
+	atomic_store(ring->cq_khead, head);
+
+	for (e = 0; e < cnt; e++) {
+		const struct upoll_worker * wk = poller->events[e].data.ptr;
+
+		ring->slots[wk->fd].batch = 0;
+	}
+
+	return cnt;
+}
+
+static __utils_nonull(1) __utils_nothrow __warn_result
+bool
+upoll_uring_ready(const struct upoll_uring * __restrict ring)
+{
+	upoll_assert_intern(ring);
+
+	return *ring->cq_khead != atomic_load(ring->cq_ktail);
+}
+
+/*
+ * Queue deferred requests, i.e. cancelations and poll requests which could not
+ * be queued because the submission queue was full, as well as poll requests of
+ * workers which re-arming has been deferred by upoll_uring_complete().
+ *
+ * Slots which requests still cannot be queued are left linked for next call.
+ */
+static __utils_nonull(1) __utils_nothrow
+void
+upoll_uring_rearm(struct upoll_uring * __restrict ring, int fd)
+{
+	upoll_assert_intern(ring);
+	upoll_assert_intern(fd >= 0);
+
+	while (ring->rearm >= 0) {
+		int                       wfd = ring->rearm;
+		struct upoll_uring_slot * slot = &ring->slots[wfd];
+
+		upoll_assert_intern(slot->rearm);
+
+		if (slot->cancel) {
+			if (upoll_uring_queue_cancel(ring, fd, wfd, slot->cgen))
+				return;
+			slot->cancel = false;
+		}
+
+		/*
+		 * Skip workers unregistered or re-armed by upoll_apply() in the
+		 * meantime.
+		 */
+		if (slot->worker &&
+		    !slot->armed &&
+		    upoll_uring_queue_poll(ring, fd, slot))
+			return;
+
+		ring->rearm = slot->next;
+		slot->rearm = false;
+	}
+}
+
+static inline __utils_nothrow __warn_result
+int64_t
+upoll_uring_now(void)
+{
+	struct timespec now;
+	int             err __unused;
+
+	err = clock_gettime(CLOCK_MONOTONIC, &now);
+	upoll_assert_intern(!err);
+
+	return ((int64_t)now.tv_sec * INT64_C(1000000000)) + now.tv_nsec;
+}
+
+/*
+ * Submit queued registration changes and wait for completions using a single
+ * io_uring_enter(2) system call.
+ *
+ * Completions which must not be dispatched, i.e. stale ones and those of
+ * registration changes, do not count as activity: waiting goes on till the
+ * timeout, if any, expires.
+ */
+static __utils_nonull(1) __utils_nothrow
+int
+upoll_uring_wait(const struct upoll * __restrict poller, int tmout)
+{
+	upoll_assert_intern(poller);
+	upoll_assert_intern(poller->uring);
+
+	struct upoll_uring *          ring = poller->uring;
+	struct __kernel_timespec      ts;
+	struct io_uring_getevents_arg arg = { 0, };
+	int64_t                       expiry = 0;
+
+	upoll_uring_rearm(ring, poller->fd);
+
+	if (tmout > 0)
+		expiry = upoll_uring_now() + ((int64_t)tmout * INT64_C(1000000));
+
+	do {
+		/* Do not block while completions are left to collect. */
+		bool         wait = tmout && !upoll_uring_ready(ring);
+		bool         expired = false;
+		unsigned int cnt;
+		int          ret = 0;
+
+		arg.ts = 0;
+		if (wait && (tmout > 0)) {
+			int64_t left = expiry - upoll_uring_now();
+
+			if (left <= 0) {
+				wait = false;
+				expired = true;
+			}
+			else {
+				ts.tv_sec = left / INT64_C(1000000000);
+				ts.tv_nsec = left % INT64_C(1000000000);
+				arg.ts = (uint64_t)(uintptr_t)&ts;
+			}
+		}
+
+		if (wait || ring->sq_pend) {
+			ret = upoll_uring_enter(poller->fd,
+			                        ring->sq_pend,
+			                        wait,
+			                        wait ? IORING_ENTER_GETEVENTS : 0,
+			                        &arg);
+			if (ret >= 0) {
+				upoll_assert_intern((unsigned int)ret <=
+				                    ring->sq_pend);
+				ring->sq_pend -= (unsigned int)ret;
+			}
+			else if ((ret != -ETIME) &&
+			         (ret != -EINTR) &&
+			         (ret != -EBUSY))
+				return ret;
+		}
+
+		cnt = upoll_uring_collect(poller);
+		if (cnt)
+			return (int)cnt;
+		else if (ret == -EINTR)
+			return -EINTR;
+		else if ((ret == -ETIME) || expired)
+			return 0;
+
+		/*
+		 * Only completions which must not be dispatched were collected:
+		 * wait again for the remaining time, if any.
+		 */
+	} while (tmout);
+
+	return 0;
+}
+
+static __utils_nonull(1) __utils_nothrow
+void
+upoll_uring_unmap(const struct upoll_uring * __restrict ring)
+{
+	upoll_assert_intern(ring);
+
+	munmap(ring->sqes, ring->sqes_size);
+	if (ring->cq_map != ring->sq_map)
+		munmap(ring->cq_map, ring->cq_size);
+	munmap(ring->sq_map, ring->sq_size);
+}
+
+static __utils_nonull(1, 3) __utils_nothrow __warn_result
+int
+upoll_uring_map(struct upoll_uring * __restrict           ring,
+                int                                       fd,
+                const struct io_uring_params * __restrict params)
+{
+	upoll_assert_intern(ring);
+	upoll_assert_intern(fd >= 0);
+	upoll_assert_intern(params);
+
+	int err;
+
+	ring->sq_size = params->sq_off.array +
+	                (params->sq_entries * sizeof(unsigned int));
+	ring->cq_size = params->cq_off.cqes +
+	                (params->cq_entries * sizeof(struct io_uring_cqe));
+	if (params->features & IORING_FEAT_SINGLE_MMAP)
+		ring->sq_size = ring->cq_size = stroll_max(ring->sq_size,
+		                                           ring->cq_size);
+
+	ring->sq_map = mmap(NULL,
+	                    ring->sq_size,
+	                    PROT_READ | PROT_WRITE,
+	                    MAP_SHARED | MAP_POPULATE,
+	                    fd,
+	                    IORING_OFF_SQ_RING);
+	if (ring->sq_map == MAP_FAILED)
+		return -errno;
+
+	if (params->features & IORING_FEAT_SINGLE_MMAP)
+		ring->cq_map = ring->sq_map;
+	else {
+		ring->cq_map = mmap(NULL,
+		                    ring->cq_size,
+		                    PROT_READ | PROT_WRITE,
+		                    MAP_SHARED | MAP_POPULATE,
+		                    fd,
+		                    IORING_OFF_CQ_RING);
+		if (ring->cq_map == MAP_FAILED) {
+			err = -errno;
+			goto unmap_sq;
+		}
+	}
+
+	ring->sqes_size = params->sq_entries * sizeof(struct io_uring_sqe);
+	ring->sqes = mmap(NULL,
+	                  ring->sqes_size,
+	                  PROT_READ | PROT_WRITE,
+	                  MAP_SHARED | MAP_POPULATE,
+	                  fd,
+	                  IORING_OFF_SQES);
+	if (ring->sqes == MAP_FAILED) {
+		err = -errno;
+		goto unmap_cq;
+	}
+
+	ring->sq_mask = *(unsigned int *)((char *)ring->sq_map +
+	                                  params->sq_off.ring_mask);
+	ring->sq_entries = params->sq_entries;
+	ring->sq_khead = (unsigned int *)((char *)ring->sq_map +
+	                                  params->sq_off.head);
+	ring->sq_ktail = (unsigned int *)((char *)ring->sq_map +
+	                                  params->sq_off.tail);
+	ring->sq_array = (unsigned int *)((char *)ring->sq_map +
+	                                  params->sq_off.array);
+	ring->sq_tail = *ring->sq_ktail;
+	ring->sq_pend = 0;
+	ring->cq_mask = *(unsigned int *)((char *)ring->cq_map +
+	                                  params->cq_off.ring_mask);
+	ring->cq_khead = (unsigned int *)((char *)ring->cq_map +
+	                                  params->cq_off.head);
+	ring->cq_ktail = (unsigned int *)((char *)ring->cq_map +
+	                                  params->cq_off.tail);
+	ring->cqes = (struct io_uring_cqe *)((char *)ring->cq_map +
+	                                     params->cq_off.cqes);
+
+	return 0;
+
+unmap_cq:
+	if (ring->cq_map != ring->sq_map)
+		munmap(ring->cq_map, ring->cq_size);
+unmap_sq:
+	munmap(ring->sq_map, ring->sq_size);
+
+	return err;
+}
+
+/*
+ * Wait for the completion of the request which user data is given.
+ */
+static __utils_nonull(1) __utils_nothrow __warn_result
+int
+upoll_uring_probe_wait(struct upoll_uring * __restrict ring,
+                       int                             fd,
+                       uint64_t                        data)
+{
+	upoll_assert_intern(ring);
+	upoll_assert_intern(fd >= 0);
+
+	const struct io_uring_getevents_arg arg = { 0, };
+
+	while (true) {
+		unsigned int head = *ring->cq_khead;
+		unsigned int tail;
+		int          ret;
+
+		ret = upoll_uring_submit(ring, fd);
+		if (!ret)
+			ret = upoll_uring_enter(fd,
+			                        0,
+			                        1,
+			                        IORING_ENTER_GETEVENTS,
+			                        &arg);
+		if ((ret < 0) && (ret != -EINTR))
+			return ret;
+
+		tail = atomic_load(ring->cq_ktail);
+		while (head != tail) {
+			const struct io_uring_cqe * cqe;
+
+			cqe = &ring->cqes[head++ & ring->cq_mask];
+			if (cqe->user_data == data) {
+				atomic_store(ring->cq_khead, head);
+				return (int)cqe->flags;
+			}
+		}
+		atomic_store(ring->cq_khead, head);
+	}
+}
+
+/*
+ * Check that multishot poll requests are supported, i.e. Linux >= 5.13, by
+ * watching an always writable eventfd.
+ */
+static __utils_nonull(1) __utils_nothrow __warn_result
+int
+upoll_uring_probe(struct upoll_uring * __restrict ring, int fd)
+{
+	upoll_assert_intern(ring);
+	upoll_assert_intern(fd >= 0);
+
+	struct io_uring_sqe * sqe;
+	int                   efd;
+	int                   ret;
+
+	efd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (efd < 0)
+		return -errno;
+
+	sqe = upoll_uring_get_sqe(ring, fd);
+	upoll_assert_intern(sqe);
+	sqe->opcode = IORING_OP_POLL_ADD;
+	sqe->fd = efd;
+	sqe->len = IORING_POLL_ADD_MULTI;
+	sqe->poll32_events = upoll_uring_poll_events(EPOLLOUT);
+	sqe->user_data = 0;
+	upoll_uring_queue_sqe(ring);
+
+	ret = upoll_uring_probe_wait(ring, fd, 0);
+	if (ret < 0)
+		goto close;
+
+	if (ret & IORING_CQE_F_MORE) {
+		sqe = upoll_uring_get_sqe(ring, fd);
+		upoll_assert_intern(sqe);
+		sqe->opcode = IORING_OP_ASYNC_CANCEL;
+		sqe->fd = -1;
+		sqe->addr = 0;
+		sqe->user_data = UPOLL_URING_CTL_DATA;
+		upoll_uring_queue_sqe(ring);
+
+		ret = upoll_uring_probe_wait(ring, fd, UPOLL_URING_CTL_DATA);
+		if (ret >= 0)
+			ret = 0;
+	}
+	else
+		ret = -EOPNOTSUPP;
+
+close:
+	ufd_close(efd);
+
+	/* Drop remaining completions of the probing request. */
+	atomic_store(ring->cq_khead, atomic_load(ring->cq_ktail));
+
+	return ret;
+}
+
+int
+upoll_setup_uring(struct upoll * __restrict poller, unsigned int entries)
+{
+	upoll_assert_api(poller);
+	upoll_assert_intern(poller->fd >= 0);
+	upoll_assert_api(!poller->uring);
+	upoll_assert_api(entries);
+
+	struct io_uring_params params = { 0, };
+	struct upoll_uring *   ring;
+	int                    fd;
+	int                    err;
+
+	ring = malloc(sizeof(*ring));
+	if (!ring)
+		return -ENOMEM;
+
+	fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+	if (fd < 0) {
+		upoll_assert_api(errno != EINVAL);
+		err = -errno;
+		goto free;
+	}
+
+	if ((params.features & (IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG)) !=
+	    (IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG)) {
+		/* Requires Linux >= 5.11. */
+		err = -EOPNOTSUPP;
+		goto close;
+	}
+
+	err = upoll_uring_map(ring, fd, &params);
+	if (err)
+		goto close;
+
+	err = upoll_uring_probe(ring, fd);
+	if (err)
+		goto unmap;
+
+	ring->rearm = -1;
+	ring->nr = 0;
+	ring->slots = NULL;
+
+	ufd_close(poller->fd);
+	poller->fd = fd;
+	poller->uring = ring;
+
+	return 0;
+
+unmap:
+	upoll_uring_unmap(ring);
+close:
+	ufd_close(fd);
+free:
+	free(ring);
+
+	return err;
+}
+
+static __utils_nonull(1) __utils_nothrow
+void
+upoll_uring_close(const struct upoll * __restrict poller)
+{
+	upoll_assert_intern(poller);
+	upoll_assert_intern(poller->uring);
+
+	upoll_uring_unmap(poller->uring);
+	free(poller->uring->slots);
+	free(poller->uring);
+}
+
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+
+static __utils_nonull(1, 2) __utils_nothrow
+void
+upoll_modify(const struct upoll * __restrict  poller,
+             struct upoll_worker * __restrict worker)
+{
+	upoll_assert_intern(poller);
+	upoll_assert_intern(worker);
+	upoll_assert_intern(worker->fd >= 0);
+	upoll_assert_intern(worker->user != worker->kernel);
+	upoll_assert_api(!((worker->user | worker->kernel) & EPOLLEXCLUSIVE));
+
+	int                err __unused;
+	struct epoll_event evt;
+
+	if (!stroll_dlist_empty(&worker->journal))
+		/* Cancel pending modification, EPOLLONESHOT re-arming included. */
+		stroll_dlist_remove_init(&worker->journal);
+
+	if (!worker->kernel && !(worker->user & UPOLL_WATCH_EVENTS)) {
+		/*
+		 * EPOLLONESHOT worker disabled by the kernel with nothing left
+		 * to watch: keep it disabled and save a system call.
+		 */
+		upoll_assert_intern(worker->user & EPOLLONESHOT);
+		worker->kernel = worker->user;
+		return;
+	}
+
+	/*
+	 * Cannot fail if proper arguments are given...
+	 * See <linux>/fs/eventpoll.c
+	 *
+	 * Also note that the caller is allowed to specify a zero event mask so
+	 * that it may temporarily disable explicitly specified event
+	 * notifications (e.g., anything except EPOLLERR and EPOLLHUP).
+	 * This provides an alternative to calling upoll_unregister() where
+	 * implicit event notifications (e.g., EPOLLERR and EPOLLHUP) are still
+	 * desirable.
+	 */
+#if defined(CONFIG_UTILS_POLL_URING)
+	if (poller->uring) {
+		worker->kernel = worker->user;
+		upoll_uring_modify(poller, worker);
+		return;
+	}
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+
+	evt.events = worker->user;
+	evt.data.ptr = (void *)worker;
+	err = epoll_ctl(poller->fd, EPOLL_CTL_MOD, worker->fd, &evt);
+	upoll_assert_api(!err);
+
+	worker->kernel = worker->user;
+}
+
+void
+upoll_apply(const struct upoll * __restrict poller,
+            int                             fd,
+            struct upoll_worker *           worker)
+{
+	upoll_assert_api(poller);
+	upoll_assert_intern(poller->fd >= 0);
+	upoll_assert_intern(poller->nr > 0);
+	upoll_assert_intern(poller->nr <= INT_MAX);
+	upoll_assert_intern(poller->events);
+	upoll_assert_intern(poller->ring);
+	upoll_assert_api(fd >= 0);
+	upoll_assert_api(worker);
+	upoll_assert_api(worker->dispatch);
+	upoll_assert_api(worker->fd == fd);
+	upoll_assert_api(!(worker->user &
+	                   ~(UPOLL_WATCH_EVENTS | UPOLL_MODE_FLAGS)));
+
+	if (poller->ring->dispatching) {
+		/*
+		 * Defer modification till next upoll_wait() call so that
+		 * modifications made during the dispatch pass are coalesced.
+		 */
+		if (stroll_dlist_empty(&worker->journal))
+			stroll_dlist_nqueue_back(&poller->ring->journal,
+			                         &worker->journal);
+		return;
+	}
+
+	if (worker->user != worker->kernel)
+		upoll_modify(poller, worker);
+}
+
+static __utils_nonull(1, 4) __utils_nothrow
+int
+upoll_register_worker(const struct upoll * __restrict  poller,
+                      int                              fd,
+                      uint32_t                         events,
+                      struct upoll_worker * __restrict worker,
+                      unsigned int                     prio)
+{
+	upoll_assert_intern(poller);
+	upoll_assert_intern(poller->fd >= 0);
+	upoll_assert_intern(poller->nr > 0);
+	upoll_assert_intern(poller->nr <= INT_MAX);
+	upoll_assert_intern(poller->events);
+	upoll_assert_intern(fd >= 0);
+	upoll_assert_intern(upoll_register_valid(events));
+	upoll_assert_intern(worker);
+	upoll_assert_intern(prio < UPOLL_PRIO_NR);
+
+	struct epoll_event evt = {
+		.events   = events,
+		.data.ptr = (void *)worker
+	};
+
+	/*
+	 * Initialize worker before registering it since events may be
+	 * collected by another thread as soon as registered (see
+	 * upoll_group_handoff()).
+	 */
+	worker->fd = fd;
+	worker->user = events;
+	worker->kernel = events;
+	worker->ready = 0;
+	worker->prio = prio;
+	stroll_dlist_init(&worker->ring);
+	stroll_dlist_init(&worker->journal);
+
+#if defined(CONFIG_UTILS_POLL_URING)
+	if (poller->uring)
+		return upoll_uring_register(poller, fd, worker);
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+
+	if (epoll_ctl(poller->fd, EPOLL_CTL_ADD, fd, &evt)) {
+		upoll_assert_intern(errno != EBADF);
+		upoll_assert_api(errno != EEXIST);
+		upoll_assert_intern(errno != EINVAL);
+		upoll_assert_api(errno != ELOOP);
+		upoll_assert_intern(errno != ENOENT);
+		upoll_assert_api(errno != EPERM);
+
+		return -errno;
+	}
+
+	return 0;
+}
+
+int
+upoll_register(const struct upoll * __restrict  poller,
+               int                              fd,
+               uint32_t                         events,
+               struct upoll_worker * __restrict worker)
+{
+	upoll_assert_api(poller);
+	upoll_assert_api(fd >= 0);
+	upoll_assert_api(upoll_register_valid(events));
+	upoll_assert_api(worker);
+	upoll_assert_api(worker->dispatch);
+
+	return upoll_register_worker(poller,
+	                             fd,
+	                             events,
+	                             worker,
+	                             UPOLL_DFLT_PRIO);
+}
+
+int
+upoll_register_dispatch(const struct upoll * __restrict  poller,
+                        int                              fd,
+                        uint32_t                         events,
+                        struct upoll_worker * __restrict worker,
+                        upoll_dispatch_fn *              dispatch)
+{
+	upoll_assert_api(poller);
+	upoll_assert_api(fd >= 0);
+	upoll_assert_api(upoll_register_valid(events));
+	upoll_assert_api(worker);
+	upoll_assert_api(dispatch);
+
+	int ret;
+
+	ret = upoll_register_worker(poller,
+	                            fd,
+	                            events,
+	                            worker,
+	                            UPOLL_DFLT_PRIO);
+	if (ret)
+		return ret;
+
+	worker->dispatch = dispatch;
+
+	return 0;
+}
+
+/******************************************************************************
+ * Dispatch ring handling
+ ******************************************************************************/
+
+static __utils_nonull(1, 2)
+int
+upoll_dispatch_worker(const struct upoll * __restrict  poller,
+                      struct upoll_worker * __restrict worker,
+                      uint32_t                         events)
+{
+	upoll_assert_intern(poller);
+	upoll_assert_intern(poller->ring);
+	upoll_assert_intern(worker);
+	upoll_assert_intern(worker->dispatch);
+	upoll_assert_intern(stroll_dlist_empty(&worker->ring));
+
+	if (stroll_dlist_empty(&worker->journal))
+		/* Drop modifications not submitted through upoll_apply(). */
+		worker->user = worker->kernel;
+
+	if (worker->kernel & EPOLLONESHOT) {
+		/*
+		 * The kernel has disabled the file descriptor while reporting
+		 * events: schedule re-arming from next upoll_wait() call. Note
+		 * that re-arming is canceled if the dispatch function calls
+		 * upoll_discard().
+		 */
+		worker->kernel = 0;
+		if (stroll_dlist_empty(&worker->journal))
+			stroll_dlist_nqueue_back(&poller->ring->journal,
+			                         &worker->journal);
+	}
+
+	return worker->dispatch(worker, events, poller);
+}
+
+/*
+ * Apply watch set modifications journaled since last call, re-arming
+ * EPOLLONESHOT workers dispatched in the meantime.
+ */
+static __utils_nonull(1) __utils_nothrow
 void
-upoll_apply(const struct upoll * __restrict poller,
-            int                             fd,
-            struct upoll_worker *           worker)
+upoll_ring_flush(const struct upoll * __restrict poller)
+{
+	upoll_assert_intern(poller);
+	upoll_assert_intern(poller->ring);
+	upoll_assert_intern(!poller->ring->dispatching);
+
+	struct stroll_dlist_node * journal = &poller->ring->journal;
+
+	while (!stroll_dlist_empty(journal)) {
+		struct upoll_worker * wk;
+
+		wk = stroll_dlist_entry(stroll_dlist_dqueue_front(journal),
+		                        struct upoll_worker,
+		                        journal);
+		stroll_dlist_init(&wk->journal);
+
+		if (wk->user != wk->kernel)
+			upoll_modify(poller, wk);
+	}
+}
+
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __warn_result
+bool
+upoll_ring_pending(const struct upoll * __restrict poller)
+{
+	upoll_assert_intern(poller);
+
+	upoll_assert_intern(poller->ring);
+
+	return poller->ring->count;
+}
+
+/*
+ * Queue events reported by the kernel. Events of a worker already queued are
+ * merged into its pending event mask and the worker keeps its position.
+ */
+static __utils_nonull(1, 2) __utils_nothrow
+void
+upoll_ring_collect(struct upoll_ring * __restrict        ring,
+                   const struct epoll_event * __restrict events,
+                   unsigned int                          nr)
+{
+	upoll_assert_intern(ring);
+	upoll_assert_intern(events);
+
+	unsigned int e;
+
+	for (e = 0; e < nr; e++) {
+		struct upoll_worker * wk = events[e].data.ptr;
+
+		upoll_assert_intern(wk);
+		upoll_assert_intern(wk->dispatch);
+		upoll_assert_intern(wk->prio < UPOLL_PRIO_NR);
+		upoll_assert_intern(events[e].events);
+
+		if (!wk->ready) {
+			stroll_dlist_nqueue_back(&ring->ready[wk->prio],
+			                         &wk->ring);
+			ring->count++;
+		}
+
+		wk->ready |= events[e].events;
+	}
+}
+
+static __utils_nonull(1)
+int
+upoll_ring_dispatch(const struct upoll * poller)
+{
+	upoll_assert_intern(poller);
+	upoll_assert_intern(poller->ring);
+
+	struct upoll_ring * ring = poller->ring;
+	unsigned int        cnt = 0;
+	unsigned int        p;
+
+	for (p = 0; p < UPOLL_PRIO_NR; p++) {
+		while (!stroll_dlist_empty(&ring->ready[p])) {
+			struct upoll_worker * wk;
+			uint32_t              evts;
+			int                   ret;
+
+			if (ring->budget && (cnt == ring->budget))
+				/* Leave remaining workers for next call. */
+				return 0;
+
+			wk = stroll_dlist_entry(
+				stroll_dlist_dqueue_front(&ring->ready[p]),
+				struct upoll_worker,
+				ring);
+			upoll_assert_intern(ring->count);
+			upoll_assert_intern(wk->ready);
+
+			stroll_dlist_init(&wk->ring);
+			ring->count--;
+			evts = wk->ready;
+			wk->ready = 0;
+
+			ret = upoll_dispatch_worker(poller, wk, evts);
+			if (ret)
+				return ret;
+
+			cnt++;
+		}
+	}
+
+	return 0;
+}
+
+void
+upoll_discard(const struct upoll * __restrict  poller,
+              struct upoll_worker * __restrict worker)
 {
 	upoll_assert_api(poller);
-	upoll_assert_intern(poller->fd >= 0);
-	upoll_assert_intern(poller->nr > 0);
-	upoll_assert_intern(poller->nr <= INT_MAX);
-	upoll_assert_intern(poller->events);
-	upoll_assert_api(fd >= 0);
-	upoll_assert_api(!(worker->user &
-	                   ~((uint32_t)
-	                     EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLPRI)));
+	upoll_assert_intern(poller->ring);
 	upoll_assert_api(worker);
-	upoll_assert_api(worker->dispatch);
 
-	if (worker->user != worker->kernel) {
-		int                err __unused;
-		struct epoll_event evt = {
-			.events   = worker->user,
-			.data.ptr = (void *)worker
-		};
+	if (!stroll_dlist_empty(&worker->journal))
+		stroll_dlist_remove_init(&worker->journal);
 
-		/*
-		 * Cannot fail if proper arguments are given...
-		 * See <linux>/fs/eventpoll.c
-		 *
-		 * Also note that the caller is allowed to specify a zero event
-		 * mask so that it may temporarily disable explicitly specified
-		 * event notifications (e.g., anything except EPOLLERR and
-		 * EPOLLHUP).
-		 * This provides an alternative to calling upoll_unregister()
-		 * where implicit event notifications (e.g., EPOLLERR and
-		 * EPOLLHUP) are still desirable.
-		 */
-		err = epoll_ctl(poller->fd, EPOLL_CTL_MOD, fd, &evt);
-		upoll_assert_api(!err);
+	if (stroll_dlist_empty(&worker->ring)) {
+		upoll_assert_intern(!worker->ready);
+		return;
+	}
 
-		worker->kernel = worker->user;
+	upoll_assert_intern(worker->ready);
+	upoll_assert_intern(poller->ring->count);
+
+	stroll_dlist_remove_init(&worker->ring);
+	poller->ring->count--;
+	worker->ready = 0;
+}
+
+/*
+ * Discard the worker watching the given file descriptor, if queued for
+ * dispatch or journaled.
+ */
+void
+upoll_ring_forget(const struct upoll * __restrict poller, int fd)
+{
+	upoll_assert_api(poller);
+	upoll_assert_intern(poller->ring);
+	upoll_assert_api(fd >= 0);
+
+	struct upoll_ring *   ring = poller->ring;
+	struct upoll_worker * wk;
+	unsigned int          p;
+
+	stroll_dlist_foreach_entry(&ring->journal, wk, journal) {
+		if (wk->fd == fd)
+			goto discard;
 	}
+
+	for (p = 0; ring->count && (p < UPOLL_PRIO_NR); p++) {
+		stroll_dlist_foreach_entry(&ring->ready[p], wk, ring) {
+			if (wk->fd == fd)
+				goto discard;
+		}
+	}
+
+	return;
+
+discard:
+	upoll_discard(poller, wk);
 }
 
-static __utils_nonull(1, 4) __utils_nothrow
 int
-upoll_register_worker(const struct upoll * __restrict  poller,
-                      int                              fd,
-                      uint32_t                         events,
-                      struct upoll_worker * __restrict worker)
+upoll_setup_ring(struct upoll * __restrict poller, unsigned int budget)
+{
+	upoll_assert_api(poller);
+	upoll_assert_intern(poller->fd >= 0);
+	upoll_assert_intern(poller->ring);
+
+	poller->ring->enabled = true;
+	poller->ring->budget = budget;
+
+	return 0;
+}
+
+static __utils_nonull(1) __utils_nothrow __warn_result
+int
+upoll_ring_init(struct upoll * __restrict poller)
+{
+	upoll_assert_intern(poller);
+
+	struct upoll_ring * ring;
+	unsigned int        p;
+
+	ring = malloc(sizeof(*ring));
+	if (!ring)
+		return -ENOMEM;
+
+	ring->enabled = false;
+	ring->dispatching = false;
+	ring->budget = 0;
+	ring->count = 0;
+	for (p = 0; p < UPOLL_PRIO_NR; p++)
+		stroll_dlist_init(&ring->ready[p]);
+	stroll_dlist_init(&ring->journal);
+
+	poller->ring = ring;
+
+	return 0;
+}
+
+/******************************************************************************
+ * Polling
+ ******************************************************************************/
+
+static __utils_nonull(1)
+int
+upoll_dispatch_events(const struct upoll * poller, unsigned int nr)
 {
 	upoll_assert_intern(poller);
+
+	unsigned int e;
+
+	for (e = 0; e < nr; e++) {
+		const struct epoll_event * evt = &poller->events[e];
+		struct upoll_worker *      wk = evt->data.ptr;
+		int                        ret;
+
+		upoll_assert_intern(wk);
+		upoll_assert_intern(wk->dispatch);
+
+		ret = upoll_dispatch_worker(poller, wk, evt->events);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+int
+upoll_dispatch(const struct upoll * poller, unsigned int nr)
+{
+	upoll_assert_api(poller);
 	upoll_assert_intern(poller->fd >= 0);
 	upoll_assert_intern(poller->nr > 0);
 	upoll_assert_intern(poller->nr <= INT_MAX);
 	upoll_assert_intern(poller->events);
-	upoll_assert_intern(fd >= 0);
-	upoll_assert_intern(!(events &
-	                      ~((uint32_t)
-	                        EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLPRI)));
-	upoll_assert_intern(worker);
+	upoll_assert_intern(poller->ring);
+	upoll_assert_api(!poller->ring->dispatching);
+	upoll_assert_api(nr || poller->ring->enabled);
+	upoll_assert_api(nr <= poller->nr);
 
-	struct epoll_event evt = {
-		.events   = events,
-		.data.ptr = (void *)worker
-	};
+	struct upoll_ring * ring = poller->ring;
+	int                 ret;
 
-	if (epoll_ctl(poller->fd, EPOLL_CTL_ADD, fd, &evt)) {
+	/* Journal watch set modifications made by dispatch functions. */
+	ring->dispatching = true;
+
+	if (ring->enabled) {
+		upoll_ring_collect(ring, poller->events, nr);
+		ret = upoll_ring_dispatch(poller);
+	}
+	else
+		ret = upoll_dispatch_events(poller, nr);
+
+	ring->dispatching = false;
+
+	return ret;
+}
+
+static __utils_nonull(1) __utils_nothrow
+int
+upoll_epoll_wait(const struct upoll * __restrict poller, int tmout)
+{
+	upoll_assert_intern(poller);
+
+	int ret;
+
+	ret = epoll_wait(poller->fd,
+	                 poller->events,
+	                 (int)upoll_batch_nr(poller),
+	                 tmout);
+	if (ret < 0) {
 		upoll_assert_intern(errno != EBADF);
-		upoll_assert_api(errno != EEXIST);
+		upoll_assert_intern(errno != EFAULT);
 		upoll_assert_intern(errno != EINVAL);
-		upoll_assert_api(errno != ELOOP);
-		upoll_assert_intern(errno != ENOENT);
-		upoll_assert_api(errno != EPERM);
 
 		return -errno;
 	}
 
-	worker->user = events;
-	worker->kernel = events;
+	return ret;
+}
 
-	return 0;
+static __utils_nonull(1) __utils_nothrow
+int
+upoll_poll(const struct upoll * __restrict poller, int tmout)
+{
+	upoll_assert_intern(poller);
+
+#if defined(CONFIG_UTILS_POLL_URING)
+	if (poller->uring)
+		return upoll_uring_wait(poller, tmout);
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+
+	return upoll_epoll_wait(poller, tmout);
+}
+
+/******************************************************************************
+ * Busy polling
+ ******************************************************************************/
+
+#if defined(CONFIG_UTILS_POLL_BUSY)
+
+#include <sys/ioctl.h>
+#include <time.h>
+
+#if defined(EPIOCSPARAMS)
+
+#define upoll_epoll_params epoll_params
+
+#else  /* !defined(EPIOCSPARAMS) */
+
+/* See <linux>/include/uapi/linux/eventpoll.h */
+struct upoll_epoll_params {
+	uint32_t busy_poll_usecs;
+	uint16_t busy_poll_budget;
+	uint8_t  prefer_busy_poll;
+	uint8_t  __pad;
+};
+
+#define EPIOCSPARAMS _IOW(0x8A, 0x01, struct upoll_epoll_params)
+
+#endif /* defined(EPIOCSPARAMS) */
+
+/* Default kernel busy polling budget, see <linux>/net/core/dev.h */
+#define UPOLL_BUSY_KERN_BUDGET (8U)
+
+static inline __utils_nothrow __warn_result
+uint64_t
+upoll_busy_now(void)
+{
+	struct timespec now;
+	int             err __unused;
+
+	err = clock_gettime(CLOCK_MONOTONIC, &now);
+	upoll_assert_intern(!err);
+
+	return ((uint64_t)now.tv_sec * UINT64_C(1000000000)) +
+	       (uint64_t)now.tv_nsec;
+}
+
+/*
+ * Update the average time spent waiting for events with a weight of 1/8 and
+ * derive the spin window from it.
+ */
+static __utils_nonull(1) __utils_nothrow
+void
+upoll_busy_adapt(struct upoll_busy * __restrict busy, uint64_t idle)
+{
+	upoll_assert_intern(busy);
+
+	busy->idle = busy->idle - (busy->idle >> 3) + (idle >> 3);
+	busy->spin = (busy->idle <= busy->budget) ?
+	             stroll_min(2 * busy->idle, busy->budget) : 0;
 }
 
+static __utils_nonull(1) __utils_nothrow
 int
-upoll_register(const struct upoll * __restrict  poller,
-               int                              fd,
-               uint32_t                         events,
-               struct upoll_worker * __restrict worker)
+upoll_busy_wait(const struct upoll * __restrict poller, int tmout)
+{
+	upoll_assert_intern(poller);
+	upoll_assert_intern(poller->busy);
+	upoll_assert_intern(tmout);
+
+	struct upoll_busy * busy = poller->busy;
+	uint64_t            start = upoll_busy_now();
+	uint64_t            now;
+	uint64_t            win = busy->spin;
+	int                 ret;
+
+	if (tmout > 0)
+		win = stroll_min(win, (uint64_t)tmout * UINT64_C(1000000));
+
+	if (win) {
+		do {
+			ret = upoll_poll(poller, 0);
+			if (ret < 0)
+				return ret;
+			now = upoll_busy_now();
+			if (ret > 0) {
+				busy->hits++;
+				goto adapt;
+			}
+		} while ((now - start) < win);
+
+		busy->misses++;
+
+		if (tmout > 0)
+			tmout = stroll_max(tmout -
+			                   (int)((now - start) / 1000000U),
+			                   0);
+	}
+
+	ret = upoll_poll(poller, tmout);
+	if (ret < 0)
+		return ret;
+	now = upoll_busy_now();
+
+adapt:
+	upoll_busy_adapt(busy, now - start);
+
+	return ret;
+}
+
+int
+upoll_setup_busy(struct upoll * __restrict poller,
+                 unsigned long             budget,
+                 unsigned int              usecs)
 {
 	upoll_assert_api(poller);
-	upoll_assert_api(fd >= 0);
-	upoll_assert_api(!(events &
-	                   ~((uint32_t)
-	                     EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLPRI)));
-	upoll_assert_api(worker);
-	upoll_assert_api(worker->dispatch);
+	upoll_assert_intern(poller->fd >= 0);
+	upoll_assert_api(!poller->busy);
+	upoll_assert_api(budget);
+
+	struct upoll_busy * busy;
+
+	if (usecs) {
+		const struct upoll_epoll_params parms = {
+			.busy_poll_usecs  = usecs,
+			.busy_poll_budget = UPOLL_BUSY_KERN_BUDGET,
+			.prefer_busy_poll = 0
+		};
+
+#if defined(CONFIG_UTILS_POLL_URING)
+		if (poller->uring)
+			return -EOPNOTSUPP;
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+
+		if (ioctl(poller->fd, EPIOCSPARAMS, &parms)) {
+			upoll_assert_intern(errno != EBADF);
+			upoll_assert_intern(errno != EFAULT);
+
+			/* ENOTTY is returned by kernels lacking support. */
+			return (errno == ENOTTY) ? -EOPNOTSUPP : -errno;
+		}
+	}
+
+	busy = malloc(sizeof(*busy));
+	if (!busy)
+		return -ENOMEM;
 
-	return upoll_register_worker(poller, fd, events, worker);
+	busy->budget = budget;
+	/* Start spinning with a full budget window. */
+	busy->idle = budget / 2;
+	busy->spin = budget;
+	busy->hits = 0;
+	busy->misses = 0;
+
+	poller->busy = busy;
+
+	return 0;
+}
+
+#endif /* defined(CONFIG_UTILS_POLL_BUSY) */
+
+/******************************************************************************
+ * Cross-thread tasks
+ ******************************************************************************/
+
+#if defined(CONFIG_UTILS_POLL_TASK)
+
+#include "utils/atomic.h"
+#include <sys/eventfd.h>
+
+/*
+ * Posted tasks are pushed onto a lock-free stack by producers and taken all
+ * at once by the thread owning the poller. An empty stack means the poller
+ * has (or is about to) run every task posted so far and must be woken up by
+ * next producer.
+ */
+struct upoll_tasks {
+	struct upoll_worker work;
+	int                 fd;
+	struct upoll_task * head;
+};
+
+static __utils_nonull(1) __utils_nothrow
+void
+upoll_tasks_kick(const struct upoll_tasks * __restrict tasks)
+{
+	upoll_assert_intern(tasks);
+	upoll_assert_intern(tasks->fd >= 0);
+
+	const uint64_t one = 1;
+	ssize_t        ret __unused;
+
+	ret = ufd_write(tasks->fd, (const char *)&one, sizeof(one));
+	upoll_assert_intern((ret == (ssize_t)sizeof(one)) || (ret == -EAGAIN));
 }
 
+static __utils_nonull(1, 3)
 int
-upoll_register_dispatch(const struct upoll * __restrict  poller,
-                        int                              fd,
-                        uint32_t                         events,
-                        struct upoll_worker * __restrict worker,
-                        upoll_dispatch_fn *              dispatch)
+upoll_tasks_dispatch(struct upoll_worker * worker,
+                     uint32_t              events __unused,
+                     const struct upoll *  poller)
+{
+	upoll_assert_intern(worker);
+	upoll_assert_intern(events & EPOLLIN);
+	upoll_assert_intern(poller);
+
+	struct upoll_tasks * tasks = containerof(worker,
+	                                         struct upoll_tasks,
+	                                         work);
+	struct upoll_task *  task;
+	struct upoll_task *  fifo = NULL;
+	uint64_t             cnt;
+	ssize_t              ret __unused;
+
+	/*
+	 * Clear eventfd counter before taking tasks so that a task posted in
+	 * between always wakes the poller up again.
+	 */
+	ret = ufd_read(tasks->fd, (char *)&cnt, sizeof(cnt));
+	upoll_assert_intern((ret == (ssize_t)sizeof(cnt)) || (ret == -EAGAIN));
+
+	task = atomic_xchg(&tasks->head, NULL);
+
+	/* Tasks are stacked in reverse posting order. */
+	while (task) {
+		struct upoll_task * next = task->next;
+
+		task->next = fifo;
+		fifo = task;
+		task = next;
+	}
+
+	while (fifo) {
+		task = fifo;
+		fifo = task->next;
+
+		/* Task may be posted again or released by its run function. */
+		task->run(task->arg, poller);
+	}
+
+	return 0;
+}
+
+void
+upoll_post(const struct upoll * __restrict poller,
+           struct upoll_task * __restrict  task)
 {
 	upoll_assert_api(poller);
-	upoll_assert_api(fd >= 0);
-	upoll_assert_api(!(events &
-	                   ~((uint32_t)
-	                     EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLPRI)));
-	upoll_assert_api(worker);
-	upoll_assert_api(dispatch);
+	upoll_assert_api(poller->tasks);
+	upoll_assert_api(task);
+	upoll_assert_api(task->run);
 
-	int ret;
+	struct upoll_tasks * tasks = poller->tasks;
+	struct upoll_task *  head;
 
-	ret = upoll_register_worker(poller, fd, events, worker);
-	if (ret)
-		return ret;
+	head = atomic_load(&tasks->head);
+	do {
+		task->next = head;
+	} while (!atomic_cmpxchg(&tasks->head, &head, task));
 
-	worker->dispatch = dispatch;
+	if (!head)
+		upoll_tasks_kick(tasks);
+}
 
-	return 0;
+void
+upoll_wake(const struct upoll * __restrict poller)
+{
+	upoll_assert_api(poller);
+	upoll_assert_api(poller->tasks);
+
+	upoll_tasks_kick(poller->tasks);
 }
 
 int
-upoll_dispatch(const struct upoll * poller, unsigned int nr)
+upoll_setup_tasks(struct upoll * __restrict poller)
 {
 	upoll_assert_api(poller);
 	upoll_assert_intern(poller->fd >= 0);
-	upoll_assert_intern(poller->nr > 0);
-	upoll_assert_intern(poller->nr <= INT_MAX);
-	upoll_assert_intern(poller->events);
-	upoll_assert_api(nr);
-	upoll_assert_api(nr <= poller->nr);
+	upoll_assert_api(!poller->tasks);
 
-	unsigned int e;
+	struct upoll_tasks * tasks;
+	int                  err;
 
-	for (e = 0; e < nr; e++) {
-		const struct epoll_event * evt = &poller->events[e];
-		struct upoll_worker *      wk = evt->data.ptr;
-		int                        ret;
+	tasks = malloc(sizeof(*tasks));
+	if (!tasks)
+		return -ENOMEM;
 
-		upoll_assert_intern(wk);
-		upoll_assert_intern(wk->dispatch);
+	tasks->fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (tasks->fd < 0) {
+		upoll_assert_intern(errno != EINVAL);
+		err = -errno;
+		goto free;
+	}
 
-		wk->user = wk->kernel;
+	tasks->head = NULL;
 
-		ret = wk->dispatch(wk, evt->events, poller);
-		if (ret)
-			return ret;
-	}
+	err = upoll_register_dispatch(poller,
+	                              tasks->fd,
+	                              EPOLLIN,
+	                              &tasks->work,
+	                              upoll_tasks_dispatch);
+	if (err)
+		goto close;
+
+	poller->tasks = tasks;
 
 	return 0;
+
+close:
+	ufd_close(tasks->fd);
+free:
+	free(tasks);
+
+	return err;
+}
+
+static __utils_nonull(1)
+void
+upoll_tasks_close(const struct upoll * __restrict poller)
+{
+	upoll_assert_intern(poller);
+	upoll_assert_intern(poller->tasks);
+
+	struct upoll_tasks * tasks = poller->tasks;
+
+	upoll_unregister(poller, tasks->fd);
+	ufd_close(tasks->fd);
+	free(tasks);
 }
 
+#endif /* defined(CONFIG_UTILS_POLL_TASK) */
+
+/******************************************************************************
+ * Polling
+ ******************************************************************************/
+
 int
 upoll_wait(const struct upoll * __restrict poller, int tmout)
 {
@@ -177,16 +2130,27 @@ upoll_wait(const struct upoll * __restrict poller, int tmout)
 
 	int ret;
 
-	ret = epoll_wait(poller->fd, poller->events, (int)poller->nr, tmout);
-	if (ret < 0) {
-		upoll_assert_intern(errno != EBADF);
-		upoll_assert_intern(errno != EFAULT);
-		upoll_assert_intern(errno != EINVAL);
+	upoll_ring_flush(poller);
 
-		return -errno;
-	}
+	if (upoll_ring_pending(poller))
+		/* Do not block while collected events wait for dispatching. */
+		tmout = 0;
+
+#if defined(CONFIG_UTILS_POLL_BUSY)
+	if (poller->busy && tmout)
+		ret = upoll_busy_wait(poller, tmout);
+	else
+#endif /* defined(CONFIG_UTILS_POLL_BUSY) */
+		ret = upoll_poll(poller, tmout);
+	if (ret < 0)
+		return ret;
+
+#if defined(CONFIG_UTILS_POLL_BATCH)
+	if (poller->batch)
+		upoll_batch_adapt(poller, (unsigned int)ret);
+#endif /* defined(CONFIG_UTILS_POLL_BATCH) */
 
-	if (!ret && (tmout >= 0))
+	if (!ret && (tmout >= 0) && !upoll_ring_pending(poller))
 		return -ETIME;
 
 	return ret;
@@ -202,7 +2166,7 @@ upoll_process(const struct upoll * poller, int tmout)
 	ret = upoll_wait(poller, tmout);
 	if (ret < 0)
 		return ret;
-	else if (!ret && (tmout >= 0))
+	else if (!ret && (tmout >= 0) && !upoll_ring_pending(poller))
 		return -ETIME;
 
 	/* Activity has been detected before timeout expiration. */
@@ -217,21 +2181,45 @@ upoll_open(struct upoll * __restrict poller, unsigned int nr)
 	upoll_assert_api(nr <= INT_MAX);
 
 	int fd;
+	int err;
 
 	poller->events = malloc(nr * sizeof(poller->events[0]));
 	if (!poller->events)
 		return -ENOMEM;
 
+	err = upoll_ring_init(poller);
+	if (err)
+		goto free_events;
+
 	fd = epoll_create1(EPOLL_CLOEXEC);
 	if (fd < 0) {
 		upoll_assert_intern(errno != EINVAL);
-		free(poller->events);
-		return -errno;
+		err = -errno;
+		goto free_ring;
 	}
 
 	poller->fd = fd;
 	poller->nr = nr;
+#if defined(CONFIG_UTILS_POLL_URING)
+	poller->uring = NULL;
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+#if defined(CONFIG_UTILS_POLL_BUSY)
+	poller->busy = NULL;
+#endif /* defined(CONFIG_UTILS_POLL_BUSY) */
+#if defined(CONFIG_UTILS_POLL_BATCH)
+	poller->batch = NULL;
+#endif /* defined(CONFIG_UTILS_POLL_BATCH) */
+#if defined(CONFIG_UTILS_POLL_TASK)
+	poller->tasks = NULL;
+#endif /* defined(CONFIG_UTILS_POLL_TASK) */
 	return 0;
+
+free_ring:
+	free(poller->ring);
+free_events:
+	free(poller->events);
+
+	return err;
 }
 
 void
@@ -245,11 +2233,520 @@ upoll_close(const struct upoll * __restrict poller)
 
 	int err __unused;
 
+#if defined(CONFIG_UTILS_POLL_TASK)
+	if (poller->tasks)
+		upoll_tasks_close(poller);
+#endif /* defined(CONFIG_UTILS_POLL_TASK) */
+
+#if defined(CONFIG_UTILS_POLL_URING)
+	if (poller->uring)
+		upoll_uring_close(poller);
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+
 	err = ufd_close(poller->fd);
 	upoll_assert_intern(err != -ENOSPC);
 	upoll_assert_intern(err != -EDQUOT);
 
-	free(poller->events);
+#if defined(CONFIG_UTILS_POLL_BATCH)
+	if (poller->batch)
+		upoll_batch_close(poller);
+	else
+#endif /* defined(CONFIG_UTILS_POLL_BATCH) */
+		free(poller->events);
+	free(poller->ring);
+#if defined(CONFIG_UTILS_POLL_BUSY)
+	free(poller->busy);
+#endif /* defined(CONFIG_UTILS_POLL_BUSY) */
 
 	return;
 }
+
+/******************************************************************************
+ * Polling groups
+ ******************************************************************************/
+
+#if defined(CONFIG_UTILS_POLL_GROUP)
+
+#include "utils/thread.h"
+#include "utils/atomic.h"
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sched.h>
+
+#define upoll_assert_group_api(_group) \
+	upoll_assert_api(_group); \
+	upoll_assert_api((_group)->policy < UPOLL_GROUP_POLICY_NR); \
+	upoll_assert_api((_group)->nr); \
+	upoll_assert_api((_group)->loops)
+
+/*
+ * Workers of a running loop may only be released by the thread running it
+ * since its dispatch ring and journal are not protected against concurrent
+ * accesses.
+ */
+#define upoll_assert_loop_owner_api(_group, _loop) \
+	upoll_assert_api(!(_group)->run || \
+	                 pthread_equal((_loop)->thread, pthread_self()))
+
+/*
+ * io_uring backed loops are not supported since registering a worker into
+ * them requires access to their submission queue.
+ */
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __warn_result
+bool
+upoll_loop_supported(const struct upoll_loop * __restrict loop)
+{
+	upoll_assert_intern(loop);
+
+#if defined(CONFIG_UTILS_POLL_URING)
+	return !loop->poll.uring;
+#else  /* !defined(CONFIG_UTILS_POLL_URING) */
+	return true;
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+}
+
+static inline __utils_nonull(1) __utils_const __utils_nothrow __returns_nonull
+struct upoll_loop *
+upoll_loop_from_poller(const struct upoll * __restrict poller)
+{
+	return containerof(poller, struct upoll_loop, poll);
+}
+
+static __utils_nonull(1, 3)
+int
+upoll_loop_dispatch_kick(struct upoll_worker * worker __unused,
+                         uint32_t              events __unused,
+                         const struct upoll *  poller __unused)
+{
+	upoll_assert_intern(events & EPOLLIN);
+
+	/* Make the loop exit. */
+	return -ECANCELED;
+}
+
+static
+void *
+upoll_loop_run(void * arg)
+{
+	upoll_assert_intern(arg);
+
+	struct upoll_loop * loop = arg;
+	int                 ret;
+
+	do {
+		ret = upoll_process(&loop->poll, -1);
+	} while (!ret || (ret == -EINTR));
+
+	loop->status = (ret != -ECANCELED) ? ret : 0;
+
+	return NULL;
+}
+
+static __utils_nonull(1) __utils_nothrow __warn_result
+int
+upoll_loop_start(struct upoll_loop * __restrict loop)
+{
+	upoll_assert_intern(loop);
+
+	pthread_attr_t attr;
+	int            err;
+
+	err = pthread_attr_init(&attr);
+	if (err)
+		return -err;
+
+	if (loop->cpu >= 0) {
+		cpu_set_t cpus;
+
+		CPU_ZERO(&cpus);
+		CPU_SET(loop->cpu, &cpus);
+		err = pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+		if (err) {
+			err = -err;
+			goto destroy;
+		}
+	}
+
+	loop->status = 0;
+	err = uthr_create(&loop->thread, &attr, upoll_loop_run, loop);
+
+destroy:
+	pthread_attr_destroy(&attr);
+
+	return err;
+}
+
+static __utils_nonull(1)
+void
+upoll_loop_stop(struct upoll_loop * __restrict loop)
+{
+	upoll_assert_intern(loop);
+	upoll_assert_intern(loop->kfd >= 0);
+
+	const uint64_t one = 1;
+	uint64_t       cnt;
+	ssize_t        ret __unused;
+	int            err __unused;
+
+	ret = ufd_write(loop->kfd, (const char *)&one, sizeof(one));
+	upoll_assert_intern((ret == (ssize_t)sizeof(one)) || (ret == -EAGAIN));
+
+	err = pthread_join(loop->thread, NULL);
+	upoll_assert_intern(!err);
+
+	/* Clear kick so that the loop may be restarted. */
+	ret = ufd_read(loop->kfd, (char *)&cnt, sizeof(cnt));
+	upoll_assert_intern((ret == (ssize_t)sizeof(cnt)) || (ret == -EAGAIN));
+}
+
+static __utils_nonull(1, 2) __utils_nothrow __warn_result
+int
+upoll_loop_open(struct upoll_loop * __restrict  loop,
+                struct upoll_group * __restrict group,
+                int                             cpu,
+                unsigned int                    events)
+{
+	upoll_assert_intern(loop);
+	upoll_assert_intern(group);
+	upoll_assert_intern(cpu >= -1);
+
+	int err;
+
+	err = upoll_open(&loop->poll, events);
+	if (err)
+		return err;
+
+	loop->kfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (loop->kfd < 0) {
+		upoll_assert_intern(errno != EINVAL);
+		err = -errno;
+		goto close;
+	}
+
+	err = upoll_register_dispatch(&loop->poll,
+	                              loop->kfd,
+	                              EPOLLIN,
+	                              &loop->kick,
+	                              upoll_loop_dispatch_kick);
+	if (err)
+		goto close_kick;
+
+	loop->load = 0;
+	loop->cpu = cpu;
+	loop->status = 0;
+	loop->group = group;
+
+	return 0;
+
+close_kick:
+	ufd_close(loop->kfd);
+close:
+	upoll_close(&loop->poll);
+
+	return err;
+}
+
+static __utils_nonull(1)
+void
+upoll_loop_close(struct upoll_loop * __restrict loop)
+{
+	upoll_assert_intern(loop);
+	upoll_assert_intern(loop->kfd >= 0);
+
+	upoll_unregister(&loop->poll, loop->kfd);
+	ufd_close(loop->kfd);
+	upoll_close(&loop->poll);
+}
+
+static __utils_nothrow __warn_result
+int
+upoll_group_incoming_cpu(int fd)
+{
+#if defined(SO_INCOMING_CPU)
+	int       cpu;
+	socklen_t len = sizeof(cpu);
+
+	if (getsockopt(fd, SOL_SOCKET, SO_INCOMING_CPU, &cpu, &len))
+		return -1;
+
+	return cpu;
+#else  /* !defined(SO_INCOMING_CPU) */
+	return -1;
+#endif /* defined(SO_INCOMING_CPU) */
+}
+
+static __utils_nonull(1) __utils_pure __utils_nothrow __returns_nonull
+struct upoll_loop *
+upoll_group_select_load(const struct upoll_group * __restrict group)
+{
+	upoll_assert_intern(group);
+
+	struct upoll_loop * loop = &group->loops[0];
+	unsigned int        l;
+
+	for (l = 1; l < group->nr; l++) {
+		if (atomic_load(&group->loops[l].load) <
+		    atomic_load(&loop->load))
+			loop = &group->loops[l];
+	}
+
+	return loop;
+}
+
+static __utils_nonull(1) __utils_nothrow
+struct upoll_loop *
+upoll_group_select_cpu(const struct upoll_group * __restrict group, int fd)
+{
+	upoll_assert_intern(group);
+
+	int          cpu;
+	unsigned int l;
+
+	cpu = upoll_group_incoming_cpu(fd);
+	if (cpu < 0)
+		return NULL;
+
+	for (l = 0; l < group->nr; l++) {
+		if (group->loops[l].cpu == cpu)
+			return &group->loops[l];
+	}
+
+	return NULL;
+}
+
+static __utils_nonull(1) __utils_nothrow __returns_nonull
+struct upoll_loop *
+upoll_group_select(struct upoll_group * __restrict group, int fd)
+{
+	upoll_assert_intern(group);
+
+	struct upoll_loop * loop;
+
+	switch (group->policy) {
+	case UPOLL_GROUP_RR_POLICY:
+		/* Start from the first loop. */
+		return &group->loops[(atomic_inc(&group->next) - 1) %
+		                     group->nr];
+
+	case UPOLL_GROUP_LOAD_POLICY:
+		return upoll_group_select_load(group);
+
+	case UPOLL_GROUP_CPU_POLICY:
+		loop = upoll_group_select_cpu(group, fd);
+		return loop ? loop : upoll_group_select_load(group);
+
+	default:
+		upoll_assert_intern(0);
+	}
+
+	unreachable();
+}
+
+int
+upoll_group_register(struct upoll_group * __restrict  group,
+                     int                              fd,
+                     uint32_t                         events,
+                     struct upoll_worker * __restrict worker)
+{
+	upoll_assert_group_api(group);
+	upoll_assert_api(fd >= 0);
+	upoll_assert_api(upoll_register_valid(events));
+	upoll_assert_api(worker);
+	upoll_assert_api(worker->dispatch);
+
+	struct upoll_loop * loop;
+	int                 err;
+
+	loop = upoll_group_select(group, fd);
+	if (!upoll_loop_supported(loop))
+		return -EOPNOTSUPP;
+
+	err = upoll_register_worker(&loop->poll,
+	                            fd,
+	                            events,
+	                            worker,
+	                            UPOLL_DFLT_PRIO);
+	if (err)
+		return err;
+
+	atomic_inc(&loop->load);
+
+	return (int)(loop - group->loops);
+}
+
+void
+upoll_group_unregister(struct upoll_group * __restrict  group,
+                       const struct upoll * __restrict  poller,
+                       int                              fd,
+                       struct upoll_worker * __restrict worker)
+{
+	upoll_assert_group_api(group);
+	upoll_assert_api(poller);
+	upoll_assert_api(upoll_loop_from_poller(poller)->group == group);
+	upoll_assert_api(fd >= 0);
+	upoll_assert_api(worker);
+
+	struct upoll_loop * loop = upoll_loop_from_poller(poller);
+
+	upoll_assert_loop_owner_api(group, loop);
+	upoll_assert_intern(loop->load);
+
+	upoll_discard(poller, worker);
+	upoll_unregister(poller, fd);
+
+	atomic_dec(&loop->load);
+}
+
+int
+upoll_group_handoff(struct upoll_group * __restrict  group,
+                    const struct upoll * __restrict  poller,
+                    unsigned int                     to,
+                    int                              fd,
+                    struct upoll_worker * __restrict worker)
+{
+	upoll_assert_group_api(group);
+	upoll_assert_api(poller);
+	upoll_assert_api(upoll_loop_from_poller(poller)->group == group);
+	upoll_assert_api(to < group->nr);
+	upoll_assert_api(fd >= 0);
+	upoll_assert_api(worker);
+	upoll_assert_api(worker->dispatch);
+	upoll_assert_api(worker->fd == fd);
+
+	struct upoll_loop * src = upoll_loop_from_poller(poller);
+	struct upoll_loop * dst = &group->loops[to];
+	unsigned int        prio = worker->prio;
+	int                 err;
+
+	upoll_assert_loop_owner_api(group, src);
+
+	if (src == dst)
+		return 0;
+
+	if (!upoll_loop_supported(dst))
+		return -EOPNOTSUPP;
+
+	upoll_group_unregister(group, poller, fd, worker);
+
+	/*
+	 * Registering with the current user watch set re-arms EPOLLONESHOT
+	 * workers disabled by the kernel.
+	 */
+	err = upoll_register_worker(&dst->poll, fd, worker->user, worker, prio);
+	if (err)
+		return err;
+
+	atomic_inc(&dst->load);
+
+	return 0;
+}
+
+int
+upoll_group_start(struct upoll_group * __restrict group)
+{
+	upoll_assert_group_api(group);
+	upoll_assert_api(!group->run);
+
+	unsigned int l;
+	int          err;
+
+	for (l = 0; l < group->nr; l++) {
+		err = upoll_loop_start(&group->loops[l]);
+		if (err)
+			goto stop;
+	}
+
+	group->run = true;
+
+	return 0;
+
+stop:
+	while (l--)
+		upoll_loop_stop(&group->loops[l]);
+
+	return err;
+}
+
+int
+upoll_group_stop(struct upoll_group * __restrict group)
+{
+	upoll_assert_group_api(group);
+	upoll_assert_api(group->run);
+
+	unsigned int l;
+	int          ret = 0;
+
+	for (l = 0; l < group->nr; l++) {
+		struct upoll_loop * loop = &group->loops[l];
+
+		upoll_loop_stop(loop);
+		if (!ret)
+			ret = loop->status;
+	}
+
+	group->run = false;
+
+	return ret;
+}
+
+int
+upoll_group_open(struct upoll_group * __restrict group,
+                 unsigned int                    nr,
+                 const int * __restrict          cpus,
+                 unsigned int                    events,
+                 enum upoll_group_policy         policy)
+{
+	upoll_assert_api(group);
+	upoll_assert_api(nr);
+	upoll_assert_api(events);
+	upoll_assert_api(events <= INT_MAX);
+	upoll_assert_api(policy < UPOLL_GROUP_POLICY_NR);
+
+	unsigned int l;
+	int          err;
+
+	group->loops = malloc(nr * sizeof(group->loops[0]));
+	if (!group->loops)
+		return -ENOMEM;
+
+	for (l = 0; l < nr; l++) {
+		upoll_assert_api(!cpus || (cpus[l] >= 0));
+
+		err = upoll_loop_open(&group->loops[l],
+		                      group,
+		                      cpus ? cpus[l] : -1,
+		                      events);
+		if (err)
+			goto close;
+	}
+
+	group->policy = policy;
+	group->next = 0;
+	group->run = false;
+	group->nr = nr;
+
+	return 0;
+
+close:
+	while (l--)
+		upoll_loop_close(&group->loops[l]);
+	free(group->loops);
+
+	return err;
+}
+
+void
+upoll_group_close(struct upoll_group * __restrict group)
+{
+	upoll_assert_group_api(group);
+	upoll_assert_api(!group->run);
+
+	unsigned int l;
+
+	for (l = 0; l < group->nr; l++)
+		upoll_loop_close(&group->loops[l]);
+
+	free(group->loops);
+}
+
+#endif /* defined(CONFIG_UTILS_POLL_GROUP) */
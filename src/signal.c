@@ -139,3 +139,182 @@ usig_read_fd(int fd, struct signalfd_siginfo * infos, unsigned int count)
 }
 
 #endif /* defined(CONFIG_UTILS_SIGNAL_FD) */
+
+#if defined(CONFIG_UTILS_POLL_SIGNAL)
+
+#include <string.h>
+
+static __utils_nonull(1, 3)
+int
+usig_dispatch_process(struct upoll_worker * worker,
+                      uint32_t              events __unused,
+                      const struct upoll *  poller __unused)
+{
+	usig_assert_api(worker);
+	usig_assert_api(events & EPOLLIN);
+
+	const struct usig_dispatch * disp = containerof(worker,
+	                                                struct usig_dispatch,
+	                                                work);
+	struct signalfd_siginfo      infos[USIG_DISPATCH_BATCH];
+	int                          cnt;
+	int                          i;
+	int                          ret = 0;
+
+	/*
+	 * Drain as many records as available with a single read(). Remaining
+	 * ones, if any, keep the signalfd readable and are handled at next
+	 * wakeup so that signal storms do not starve other workers.
+	 */
+	cnt = usig_read_fd(disp->fd, infos, USIG_DISPATCH_BATCH);
+	if (cnt < 0)
+		return (cnt == -EAGAIN) ? 0 : cnt;
+
+	for (i = 0; i < cnt; i++) {
+		const struct usig_handler * hdl;
+		int                         err;
+
+		usig_assert_api(infos[i].ssi_signo > 0);
+		usig_assert_api(infos[i].ssi_signo < NSIG);
+
+		hdl = &disp->handlers[infos[i].ssi_signo - 1];
+		if (!hdl->handle)
+			/* Unregistered while pending. */
+			continue;
+
+		err = hdl->handle(&infos[i], hdl->data);
+		if (err && !ret)
+			ret = err;
+	}
+
+	return ret;
+}
+
+static __utils_nonull(1) __utils_nothrow
+int
+usig_dispatch_update(const struct usig_dispatch * __restrict disp)
+{
+	usig_assert_api(disp);
+
+	if (disp->fd < 0)
+		return 0;
+
+	if (signalfd(disp->fd, &disp->mask, 0) < 0) {
+		usig_assert_api(errno != EBADF);
+		usig_assert_api(errno != EINVAL);
+
+		return -errno;
+	}
+
+	return 0;
+}
+
+void
+usig_dispatch_init(struct usig_dispatch * __restrict disp)
+{
+	usig_assert_api(disp);
+
+	disp->fd = -1;
+	usig_emptyset(&disp->mask);
+	memset(disp->handlers, 0, sizeof(disp->handlers));
+}
+
+int
+usig_dispatch_register(struct usig_dispatch * __restrict disp,
+                       int                               signo,
+                       usig_handler_fn *                 handle,
+                       void *                            data)
+{
+	usig_assert_api(disp);
+	usig_assert_api(signo > 0);
+	usig_assert_api(signo < NSIG);
+	usig_assert_api(!usig_ismember(&__usig_inval_msk, signo));
+	usig_assert_api(handle);
+
+	struct usig_handler * hdl = &disp->handlers[signo - 1];
+	int                   err;
+
+	if (!usig_ismember(&disp->mask, signo)) {
+		usig_addset(&disp->mask, signo);
+
+		err = usig_dispatch_update(disp);
+		if (err) {
+			usig_delset(&disp->mask, signo);
+			return err;
+		}
+	}
+
+	hdl->handle = handle;
+	hdl->data = data;
+
+	return 0;
+}
+
+int
+usig_dispatch_unregister(struct usig_dispatch * __restrict disp, int signo)
+{
+	usig_assert_api(disp);
+	usig_assert_api(signo > 0);
+	usig_assert_api(signo < NSIG);
+	usig_assert_api(usig_ismember(&disp->mask, signo));
+
+	int err;
+
+	usig_delset(&disp->mask, signo);
+
+	err = usig_dispatch_update(disp);
+	if (err) {
+		usig_addset(&disp->mask, signo);
+		return err;
+	}
+
+	disp->handlers[signo - 1].handle = NULL;
+	disp->handlers[signo - 1].data = NULL;
+
+	return 0;
+}
+
+int
+usig_dispatch_open(struct usig_dispatch * __restrict disp,
+                   const struct upoll * __restrict   poller)
+{
+	usig_assert_api(disp);
+	usig_assert_api(disp->fd < 0);
+	usig_assert_api(poller);
+
+	int err;
+
+	disp->fd = usig_open_fd(&disp->mask, SFD_NONBLOCK | SFD_CLOEXEC);
+	if (disp->fd < 0)
+		return disp->fd;
+
+	err = upoll_register_dispatch(poller,
+	                              disp->fd,
+	                              EPOLLIN,
+	                              &disp->work,
+	                              usig_dispatch_process);
+	if (err) {
+		usig_close_fd(disp->fd);
+		disp->fd = -1;
+		return err;
+	}
+
+	return 0;
+}
+
+void
+usig_dispatch_close(struct usig_dispatch * __restrict disp,
+                    const struct upoll * __restrict   poller)
+{
+	usig_assert_api(disp);
+	usig_assert_api(disp->fd >= 0);
+	usig_assert_api(poller);
+
+	/* Drop events collected but not yet dispatched, if any. */
+	upoll_discard(poller, &disp->work);
+	upoll_unregister(poller, disp->fd);
+	usig_close_fd(disp->fd);
+	disp->fd = -1;
+}
+
+#endif /* defined(CONFIG_UTILS_POLL_SIGNAL) */
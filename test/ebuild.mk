@@ -41,8 +41,29 @@ etux-utest-objs                  := main.o
 etux-utest-objs                  += $(call kconf_enabled, \
                                            UTILS_TIME, \
                                            time_utest.o)
-etux-utest-cflags                := $(common-cflags)
-etux-utest-ldflags               := $(utest-ldflags)
+etux-utest-objs                  += $(call kconf_enabled, \
+                                           UTILS_POLL, \
+                                           poll_utest.o)
+etux-utest-objs                  += $(call kconf_enabled, \
+                                           UTILS_POLL_SIGNAL, \
+                                           signal_utest.o)
+etux-utest-cflags                := $(common-cflags) \
+                                    $(call kconf_enabled, \
+                                           UTILS_POLL_TASK, \
+                                           -pthread) \
+                                    $(call kconf_enabled, \
+                                           UTILS_POLL_GROUP, \
+                                           -pthread)
+etux-utest-ldflags               := $(utest-ldflags) \
+                                    $(call kconf_enabled, \
+                                           UTILS_POLL, \
+                                           -ldl) \
+                                    $(call kconf_enabled, \
+                                           UTILS_POLL_TASK, \
+                                           -pthread) \
+                                    $(call kconf_enabled, \
+                                           UTILS_POLL_GROUP, \
+                                           -pthread)
 etux-utest-pkgconf               := $(common-pkgconf) libcute
 
 checkbins                        += $(call kconf_enabled, \
@@ -59,7 +80,8 @@ checkbins                        += $(call kconf_enabled, \
                                            etux-timer-heap-utest)
 etux-timer-heap-utest-objs       := heap/timer_utest.o
 etux-timer-heap-utest-cflags     := $(common-cflags) \
-                                    -DETUX_TIMER_UTEST="\"eTux Timer Heap\""
+                                    -DETUX_TIMER_UTEST="\"eTux Timer Heap\"" \
+                                    -DETUX_TIMER_UTEST_HEAP
 etux-timer-heap-utest-ldflags    := $(utest-ldflags) -letux_timer_heap
 etux-timer-heap-utest-pkgconf    := $(common-pkgconf) libcute
 
@@ -68,10 +90,21 @@ checkbins                        += $(call kconf_enabled, \
                                            etux-timer-hwheel-utest)
 etux-timer-hwheel-utest-objs     := hwheel/timer_utest.o
 etux-timer-hwheel-utest-cflags   := $(common-cflags) \
-                                    -DETUX_TIMER_UTEST="\"eTux Timer Hwheel\""
+                                    -DETUX_TIMER_UTEST="\"eTux Timer Hwheel\"" \
+                                    -DETUX_TIMER_UTEST_HWHEEL
 etux-timer-hwheel-utest-ldflags  := $(utest-ldflags) -letux_timer_hwheel
 etux-timer-hwheel-utest-pkgconf  := $(common-pkgconf) libcute
 
+checkbins                        += $(call kconf_enabled, \
+                                           ETUX_TIMER_HYBRID, \
+                                           etux-timer-hybrid-utest)
+etux-timer-hybrid-utest-objs     := hybrid/timer_utest.o
+etux-timer-hybrid-utest-cflags   := $(common-cflags) \
+                                    -DETUX_TIMER_UTEST="\"eTux Timer Hybrid\"" \
+                                    -DETUX_TIMER_UTEST_HWHEEL
+etux-timer-hybrid-utest-ldflags  := $(utest-ldflags) -letux_timer_hybrid
+etux-timer-hybrid-utest-pkgconf  := $(common-pkgconf) libcute
+
 ifeq ($(CONFIG_ETUX_PTEST),y)
 
 builtins                         += builtin_ptest.a
@@ -106,6 +139,22 @@ etux-timer-hwheel-ptest-cflags   := $(common-cflags)
 etux-timer-hwheel-ptest-ldflags  := $(ptest-ldflags) -letux_timer_hwheel
 etux-timer-hwheel-ptest-pkgconf  := $(ptest-pkgconf)
 
+checkbins                        += $(call kconf_enabled, \
+                                           ETUX_TIMER_HYBRID, \
+                                           etux-timer-hybrid-ptest)
+etux-timer-hybrid-ptest-objs     := hybrid/timer_ptest.o
+etux-timer-hybrid-ptest-cflags   := $(common-cflags)
+etux-timer-hybrid-ptest-ldflags  := $(ptest-ldflags) -letux_timer_hybrid
+etux-timer-hybrid-ptest-pkgconf  := $(ptest-pkgconf)
+
+checkbins                        += $(call kconf_enabled, \
+                                           UTILS_POLL_BUSY, \
+                                           etux-poll-ptest)
+etux-poll-ptest-objs             := poll_ptest.o
+etux-poll-ptest-cflags           := $(common-cflags) -pthread
+etux-poll-ptest-ldflags          := $(ptest-ldflags) -pthread
+etux-poll-ptest-pkgconf          := $(ptest-pkgconf)
+
 endif # ($(CONFIG_ETUX_PTEST),y)
 
 # ex: filetype=make :
@@ -11,10 +11,24 @@
 extern CUTE_SUITE_DECL(utilsut_time_suite);
 #endif
 
+#if defined(CONFIG_UTILS_POLL)
+extern CUTE_SUITE_DECL(utilsut_poll_suite);
+#endif
+
+#if defined(CONFIG_UTILS_POLL_SIGNAL)
+extern CUTE_SUITE_DECL(utilsut_signal_suite);
+#endif
+
 CUTE_GROUP(utilsut_group) = {
 #if defined(CONFIG_UTILS_TIME)
 	CUTE_REF(utilsut_time_suite),
 #endif
+#if defined(CONFIG_UTILS_POLL)
+	CUTE_REF(utilsut_poll_suite),
+#endif
+#if defined(CONFIG_UTILS_POLL_SIGNAL)
+	CUTE_REF(utilsut_signal_suite),
+#endif
 };
 
 CUTE_SUITE(utilsut_suite, utilsut_group);
@@ -0,0 +1,408 @@
+#include "ptest.h"
+#include "utils/poll.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+#include <getopt.h>
+#include <errno.h>
+#include <assert.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+/*
+ * Measure UNIX datagram request / response round trip latencies through a
+ * polling loop running into its own thread, optionally in adaptive busy
+ * polling mode.
+ */
+
+#define ETUXPT_POLL_DFLT_REQS  (100000U)
+#define ETUXPT_POLL_DFLT_DELAY (0U)
+#define ETUXPT_POLL_MSG_SIZE   (64U)
+
+struct etuxpt_poll_server {
+	struct upoll        poll;
+	struct upoll_worker work;
+	int                 sk;
+	int                 ret;
+};
+
+static
+int
+etuxpt_poll_serve(struct upoll_worker * worker,
+                  uint32_t              state __unused,
+                  const struct upoll *  poller __unused)
+{
+	const struct etuxpt_poll_server * srv =
+		containerof(worker, struct etuxpt_poll_server, work);
+	char                              msg[ETUXPT_POLL_MSG_SIZE];
+	ssize_t                           ret;
+
+	ret = recv(srv->sk, msg, sizeof(msg), MSG_DONTWAIT);
+	if (ret < 0)
+		return (errno == EAGAIN) ? 0 : -errno;
+	else if (!ret)
+		/* Empty datagram: client requests server to stop. */
+		return -ESHUTDOWN;
+
+	if (send(srv->sk, msg, (size_t)ret, 0) != ret)
+		return -errno;
+
+	return 0;
+}
+
+static
+void *
+etuxpt_poll_run_server(void * arg)
+{
+	struct etuxpt_poll_server * srv = arg;
+	int                         ret;
+
+	do {
+		ret = upoll_process(&srv->poll, -1);
+	} while (!ret || (ret == -EINTR));
+
+	srv->ret = (ret == -ESHUTDOWN) ? 0 : ret;
+
+	return NULL;
+}
+
+static
+unsigned long
+etuxpt_poll_elapsed_nsec(const struct timespec * __restrict start,
+                         const struct timespec * __restrict end)
+{
+	return (unsigned long)(((end->tv_sec - start->tv_sec) * 1000000000L) +
+	                       (end->tv_nsec - start->tv_nsec));
+}
+
+static
+int
+etuxpt_poll_cmp_nsec(const void * first, const void * second)
+{
+	unsigned long fst = *(const unsigned long *)first;
+	unsigned long snd = *(const unsigned long *)second;
+
+	return (fst > snd) - (fst < snd);
+}
+
+/* Return latency at the given quantile expressed in units of 0.01%. */
+static
+unsigned long
+etuxpt_poll_lat_quantile(const unsigned long * __restrict nsec,
+                         unsigned int                     cnt,
+                         unsigned int                     bips)
+{
+	assert(cnt);
+	assert(bips <= 10000);
+
+	uint64_t idx = (((uint64_t)cnt * bips) + 9999) / 10000;
+
+	return nsec[idx ? idx - 1 : 0];
+}
+
+static
+void
+etuxpt_poll_report_lats(unsigned long * __restrict nsec,
+                        unsigned int               cnt,
+                        unsigned long              budget,
+                        unsigned long              delay)
+{
+	unsigned long long sum = 0;
+	unsigned int       n;
+
+	qsort(nsec, cnt, sizeof(nsec[0]), etuxpt_poll_cmp_nsec);
+	for (n = 0; n < cnt; n++)
+		sum += nsec[n];
+
+	printf("%s: %u requests, %lu nsec busy budget, %lu nsec delay\n"
+	       "%-8s %10s %8s %8s %8s %8s %8s %8s %8s (nanoseconds)\n"
+	       "%-8s %10u %8lu %8lu %8lu %8lu %8lu %8lu %8llu\n",
+	       program_invocation_short_name,
+	       cnt,
+	       budget,
+	       delay,
+	       "#op",
+	       "count",
+	       "min",
+	       "p50",
+	       "p90",
+	       "p99",
+	       "p99.9",
+	       "max",
+	       "mean",
+	       "rtt",
+	       cnt,
+	       nsec[0],
+	       etuxpt_poll_lat_quantile(nsec, cnt, 5000),
+	       etuxpt_poll_lat_quantile(nsec, cnt, 9000),
+	       etuxpt_poll_lat_quantile(nsec, cnt, 9900),
+	       etuxpt_poll_lat_quantile(nsec, cnt, 9990),
+	       nsec[cnt - 1],
+	       sum / cnt);
+}
+
+static
+int
+etuxpt_poll_run_client(int                        sk,
+                       unsigned long * __restrict nsec,
+                       unsigned int               cnt,
+                       unsigned long              delay)
+{
+	const struct timespec pause = {
+		.tv_sec  = (time_t)(delay / 1000000000UL),
+		.tv_nsec = (long)(delay % 1000000000UL)
+	};
+	char                  msg[ETUXPT_POLL_MSG_SIZE] = { 0, };
+	unsigned int          n;
+
+	for (n = 0; n < cnt; n++) {
+		struct timespec beg;
+		struct timespec end;
+
+		if (delay)
+			clock_nanosleep(CLOCK_MONOTONIC, 0, &pause, NULL);
+
+		clock_gettime(CLOCK_MONOTONIC, &beg);
+		if (send(sk, msg, sizeof(msg), 0) != (ssize_t)sizeof(msg))
+			goto err;
+		if (recv(sk, msg, sizeof(msg), 0) != (ssize_t)sizeof(msg))
+			goto err;
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		nsec[n] = etuxpt_poll_elapsed_nsec(&beg, &end);
+	}
+
+	return EXIT_SUCCESS;
+
+err:
+	etuxpt_err("failed to exchange message: %s (%d).\n",
+	           strerror(errno),
+	           errno);
+
+	return EXIT_FAILURE;
+}
+
+static
+int
+etuxpt_poll_run(unsigned int  cnt,
+                unsigned long budget,
+                unsigned long delay)
+{
+	int                       sks[2];
+	struct etuxpt_poll_server srv;
+	pthread_t                 thr;
+	unsigned long *           nsec;
+	int                       ret = EXIT_FAILURE;
+	int                       err;
+
+	nsec = malloc(cnt * sizeof(nsec[0]));
+	if (!nsec) {
+		etuxpt_err("failed to allocate latency samples.\n");
+		return EXIT_FAILURE;
+	}
+
+	if (socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sks)) {
+		etuxpt_err("failed to create socket pair: %s (%d).\n",
+		           strerror(errno),
+		           errno);
+		goto free;
+	}
+
+	err = upoll_open(&srv.poll, 1);
+	if (err) {
+		etuxpt_err("failed to open poller: %s (%d).\n",
+		           strerror(-err),
+		           -err);
+		goto close;
+	}
+
+	if (budget) {
+		err = upoll_setup_busy(&srv.poll, budget, 0);
+		if (err) {
+			etuxpt_err("failed to setup busy polling: %s (%d).\n",
+			           strerror(-err),
+			           -err);
+			goto poll;
+		}
+	}
+
+	srv.sk = sks[1];
+	srv.ret = 0;
+	err = upoll_register_dispatch(&srv.poll,
+	                              srv.sk,
+	                              EPOLLIN,
+	                              &srv.work,
+	                              etuxpt_poll_serve);
+	if (err) {
+		etuxpt_err("failed to register server: %s (%d).\n",
+		           strerror(-err),
+		           -err);
+		goto poll;
+	}
+
+	err = pthread_create(&thr, NULL, etuxpt_poll_run_server, &srv);
+	if (err) {
+		etuxpt_err("failed to start server: %s (%d).\n",
+		           strerror(err),
+		           err);
+		goto unreg;
+	}
+
+	ret = etuxpt_poll_run_client(sks[0], nsec, cnt, delay);
+
+	/* Request server to stop. */
+	send(sks[0], NULL, 0, 0);
+	pthread_join(thr, NULL);
+	if (srv.ret) {
+		etuxpt_err("server failed: %s (%d).\n",
+		           strerror(-srv.ret),
+		           -srv.ret);
+		ret = EXIT_FAILURE;
+	}
+
+	if (ret == EXIT_SUCCESS) {
+		etuxpt_poll_report_lats(nsec, cnt, budget, delay);
+		if (budget) {
+			unsigned long hits;
+			unsigned long misses;
+
+			upoll_get_busy_stats(&srv.poll, &hits, &misses);
+			printf("spin: %lu hits, %lu misses\n", hits, misses);
+		}
+	}
+
+unreg:
+	upoll_unregister(&srv.poll, srv.sk);
+poll:
+	upoll_close(&srv.poll);
+close:
+	close(sks[0]);
+	close(sks[1]);
+free:
+	free(nsec);
+
+	return ret;
+}
+
+static void
+etuxpt_poll_usage(FILE * __restrict stdio)
+{
+	fprintf(stdio,
+	        "Usage: %s [OPTIONS]\n"
+	        "where OPTIONS:\n"
+	        "    -n|--requests REQUESTS\n"
+	        "    -b|--busy BUDGET\n"
+	        "    -d|--delay DELAY\n"
+	        "    -p|--prio PRIORITY\n"
+	        "    -h|--help\n"
+	        "with:\n"
+	        "    REQUESTS -- number of request / response round trips\n"
+	        "                (defaults to %u),\n"
+	        "    BUDGET   -- adaptive busy polling spin budget in\n"
+	        "                nanoseconds (defaults to 0, i.e. disabled),\n"
+	        "    DELAY    -- delay between requests in nanoseconds\n"
+	        "                (defaults to %u),\n"
+	        "    PRIORITY -- a SCHED_FIFO priority integer.\n",
+	        program_invocation_short_name,
+	        ETUXPT_POLL_DFLT_REQS,
+	        ETUXPT_POLL_DFLT_DELAY);
+}
+
+int
+main(int argc, char * const argv[])
+{
+	unsigned long reqs = ETUXPT_POLL_DFLT_REQS;
+	unsigned long budget = 0;
+	unsigned long delay = ETUXPT_POLL_DFLT_DELAY;
+	int           prio = 0;
+	int           ret;
+
+	while (true) {
+		int                        opt;
+		static const struct option lopts[] = {
+			{"help",     0, NULL, 'h'},
+			{"requests", 1, NULL, 'n'},
+			{"busy",     1, NULL, 'b'},
+			{"delay",    1, NULL, 'd'},
+			{"prio",     1, NULL, 'p'},
+			{0,          0, 0,    0}
+		};
+
+		opt = getopt_long(argc, argv, "hn:b:d:p:", lopts, NULL);
+		if (opt < 0)
+			break;
+
+		switch (opt) {
+		case 'n': /* number of round trips */
+			if (etuxpt_parse_uint(optarg,
+			                      "number of requests",
+			                      1,
+			                      UINT_MAX,
+			                      &reqs)) {
+				etuxpt_poll_usage(stderr);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'b': /* busy polling budget */
+			if (etuxpt_parse_uint(optarg,
+			                      "busy polling budget",
+			                      0,
+			                      ULONG_MAX,
+			                      &budget)) {
+				etuxpt_poll_usage(stderr);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'd': /* inter-request delay */
+			if (etuxpt_parse_uint(optarg,
+			                      "delay",
+			                      0,
+			                      ULONG_MAX,
+			                      &delay)) {
+				etuxpt_poll_usage(stderr);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'p': /* priority */
+			if (etuxpt_parse_sched_prio(optarg, &prio)) {
+				etuxpt_poll_usage(stderr);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'h': /* Help message. */
+			etuxpt_poll_usage(stdout);
+			exit(EXIT_SUCCESS);
+
+		case '?': /* Unknown option. */
+		default:
+			etuxpt_poll_usage(stderr);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (optind != argc) {
+		etuxpt_err("invalid number of arguments.\n");
+		etuxpt_poll_usage(stderr);
+		return EXIT_FAILURE;
+	}
+
+	/* Server thread inherits scheduling policy and priority. */
+	ret = etuxpt_setup_sched_prio(prio);
+	if (ret)
+		return ret;
+
+	return etuxpt_poll_run((unsigned int)reqs, budget, delay);
+}
@@ -0,0 +1,1811 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Utils.
+ * Copyright (C) 2017-2024 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "utils/poll.h"
+#include "utest.h"
+#include <dlfcn.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+struct utilsut_upoll_worker {
+	struct upoll_worker work;
+	unsigned int        count;
+	uint32_t            events;
+};
+
+static struct upoll utilsut_upoll;
+
+static int
+utilsut_upoll_dispatch(struct upoll_worker * worker,
+                       uint32_t              events,
+                       const struct upoll *  poller __unused)
+{
+	struct utilsut_upoll_worker * wk =
+		containerof(worker, struct utilsut_upoll_worker, work);
+
+	wk->count++;
+	wk->events |= events;
+
+	return 0;
+}
+
+static void
+utilsut_upoll_kick(int fd)
+{
+	const uint64_t one = 1;
+
+	cute_check_sint(write(fd, &one, sizeof(one)), equal, sizeof(one));
+}
+
+static void
+utilsut_upoll_drain(int fd)
+{
+	uint64_t cnt;
+
+	cute_check_sint(read(fd, &cnt, sizeof(cnt)), equal, sizeof(cnt));
+}
+
+static int          utilsut_upoll_mod_fd = -1;
+static unsigned int utilsut_upoll_mod_cnt;
+
+/*
+ * Override glibc's epoll_ctl() to count watch set modifications applied to
+ * the kernel for a given file descriptor.
+ */
+int
+epoll_ctl(int epfd, int op, int fd, struct epoll_event * event)
+{
+	static int (* ctl)(int, int, int, struct epoll_event *);
+
+	if (!ctl)
+		ctl = (int (*)(int, int, int, struct epoll_event *))
+		      dlsym(RTLD_NEXT, "epoll_ctl");
+
+	if ((op == EPOLL_CTL_MOD) && (fd == utilsut_upoll_mod_fd))
+		utilsut_upoll_mod_cnt++;
+
+	return ctl(epfd, op, fd, event);
+}
+
+static struct utilsut_upoll_worker utilsut_upoll_target;
+
+static int
+utilsut_upoll_dispatch_apply(struct upoll_worker * worker,
+                             uint32_t              events,
+                             const struct upoll *  poller)
+{
+	struct upoll_worker * tgt = &utilsut_upoll_target.work;
+
+	/* Successive modifications must be coalesced into the last one. */
+	upoll_setup_watch(tgt, EPOLLOUT);
+	upoll_apply(poller, tgt->fd, tgt);
+	upoll_disable_watch(tgt, EPOLLOUT);
+	upoll_apply(poller, tgt->fd, tgt);
+	upoll_setup_watch(tgt, EPOLLIN | EPOLLOUT);
+	upoll_apply(poller, tgt->fd, tgt);
+
+	return utilsut_upoll_dispatch(worker, events, poller);
+}
+
+static int utilsut_upoll_sks[2] = { -1, -1 };
+
+static void
+utilsut_upoll_setup_epoll(void)
+{
+	cute_check_sint(upoll_open(&utilsut_upoll, 4), equal, 0);
+	cute_check_sint(socketpair(AF_UNIX,
+	                           SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+	                           0,
+	                           utilsut_upoll_sks),
+	                equal,
+	                0);
+}
+
+static void
+utilsut_upoll_teardown_epoll(void)
+{
+	close(utilsut_upoll_sks[0]);
+	close(utilsut_upoll_sks[1]);
+	upoll_close(&utilsut_upoll);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_coalesce,
+                 utilsut_upoll_setup_epoll,
+                 utilsut_upoll_teardown_epoll,
+                 CUTE_DFLT_TMOUT)
+{
+	struct utilsut_upoll_worker wk = { .count = 0, .events = 0 };
+	int                         fd;
+
+	utilsut_upoll_target.count = 0;
+	utilsut_upoll_target.events = 0;
+
+	fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	cute_check_sint(fd, greater_equal, 0);
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        fd,
+	                                        EPOLLIN,
+	                                        &wk.work,
+	                                        utilsut_upoll_dispatch_apply),
+	                equal,
+	                0);
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        utilsut_upoll_sks[0],
+	                                        EPOLLIN,
+	                                        &utilsut_upoll_target.work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+
+	utilsut_upoll_mod_fd = utilsut_upoll_sks[0];
+	utilsut_upoll_mod_cnt = 0;
+
+	/* Modifications are journaled during the dispatch pass... */
+	utilsut_upoll_kick(fd);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(wk.count, equal, 1);
+	cute_check_uint(utilsut_upoll_mod_cnt, equal, 0);
+	utilsut_upoll_drain(fd);
+
+	/* ...and applied at once, using the last watch set, at next wait. */
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(utilsut_upoll_mod_cnt, equal, 1);
+	cute_check_uint(utilsut_upoll_target.count, equal, 1);
+	cute_check_uint(utilsut_upoll_target.events, equal, EPOLLOUT);
+	cute_check_uint(wk.count, equal, 1);
+
+	utilsut_upoll_mod_fd = -1;
+
+	upoll_unregister(&utilsut_upoll, utilsut_upoll_sks[0]);
+	upoll_unregister(&utilsut_upoll, fd);
+	close(fd);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_unregister_ready,
+                 utilsut_upoll_setup_epoll,
+                 utilsut_upoll_teardown_epoll,
+                 CUTE_DFLT_TMOUT)
+{
+	struct utilsut_upoll_worker wk[2] = {
+		{ .count = 0, .events = 0 },
+		{ .count = 0, .events = 0 }
+	};
+	unsigned int                w;
+
+	/* Dispatch a single worker per pass. */
+	cute_check_sint(upoll_setup_ring(&utilsut_upoll, 1), equal, 0);
+
+	for (w = 0; w < stroll_array_nr(wk); w++)
+		cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+		                                        utilsut_upoll_sks[w],
+		                                        EPOLLOUT,
+		                                        &wk[w].work,
+		                                        utilsut_upoll_dispatch),
+		                equal,
+		                0);
+
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(wk[0].count + wk[1].count, equal, 1);
+
+	/* Unregistering drops the worker still queued for dispatch. */
+	w = wk[0].count ? 1 : 0;
+	upoll_unregister(&utilsut_upoll, utilsut_upoll_sks[w]);
+	upoll_unregister(&utilsut_upoll, utilsut_upoll_sks[!w]);
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+	cute_check_uint(wk[w].count, equal, 0);
+	cute_check_uint(wk[!w].count, equal, 1);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_unregister_oneshot,
+                 utilsut_upoll_setup_epoll,
+                 utilsut_upoll_teardown_epoll,
+                 CUTE_DFLT_TMOUT)
+{
+	struct utilsut_upoll_worker wk = { .count = 0, .events = 0 };
+
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        utilsut_upoll_sks[0],
+	                                        EPOLLOUT | EPOLLONESHOT,
+	                                        &wk.work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(wk.count, equal, 1);
+
+	/*
+	 * Unregistering cancels re-arming journaled by the dispatch pass: next
+	 * wait must not try to modify a file descriptor no longer registered.
+	 */
+	upoll_unregister(&utilsut_upoll, utilsut_upoll_sks[0]);
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+	cute_check_uint(wk.count, equal, 1);
+}
+
+static int
+utilsut_upoll_dispatch_disarm(struct upoll_worker * worker,
+                              uint32_t              events,
+                              const struct upoll *  poller)
+{
+	/* Stop watching: oneshot worker must be kept disabled. */
+	upoll_disable_watch(worker, EPOLLIN);
+	upoll_apply(poller, worker->fd, worker);
+
+	return utilsut_upoll_dispatch(worker, events, poller);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_oneshot_rearm,
+                 utilsut_upoll_setup_epoll,
+                 utilsut_upoll_teardown_epoll,
+                 CUTE_DFLT_TMOUT)
+{
+	struct utilsut_upoll_worker wk = { .count = 0, .events = 0 };
+
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        utilsut_upoll_sks[0],
+	                                        EPOLLIN | EPOLLONESHOT,
+	                                        &wk.work,
+	                                        utilsut_upoll_dispatch_disarm),
+	                equal,
+	                0);
+	utilsut_upoll_mod_fd = utilsut_upoll_sks[0];
+	utilsut_upoll_mod_cnt = 0;
+
+	/* Data is left unread: worker would be re-dispatched if armed. */
+	cute_check_sint(write(utilsut_upoll_sks[1], "x", 1), equal, 1);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(wk.count, equal, 1);
+	cute_check_uint(wk.events, equal, EPOLLIN);
+
+	/* Disarmed by the kernel and kept so without any system call... */
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+	cute_check_uint(wk.count, equal, 1);
+	cute_check_uint(utilsut_upoll_mod_cnt, equal, 0);
+
+	/* ...till re-armed by upoll_apply(). */
+	upoll_enable_watch(&wk.work, EPOLLIN);
+	upoll_apply(&utilsut_upoll, utilsut_upoll_sks[0], &wk.work);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(utilsut_upoll_mod_cnt, equal, 1);
+	cute_check_uint(wk.count, equal, 2);
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+	cute_check_uint(wk.count, equal, 2);
+
+	utilsut_upoll_mod_fd = -1;
+
+	upoll_unregister(&utilsut_upoll, utilsut_upoll_sks[0]);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_edge,
+                 utilsut_upoll_setup_epoll,
+                 utilsut_upoll_teardown_epoll,
+                 CUTE_DFLT_TMOUT)
+{
+	struct utilsut_upoll_worker wk = { .count = 0, .events = 0 };
+
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        utilsut_upoll_sks[0],
+	                                        EPOLLIN | EPOLLET,
+	                                        &wk.work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+
+	cute_check_sint(write(utilsut_upoll_sks[1], "x", 1), equal, 1);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(wk.count, equal, 1);
+
+	/* Data left unread is not reported again... */
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+	cute_check_uint(wk.count, equal, 1);
+
+	/* ...till new input comes in. */
+	cute_check_sint(write(utilsut_upoll_sks[1], "x", 1), equal, 1);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(wk.count, equal, 2);
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+	cute_check_uint(wk.count, equal, 2);
+
+	upoll_unregister(&utilsut_upoll, utilsut_upoll_sks[0]);
+}
+
+#if defined(CONFIG_UTILS_ASSERT_API)
+
+CUTE_TEST_STATIC(utilsut_upoll_exclusive_assert,
+                 utilsut_upoll_setup_epoll,
+                 utilsut_upoll_teardown_epoll,
+                 CUTE_DFLT_TMOUT)
+{
+	struct utilsut_upoll_worker wk = { .count = 0, .events = 0 };
+
+	/* EPOLLEXCLUSIVE may only be combined with EPOLLIN, EPOLLOUT and ET. */
+	wk.work.dispatch = utilsut_upoll_dispatch;
+	cute_expect_assertion(
+		upoll_register(&utilsut_upoll,
+		               utilsut_upoll_sks[0],
+		               EPOLLIN | EPOLLRDHUP | EPOLLEXCLUSIVE,
+		               &wk.work));
+
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        utilsut_upoll_sks[0],
+	                                        EPOLLIN | EPOLLEXCLUSIVE,
+	                                        &wk.work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+
+	/*
+	 * The kernel rejects modifications of exclusive workers with EINVAL:
+	 * these are caught before reaching it.
+	 */
+	upoll_enable_watch(&wk.work, EPOLLOUT);
+	cute_expect_assertion(upoll_apply(&utilsut_upoll,
+	                                  utilsut_upoll_sks[0],
+	                                  &wk.work));
+	upoll_disable_watch(&wk.work, EPOLLOUT);
+
+	/* Worker is left untouched. */
+	cute_check_sint(write(utilsut_upoll_sks[1], "x", 1), equal, 1);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(wk.count, equal, 1);
+	cute_check_uint(wk.events, equal, EPOLLIN);
+
+	upoll_unregister(&utilsut_upoll, utilsut_upoll_sks[0]);
+}
+
+#else  /* !defined(CONFIG_UTILS_ASSERT_API) */
+
+UTILSUT_NOASSERT_TEST(utilsut_upoll_exclusive_assert)
+
+#endif /* defined(CONFIG_UTILS_ASSERT_API) */
+
+static struct utilsut_upoll_worker   utilsut_upoll_ring_wks[4];
+static int                           utilsut_upoll_ring_fds[4];
+static struct utilsut_upoll_worker * utilsut_upoll_ring_order[4];
+static unsigned int                  utilsut_upoll_ring_cnt;
+
+#define UTILSUT_UPOLL_RING_NR \
+	((unsigned int)stroll_array_nr(utilsut_upoll_ring_wks))
+
+static int
+utilsut_upoll_dispatch_ring(struct upoll_worker * worker,
+                            uint32_t              events,
+                            const struct upoll *  poller)
+{
+	struct utilsut_upoll_worker * wk =
+		containerof(worker, struct utilsut_upoll_worker, work);
+
+	if (utilsut_upoll_ring_cnt < UTILSUT_UPOLL_RING_NR)
+		utilsut_upoll_ring_order[utilsut_upoll_ring_cnt] = wk;
+	utilsut_upoll_ring_cnt++;
+
+	return utilsut_upoll_dispatch(worker, events, poller);
+}
+
+/*
+ * Open a poller with dispatch ring enabled and register a level-triggered
+ * worker per eventfd, all of them left ready once kicked.
+ */
+static void
+utilsut_upoll_open_ring(unsigned int budget)
+{
+	unsigned int w;
+
+	cute_check_sint(upoll_open(&utilsut_upoll, UTILSUT_UPOLL_RING_NR),
+	                equal,
+	                0);
+	cute_check_sint(upoll_setup_ring(&utilsut_upoll, budget), equal, 0);
+
+	for (w = 0; w < UTILSUT_UPOLL_RING_NR; w++) {
+		struct utilsut_upoll_worker * wk = &utilsut_upoll_ring_wks[w];
+
+		wk->count = 0;
+		wk->events = 0;
+		utilsut_upoll_ring_fds[w] = eventfd(0,
+		                                    EFD_NONBLOCK | EFD_CLOEXEC);
+		cute_check_sint(utilsut_upoll_ring_fds[w], greater_equal, 0);
+		cute_check_sint(
+			upoll_register_dispatch(&utilsut_upoll,
+			                        utilsut_upoll_ring_fds[w],
+			                        EPOLLIN,
+			                        &wk->work,
+			                        utilsut_upoll_dispatch_ring),
+			equal,
+			0);
+	}
+
+	utilsut_upoll_ring_cnt = 0;
+}
+
+static void
+utilsut_upoll_close_ring(void)
+{
+	unsigned int w;
+
+	for (w = 0; w < UTILSUT_UPOLL_RING_NR; w++) {
+		upoll_unregister(&utilsut_upoll, utilsut_upoll_ring_fds[w]);
+		close(utilsut_upoll_ring_fds[w]);
+	}
+
+	upoll_close(&utilsut_upoll);
+}
+
+CUTE_TEST(utilsut_upoll_ring_prio)
+{
+	unsigned int w;
+
+	utilsut_upoll_open_ring(0);
+
+	/* Register workers in reverse priority order. */
+	for (w = 0; w < UTILSUT_UPOLL_RING_NR; w++) {
+		upoll_setup_prio(&utilsut_upoll_ring_wks[w].work,
+		                 UTILSUT_UPOLL_RING_NR - 1 - w);
+		utilsut_upoll_kick(utilsut_upoll_ring_fds[w]);
+	}
+
+	/* Higher priority workers are dispatched first. */
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(utilsut_upoll_ring_cnt, equal, UTILSUT_UPOLL_RING_NR);
+	for (w = 0; w < UTILSUT_UPOLL_RING_NR; w++)
+		cute_check_ptr(utilsut_upoll_ring_order[w],
+		               equal,
+		               &utilsut_upoll_ring_wks[UTILSUT_UPOLL_RING_NR -
+		                                       1 - w]);
+
+	utilsut_upoll_close_ring();
+}
+
+CUTE_TEST(utilsut_upoll_ring_budget)
+{
+	unsigned int w;
+
+	utilsut_upoll_open_ring(UTILSUT_UPOLL_RING_NR - 1);
+
+	for (w = 0; w < UTILSUT_UPOLL_RING_NR; w++)
+		utilsut_upoll_kick(utilsut_upoll_ring_fds[w]);
+
+	/* Budget limits the number of workers dispatched per pass... */
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(utilsut_upoll_ring_cnt,
+	                equal,
+	                UTILSUT_UPOLL_RING_NR - 1);
+	for (w = 0; w < UTILSUT_UPOLL_RING_NR; w++)
+		utilsut_upoll_drain(utilsut_upoll_ring_fds[w]);
+
+	/*
+	 * ...and workers left over are dispatched by next pass without blocking
+	 * although their events have been consumed in the meantime.
+	 */
+	cute_check_sint(upoll_process(&utilsut_upoll, -1), equal, 0);
+	cute_check_uint(utilsut_upoll_ring_cnt, equal, UTILSUT_UPOLL_RING_NR);
+	for (w = 0; w < UTILSUT_UPOLL_RING_NR; w++)
+		cute_check_uint(utilsut_upoll_ring_wks[w].count, equal, 1);
+
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+	cute_check_uint(utilsut_upoll_ring_cnt, equal, UTILSUT_UPOLL_RING_NR);
+
+	utilsut_upoll_close_ring();
+}
+
+CUTE_TEST(utilsut_upoll_ring_reprio)
+{
+	struct utilsut_upoll_worker * first;
+	unsigned int                  w;
+
+	/* Dispatch a single worker per pass. */
+	utilsut_upoll_open_ring(1);
+
+	for (w = 0; w < UTILSUT_UPOLL_RING_NR; w++)
+		utilsut_upoll_kick(utilsut_upoll_ring_fds[w]);
+
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(utilsut_upoll_ring_cnt, equal, 1);
+	first = utilsut_upoll_ring_order[0];
+
+	/*
+	 * Raising the priority of the worker just dispatched while others are
+	 * still queued applies as soon as it is collected again, i.e. it
+	 * overtakes workers queued before it.
+	 */
+	upoll_setup_prio(&first->work, 0);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(utilsut_upoll_ring_cnt, equal, 2);
+	cute_check_ptr(utilsut_upoll_ring_order[1], equal, first);
+	cute_check_uint(first->count, equal, 2);
+
+	/* Lowering it back lets queued workers go first. */
+	upoll_setup_prio(&first->work, UPOLL_PRIO_NR - 1);
+	for (w = 2; w < UTILSUT_UPOLL_RING_NR; w++) {
+		cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+		cute_check_ptr(utilsut_upoll_ring_order[w], unequal, first);
+	}
+	cute_check_uint(first->count, equal, 2);
+
+	utilsut_upoll_close_ring();
+}
+
+#if defined(CONFIG_UTILS_POLL_BATCH)
+
+CUTE_TEST(utilsut_upoll_batch)
+{
+	struct utilsut_upoll_worker wk[8];
+	int                         fd[stroll_array_nr(wk)];
+	unsigned long               waits;
+	unsigned long               saturated;
+	unsigned int                w;
+	unsigned int                n;
+
+	cute_check_sint(upoll_open(&utilsut_upoll, 2), equal, 0);
+	cute_check_sint(upoll_setup_batch(&utilsut_upoll, 16), equal, 0);
+	cute_check_uint(upoll_get_batch_size(&utilsut_upoll), equal, 2);
+
+	for (w = 0; w < stroll_array_nr(wk); w++) {
+		wk[w].count = 0;
+		wk[w].events = 0;
+		fd[w] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		cute_check_sint(fd[w], greater_equal, 0);
+		cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+		                                        fd[w],
+		                                        EPOLLIN,
+		                                        &wk[w].work,
+		                                        utilsut_upoll_dispatch),
+		                equal,
+		                0);
+		utilsut_upoll_kick(fd[w]);
+	}
+
+	/* Batch doubles each time it is saturated, up to maximum size... */
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, 0);
+	cute_check_uint(upoll_get_batch_size(&utilsut_upoll), equal, 4);
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, 0);
+	cute_check_uint(upoll_get_batch_size(&utilsut_upoll), equal, 8);
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, 0);
+	cute_check_uint(upoll_get_batch_size(&utilsut_upoll), equal, 16);
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, 0);
+	cute_check_uint(upoll_get_batch_size(&utilsut_upoll), equal, 16);
+
+	upoll_get_batch_stats(&utilsut_upoll, &waits, &saturated);
+	cute_check_uint(waits, equal, 4);
+	cute_check_uint(saturated, equal, 3);
+
+	/* ...and is halved down to initial size while mostly unused. */
+	for (w = 0; w < stroll_array_nr(wk); w++)
+		utilsut_upoll_drain(fd[w]);
+	for (n = 0; n < 64 * 4; n++)
+		cute_check_sint(upoll_process(&utilsut_upoll, 0),
+		                equal,
+		                -ETIME);
+	cute_check_uint(upoll_get_batch_size(&utilsut_upoll), equal, 2);
+
+	upoll_get_batch_stats(&utilsut_upoll, &waits, &saturated);
+	cute_check_uint(waits, equal, 4 + (64 * 4));
+	cute_check_uint(saturated, equal, 3);
+
+	for (w = 0; w < stroll_array_nr(wk); w++) {
+		upoll_unregister(&utilsut_upoll, fd[w]);
+		close(fd[w]);
+	}
+	upoll_close(&utilsut_upoll);
+}
+
+#endif /* defined(CONFIG_UTILS_POLL_BATCH) */
+
+#if defined(CONFIG_UTILS_POLL_TASK)
+
+#include <pthread.h>
+
+#define UTILSUT_UPOLL_PROD_NR (4U)
+#define UTILSUT_UPOLL_TASK_NR (2048U)
+
+struct utilsut_upoll_task {
+	struct upoll_task task;
+	unsigned int      prod;
+	unsigned int      seq;
+};
+
+struct utilsut_upoll_prod {
+	pthread_t                 thr;
+	struct utilsut_upoll_task tasks[UTILSUT_UPOLL_TASK_NR];
+	unsigned int              next;
+};
+
+static struct utilsut_upoll_prod utilsut_upoll_prods[UTILSUT_UPOLL_PROD_NR];
+static unsigned int              utilsut_upoll_task_cnt;
+static bool                      utilsut_upoll_task_order;
+
+static void
+utilsut_upoll_run_task(void * arg, const struct upoll * poller __unused)
+{
+	const struct utilsut_upoll_task * tsk = arg;
+	struct utilsut_upoll_prod *       prod = &utilsut_upoll_prods[tsk->prod];
+
+	/* Tasks of a given producer must run in posting order. */
+	if (tsk->seq != prod->next)
+		utilsut_upoll_task_order = false;
+	prod->next = tsk->seq + 1;
+
+	utilsut_upoll_task_cnt++;
+}
+
+static void *
+utilsut_upoll_produce(void * arg)
+{
+	struct utilsut_upoll_prod * prod = arg;
+	unsigned int                t;
+
+	for (t = 0; t < UTILSUT_UPOLL_TASK_NR; t++)
+		upoll_post(&utilsut_upoll, &prod->tasks[t].task);
+
+	return NULL;
+}
+
+CUTE_TEST(utilsut_upoll_task_mpsc)
+{
+	unsigned int p;
+	unsigned int t;
+
+	cute_check_sint(upoll_open(&utilsut_upoll, 4), equal, 0);
+	cute_check_sint(upoll_setup_tasks(&utilsut_upoll), equal, 0);
+
+	utilsut_upoll_task_cnt = 0;
+	utilsut_upoll_task_order = true;
+	for (p = 0; p < UTILSUT_UPOLL_PROD_NR; p++) {
+		struct utilsut_upoll_prod * prod = &utilsut_upoll_prods[p];
+
+		prod->next = 0;
+		for (t = 0; t < UTILSUT_UPOLL_TASK_NR; t++) {
+			prod->tasks[t].prod = p;
+			prod->tasks[t].seq = t;
+			upoll_init_task(&prod->tasks[t].task,
+			                utilsut_upoll_run_task,
+			                &prod->tasks[t]);
+		}
+	}
+
+	for (p = 0; p < UTILSUT_UPOLL_PROD_NR; p++)
+		cute_check_sint(pthread_create(&utilsut_upoll_prods[p].thr,
+		                               NULL,
+		                               utilsut_upoll_produce,
+		                               &utilsut_upoll_prods[p]),
+		                equal,
+		                0);
+
+	/* Run tasks while producers are posting. */
+	while (utilsut_upoll_task_cnt <
+	       (UTILSUT_UPOLL_PROD_NR * UTILSUT_UPOLL_TASK_NR))
+		cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+
+	for (p = 0; p < UTILSUT_UPOLL_PROD_NR; p++) {
+		pthread_join(utilsut_upoll_prods[p].thr, NULL);
+		cute_check_uint(utilsut_upoll_prods[p].next,
+		                equal,
+		                UTILSUT_UPOLL_TASK_NR);
+	}
+
+	cute_check_bool(utilsut_upoll_task_order, is, true);
+	cute_check_uint(utilsut_upoll_task_cnt,
+	                equal,
+	                UTILSUT_UPOLL_PROD_NR * UTILSUT_UPOLL_TASK_NR);
+
+	/* No task may be left. */
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+	cute_check_uint(utilsut_upoll_task_cnt,
+	                equal,
+	                UTILSUT_UPOLL_PROD_NR * UTILSUT_UPOLL_TASK_NR);
+
+	upoll_close(&utilsut_upoll);
+}
+
+#endif /* defined(CONFIG_UTILS_POLL_TASK) */
+
+#if defined(CONFIG_UTILS_POLL_BUSY)
+
+static int          utilsut_upoll_busy_fd = -1;
+static unsigned int utilsut_upoll_busy_intr;
+
+/*
+ * Override glibc's epoll_wait() to make the given number of non blocking calls
+ * fail as if interrupted by a signal.
+ */
+int
+epoll_wait(int epfd, struct epoll_event * events, int maxevents, int tmout)
+{
+	static int (* wait)(int, struct epoll_event *, int, int);
+
+	if (!wait)
+		wait = (int (*)(int, struct epoll_event *, int, int))
+		       dlsym(RTLD_NEXT, "epoll_wait");
+
+	if (!tmout && utilsut_upoll_busy_intr) {
+		utilsut_upoll_busy_intr--;
+		errno = EINTR;
+		return -1;
+	}
+
+	return wait(epfd, events, maxevents, tmout);
+}
+
+static void
+utilsut_upoll_setup_busy(void)
+{
+	cute_check_sint(upoll_open(&utilsut_upoll, 4), equal, 0);
+	utilsut_upoll_busy_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	cute_check_sint(utilsut_upoll_busy_fd, greater_equal, 0);
+}
+
+static void
+utilsut_upoll_teardown_busy(void)
+{
+	close(utilsut_upoll_busy_fd);
+	utilsut_upoll_busy_fd = -1;
+	upoll_close(&utilsut_upoll);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_busy_steady,
+                 utilsut_upoll_setup_busy,
+                 utilsut_upoll_teardown_busy,
+                 CUTE_DFLT_TMOUT)
+{
+	struct utilsut_upoll_worker wk = { .count = 0, .events = 0 };
+	unsigned long               hits;
+	unsigned long               misses;
+	unsigned int                n;
+
+	/* 50 milliseconds spin budget. */
+	cute_check_sint(upoll_setup_busy(&utilsut_upoll, 50000000UL, 0),
+	                equal,
+	                0);
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        utilsut_upoll_busy_fd,
+	                                        EPOLLIN,
+	                                        &wk.work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+
+	/* Events available at wait time are caught while spinning. */
+	for (n = 0; n < 16; n++) {
+		utilsut_upoll_kick(utilsut_upoll_busy_fd);
+		cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+		utilsut_upoll_drain(utilsut_upoll_busy_fd);
+	}
+
+	cute_check_uint(wk.count, equal, 16);
+	upoll_get_busy_stats(&utilsut_upoll, &hits, &misses);
+	cute_check_uint(hits, equal, 16);
+	cute_check_uint(misses, equal, 0);
+
+	upoll_unregister(&utilsut_upoll, utilsut_upoll_busy_fd);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_busy_sparse,
+                 utilsut_upoll_setup_busy,
+                 utilsut_upoll_teardown_busy,
+                 CUTE_DFLT_TMOUT)
+{
+	struct utilsut_upoll_worker wk = { .count = 0, .events = 0 };
+	unsigned long               hits;
+	unsigned long               misses;
+	unsigned int                n;
+
+	/* 1 millisecond spin budget. */
+	cute_check_sint(upoll_setup_busy(&utilsut_upoll, 1000000UL, 0),
+	                equal,
+	                0);
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        utilsut_upoll_busy_fd,
+	                                        EPOLLIN,
+	                                        &wk.work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+
+	/*
+	 * First wait spins over the whole budget in vain. Waiting 10
+	 * milliseconds exceeds the budget: spinning is then disabled.
+	 */
+	for (n = 0; n < 4; n++)
+		cute_check_sint(upoll_process(&utilsut_upoll, 10),
+		                equal,
+		                -ETIME);
+
+	upoll_get_busy_stats(&utilsut_upoll, &hits, &misses);
+	cute_check_uint(hits, equal, 0);
+	cute_check_uint(misses, equal, 1);
+
+	/* Spinning resumes once traffic becomes steady again. */
+	for (n = 0; n < 64; n++) {
+		utilsut_upoll_kick(utilsut_upoll_busy_fd);
+		cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+		utilsut_upoll_drain(utilsut_upoll_busy_fd);
+	}
+
+	cute_check_uint(wk.count, equal, 64);
+	upoll_get_busy_stats(&utilsut_upoll, &hits, &misses);
+	cute_check_uint(hits, greater, 0);
+	cute_check_uint(misses, equal, 1);
+
+	upoll_unregister(&utilsut_upoll, utilsut_upoll_busy_fd);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_busy_error,
+                 utilsut_upoll_setup_busy,
+                 utilsut_upoll_teardown_busy,
+                 CUTE_DFLT_TMOUT)
+{
+	struct utilsut_upoll_worker wk = { .count = 0, .events = 0 };
+	unsigned long               hits;
+	unsigned long               misses;
+	unsigned int                n;
+
+	/* 50 milliseconds spin budget. */
+	cute_check_sint(upoll_setup_busy(&utilsut_upoll, 50000000UL, 0),
+	                equal,
+	                0);
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        utilsut_upoll_busy_fd,
+	                                        EPOLLIN,
+	                                        &wk.work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+
+	for (n = 0; n < 4; n++) {
+		utilsut_upoll_kick(utilsut_upoll_busy_fd);
+		cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+		utilsut_upoll_drain(utilsut_upoll_busy_fd);
+	}
+
+	/*
+	 * Errors met while spinning are returned right away and counted
+	 * neither as hits nor as misses.
+	 */
+	utilsut_upoll_kick(utilsut_upoll_busy_fd);
+	utilsut_upoll_busy_intr = 1;
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, -EINTR);
+	cute_check_uint(wk.count, equal, 4);
+	upoll_get_busy_stats(&utilsut_upoll, &hits, &misses);
+	cute_check_uint(hits, equal, 4);
+	cute_check_uint(misses, equal, 0);
+
+	/* Event is still caught by next spin phase. */
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(wk.count, equal, 5);
+	upoll_get_busy_stats(&utilsut_upoll, &hits, &misses);
+	cute_check_uint(hits, equal, 5);
+	cute_check_uint(misses, equal, 0);
+
+	utilsut_upoll_drain(utilsut_upoll_busy_fd);
+	upoll_unregister(&utilsut_upoll, utilsut_upoll_busy_fd);
+}
+
+#if defined(CONFIG_UTILS_POLL_URING)
+
+CUTE_TEST(utilsut_upoll_busy_uring)
+{
+	cute_check_sint(upoll_open(&utilsut_upoll, 4), equal, 0);
+	if (upoll_setup_uring(&utilsut_upoll, 8)) {
+		upoll_close(&utilsut_upoll);
+		cute_skip("io_uring not supported");
+	}
+
+	/* Kernel side busy polling requires the epoll backend. */
+	cute_check_sint(upoll_setup_busy(&utilsut_upoll, 1000000UL, 50),
+	                equal,
+	                -EOPNOTSUPP);
+
+	upoll_close(&utilsut_upoll);
+}
+
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+
+#endif /* defined(CONFIG_UTILS_POLL_BUSY) */
+
+#if defined(CONFIG_UTILS_POLL_URING)
+
+#include <stdarg.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+
+static volatile bool utilsut_upoll_uring_nosys;
+static volatile bool utilsut_upoll_uring_busy;
+
+/*
+ * Override glibc's syscall() so that io_uring may be reported as unsupported
+ * by the running kernel and submissions may be refused.
+ */
+long
+syscall(long nr, ...)
+{
+	static long (* sys)(long, ...);
+	va_list        args;
+	long           arg[6];
+	unsigned int   a;
+
+	if (utilsut_upoll_uring_nosys && (nr == __NR_io_uring_setup)) {
+		errno = ENOSYS;
+		return -1;
+	}
+
+	if (!sys)
+		sys = (long (*)(long, ...))dlsym(RTLD_NEXT, "syscall");
+
+	va_start(args, nr);
+	for (a = 0; a < stroll_array_nr(arg); a++)
+		arg[a] = va_arg(args, long);
+	va_end(args);
+
+	if (utilsut_upoll_uring_busy &&
+	    (nr == __NR_io_uring_enter) &&
+	    arg[1]) {
+		errno = EBUSY;
+		return -1;
+	}
+
+	return sys(nr, arg[0], arg[1], arg[2], arg[3], arg[4], arg[5]);
+}
+
+static int utilsut_upoll_fd = -1;
+
+static void
+utilsut_upoll_setup_uring(void)
+{
+	int err;
+
+	cute_check_sint(upoll_open(&utilsut_upoll, 4), equal, 0);
+
+	err = upoll_setup_uring(&utilsut_upoll, 8);
+	if (err) {
+		cute_check_bool((err == -ENOSYS) ||
+		                (err == -EPERM) ||
+		                (err == -EOPNOTSUPP),
+		                is,
+		                true);
+		upoll_close(&utilsut_upoll);
+		cute_skip("io_uring not supported");
+	}
+
+	utilsut_upoll_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	cute_check_sint(utilsut_upoll_fd, greater_equal, 0);
+}
+
+static void
+utilsut_upoll_teardown_uring(void)
+{
+	close(utilsut_upoll_fd);
+	utilsut_upoll_fd = -1;
+	upoll_close(&utilsut_upoll);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_uring_register,
+                 utilsut_upoll_setup_uring,
+                 utilsut_upoll_teardown_uring,
+                 CUTE_DFLT_TMOUT)
+{
+	struct utilsut_upoll_worker lvl = { .count = 0, .events = 0 };
+	struct utilsut_upoll_worker edge = { .count = 0, .events = 0 };
+	int                         fd;
+
+	fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	cute_check_sint(fd, greater_equal, 0);
+
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        utilsut_upoll_fd,
+	                                        EPOLLIN,
+	                                        &lvl.work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        fd,
+	                                        EPOLLIN | EPOLLET,
+	                                        &edge.work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+
+	/* Level-triggered worker is notified till it is drained... */
+	utilsut_upoll_kick(utilsut_upoll_fd);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(lvl.count, equal, 1);
+	cute_check_uint(lvl.events, equal, EPOLLIN);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(lvl.count, equal, 2);
+	utilsut_upoll_drain(utilsut_upoll_fd);
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+	cute_check_uint(lvl.count, equal, 2);
+
+	/* ...whereas edge-triggered one is notified once per edge. */
+	utilsut_upoll_kick(fd);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(edge.count, equal, 1);
+	cute_check_uint(edge.events, equal, EPOLLIN);
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+	cute_check_uint(edge.count, equal, 1);
+	utilsut_upoll_kick(fd);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(edge.count, equal, 2);
+	cute_check_uint(lvl.count, equal, 2);
+
+	upoll_unregister(&utilsut_upoll, fd);
+	upoll_unregister(&utilsut_upoll, utilsut_upoll_fd);
+	close(fd);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_uring_modify,
+                 utilsut_upoll_setup_uring,
+                 utilsut_upoll_teardown_uring,
+                 CUTE_DFLT_TMOUT)
+{
+	struct utilsut_upoll_worker wk = { .count = 0, .events = 0 };
+	int                         sks[2];
+
+	cute_check_sint(socketpair(AF_UNIX,
+	                           SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+	                           0,
+	                           sks),
+	                equal,
+	                0);
+
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        sks[0],
+	                                        EPOLLIN,
+	                                        &wk.work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+
+	/* Running request is replaced by one watching the new event set. */
+	upoll_enable_watch(&wk.work, EPOLLOUT);
+	upoll_apply(&utilsut_upoll, sks[0], &wk.work);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(wk.count, equal, 1);
+	cute_check_uint(wk.events, equal, EPOLLOUT);
+
+	/* Completions of the replaced request must not be reported. */
+	upoll_setup_watch(&wk.work, EPOLLIN);
+	upoll_apply(&utilsut_upoll, sks[0], &wk.work);
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+	cute_check_uint(wk.count, equal, 1);
+
+	cute_check_sint(write(sks[1], "x", 1), equal, 1);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(wk.count, equal, 2);
+	cute_check_uint(wk.events, equal, EPOLLIN | EPOLLOUT);
+
+	upoll_unregister(&utilsut_upoll, sks[0]);
+	close(sks[0]);
+	close(sks[1]);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_uring_oneshot,
+                 utilsut_upoll_setup_uring,
+                 utilsut_upoll_teardown_uring,
+                 CUTE_DFLT_TMOUT)
+{
+	struct utilsut_upoll_worker wk = { .count = 0, .events = 0 };
+
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        utilsut_upoll_fd,
+	                                        EPOLLIN | EPOLLONESHOT,
+	                                        &wk.work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+
+	/* Worker is re-armed once dispatched. */
+	utilsut_upoll_kick(utilsut_upoll_fd);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(wk.count, equal, 1);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(wk.count, equal, 2);
+
+	/* Discarding it cancels re-arming... */
+	upoll_discard(&utilsut_upoll, &wk.work);
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+	cute_check_uint(wk.count, equal, 2);
+
+	/* ...till its watch set is explicitly applied again. */
+	upoll_apply(&utilsut_upoll, utilsut_upoll_fd, &wk.work);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(wk.count, equal, 3);
+
+	upoll_discard(&utilsut_upoll, &wk.work);
+	upoll_unregister(&utilsut_upoll, utilsut_upoll_fd);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_uring_cancel,
+                 utilsut_upoll_setup_uring,
+                 utilsut_upoll_teardown_uring,
+                 CUTE_DFLT_TMOUT)
+{
+	struct utilsut_upoll_worker wk = { .count = 0, .events = 0 };
+
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        utilsut_upoll_fd,
+	                                        EPOLLIN,
+	                                        &wk.work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+
+	/* Unregistered worker must not be notified anymore... */
+	upoll_unregister(&utilsut_upoll, utilsut_upoll_fd);
+	utilsut_upoll_kick(utilsut_upoll_fd);
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+	cute_check_uint(wk.count, equal, 0);
+
+	/* ...whereas a new registration of the same descriptor is. */
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        utilsut_upoll_fd,
+	                                        EPOLLIN,
+	                                        &wk.work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(wk.count, equal, 1);
+
+	/* Cancel a request queued but not yet submitted. */
+	utilsut_upoll_drain(utilsut_upoll_fd);
+	upoll_unregister(&utilsut_upoll, utilsut_upoll_fd);
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        utilsut_upoll_fd,
+	                                        EPOLLIN,
+	                                        &wk.work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+	upoll_unregister(&utilsut_upoll, utilsut_upoll_fd);
+	utilsut_upoll_kick(utilsut_upoll_fd);
+	cute_check_sint(upoll_process(&utilsut_upoll, 0), equal, -ETIME);
+	cute_check_uint(wk.count, equal, 1);
+}
+
+CUTE_TEST(utilsut_upoll_uring_full)
+{
+	struct utilsut_upoll_worker wk[3];
+	int                         fd[stroll_array_nr(wk)];
+	unsigned int                w;
+	unsigned int                loop;
+
+	cute_check_sint(upoll_open(&utilsut_upoll, stroll_array_nr(wk)),
+	                equal,
+	                0);
+
+	/*
+	 * Single entry submission queue so that requests queued past the first
+	 * one require a submission.
+	 */
+	if (upoll_setup_uring(&utilsut_upoll, 1)) {
+		upoll_close(&utilsut_upoll);
+		cute_skip("io_uring not supported");
+	}
+
+	for (w = 0; w < stroll_array_nr(wk); w++) {
+		wk[w].count = 0;
+		wk[w].events = 0;
+		fd[w] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		cute_check_sint(fd[w], greater_equal, 0);
+	}
+
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        fd[0],
+	                                        EPOLLIN,
+	                                        &wk[0].work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+
+	/* Submission fails: requests must be deferred instead of lost... */
+	utilsut_upoll_uring_busy = true;
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        fd[1],
+	                                        EPOLLIN,
+	                                        &wk[1].work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+	upoll_setup_watch(&wk[0].work, EPOLLIN);
+	upoll_apply(&utilsut_upoll, fd[0], &wk[0].work);
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        fd[2],
+	                                        EPOLLIN,
+	                                        &wk[2].work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+	upoll_unregister(&utilsut_upoll, fd[2]);
+	utilsut_upoll_uring_busy = false;
+
+	/* ...and queued at next wait. */
+	for (w = 0; w < stroll_array_nr(wk); w++)
+		utilsut_upoll_kick(fd[w]);
+	for (loop = 0; loop < 4; loop++) {
+		cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+		if (wk[0].count && wk[1].count)
+			break;
+	}
+	cute_check_uint(wk[0].count, greater_equal, 1);
+	cute_check_uint(wk[0].events, equal, EPOLLIN);
+	cute_check_uint(wk[1].count, greater_equal, 1);
+	cute_check_uint(wk[1].events, equal, EPOLLIN);
+	cute_check_uint(wk[2].count, equal, 0);
+
+	upoll_unregister(&utilsut_upoll, fd[0]);
+	upoll_unregister(&utilsut_upoll, fd[1]);
+	for (w = 0; w < stroll_array_nr(wk); w++)
+		close(fd[w]);
+	upoll_close(&utilsut_upoll);
+}
+
+CUTE_TEST(utilsut_upoll_uring_stale)
+{
+	struct utilsut_upoll_worker wk[2];
+	int                         fd[stroll_array_nr(wk)];
+	struct utilsut_upoll_worker tm = { .count = 0, .events = 0 };
+	const struct itimerspec     itspec = {
+		.it_interval = { 0, 0 },
+		.it_value    = { 0, 50000000L }
+	};
+	int                         tfd;
+	unsigned int                w;
+
+	/* Single event batch so that completions are left into the CQ. */
+	cute_check_sint(upoll_open(&utilsut_upoll, 1), equal, 0);
+	if (upoll_setup_uring(&utilsut_upoll, 8)) {
+		upoll_close(&utilsut_upoll);
+		cute_skip("io_uring not supported");
+	}
+
+	for (w = 0; w < stroll_array_nr(wk); w++) {
+		wk[w].count = 0;
+		wk[w].events = 0;
+		fd[w] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		cute_check_sint(fd[w], greater_equal, 0);
+		cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+		                                        fd[w],
+		                                        EPOLLIN,
+		                                        &wk[w].work,
+		                                        utilsut_upoll_dispatch),
+		                equal,
+		                0);
+		utilsut_upoll_kick(fd[w]);
+	}
+
+	cute_check_sint(upoll_wait(&utilsut_upoll, 10), equal, 1);
+	cute_check_sint(upoll_dispatch(&utilsut_upoll, 1), equal, 0);
+	cute_check_uint(wk[0].count + wk[1].count, equal, 1);
+
+	/*
+	 * Make completion of the worker left undispatched stale and let the
+	 * dispatched one idle.
+	 */
+	w = wk[0].count ? 0 : 1;
+	upoll_unregister(&utilsut_upoll, fd[!w]);
+	utilsut_upoll_drain(fd[w]);
+
+	tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	cute_check_sint(tfd, greater_equal, 0);
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        tfd,
+	                                        EPOLLIN,
+	                                        &tm.work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+
+	/*
+	 * Collecting stale completions only must not end an infinite wait,
+	 * i.e. upoll_process() must not return without anything to dispatch.
+	 */
+	cute_check_sint(timerfd_settime(tfd, 0, &itspec, NULL), equal, 0);
+	cute_check_sint(upoll_process(&utilsut_upoll, -1), equal, 0);
+	cute_check_uint(tm.count, equal, 1);
+	cute_check_uint(wk[w].count, equal, 1);
+	cute_check_uint(wk[!w].count, equal, 0);
+
+	upoll_unregister(&utilsut_upoll, tfd);
+	upoll_unregister(&utilsut_upoll, fd[w]);
+	close(tfd);
+	for (w = 0; w < stroll_array_nr(wk); w++)
+		close(fd[w]);
+	upoll_close(&utilsut_upoll);
+}
+
+CUTE_TEST(utilsut_upoll_uring_fallback)
+{
+	struct utilsut_upoll_worker wk = { .count = 0, .events = 0 };
+	int                         fd;
+	int                         pfd;
+
+	fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	cute_check_sint(fd, greater_equal, 0);
+	cute_check_sint(upoll_open(&utilsut_upoll, 4), equal, 0);
+	pfd = upoll_get_fd(&utilsut_upoll);
+
+	utilsut_upoll_uring_nosys = true;
+	cute_check_sint(upoll_setup_uring(&utilsut_upoll, 8), equal, -ENOSYS);
+	utilsut_upoll_uring_nosys = false;
+
+	/* Poller keeps using its epoll set. */
+	cute_check_sint(upoll_get_fd(&utilsut_upoll), equal, pfd);
+	cute_check_sint(upoll_register_dispatch(&utilsut_upoll,
+	                                        fd,
+	                                        EPOLLIN,
+	                                        &wk.work,
+	                                        utilsut_upoll_dispatch),
+	                equal,
+	                0);
+	utilsut_upoll_kick(fd);
+	cute_check_sint(upoll_process(&utilsut_upoll, 1000), equal, 0);
+	cute_check_uint(wk.count, equal, 1);
+	cute_check_uint(wk.events, equal, EPOLLIN);
+
+	upoll_unregister(&utilsut_upoll, fd);
+	upoll_close(&utilsut_upoll);
+	close(fd);
+}
+
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+
+#if defined(CONFIG_UTILS_POLL_GROUP)
+
+#include "utils/atomic.h"
+
+#define UTILSUT_UPOLL_LOOP_NR (3U)
+#define UTILSUT_UPOLL_MEMB_NR (2U * UTILSUT_UPOLL_LOOP_NR)
+
+static struct upoll_group   utilsut_upoll_grp;
+static struct upoll_worker  utilsut_upoll_membs[UTILSUT_UPOLL_MEMB_NR];
+static int                  utilsut_upoll_memb_fds[UTILSUT_UPOLL_MEMB_NR];
+static unsigned int         utilsut_upoll_memb_cnt;
+static const struct upoll * utilsut_upoll_memb_poller;
+static int                  utilsut_upoll_memb_ret;
+static int                  utilsut_upoll_memb_to;
+static int                  utilsut_upoll_memb_err;
+
+/*
+ * Run by group loop threads: results are recorded for the main thread to check
+ * them once utilsut_upoll_memb_cnt has been updated.
+ */
+static int
+utilsut_upoll_dispatch_memb(struct upoll_worker * worker,
+                            uint32_t              events __unused,
+                            const struct upoll *  poller)
+{
+	int      fd = worker->fd;
+	uint64_t cnt;
+	int      ret = utilsut_upoll_memb_ret;
+
+	if (read(fd, &cnt, sizeof(cnt)) != sizeof(cnt))
+		ret = -EIO;
+
+	utilsut_upoll_memb_poller = poller;
+	if (utilsut_upoll_memb_to >= 0) {
+		unsigned int to = (unsigned int)utilsut_upoll_memb_to;
+
+		/* Worker MUST NOT be touched once handed off. */
+		utilsut_upoll_memb_to = -1;
+		utilsut_upoll_memb_err = upoll_group_handoff(&utilsut_upoll_grp,
+		                                             poller,
+		                                             to,
+		                                             fd,
+		                                             worker);
+	}
+
+	atomic_inc(&utilsut_upoll_memb_cnt);
+
+	return ret;
+}
+
+static void
+utilsut_upoll_wait_memb(unsigned int count)
+{
+	while (atomic_load(&utilsut_upoll_memb_cnt) < count)
+		usleep(1000);
+}
+
+static void
+utilsut_upoll_setup_group(void)
+{
+	unsigned int m;
+
+	for (m = 0; m < UTILSUT_UPOLL_MEMB_NR; m++) {
+		utilsut_upoll_memb_fds[m] = eventfd(0,
+		                                    EFD_NONBLOCK | EFD_CLOEXEC);
+		cute_check_sint(utilsut_upoll_memb_fds[m], greater_equal, 0);
+		utilsut_upoll_membs[m].dispatch = utilsut_upoll_dispatch_memb;
+	}
+
+	utilsut_upoll_memb_cnt = 0;
+	utilsut_upoll_memb_poller = NULL;
+	utilsut_upoll_memb_ret = 0;
+	utilsut_upoll_memb_to = -1;
+	utilsut_upoll_memb_err = 0;
+}
+
+static void
+utilsut_upoll_teardown_group(void)
+{
+	unsigned int m;
+
+	for (m = 0; m < UTILSUT_UPOLL_MEMB_NR; m++)
+		close(utilsut_upoll_memb_fds[m]);
+}
+
+static void
+utilsut_upoll_check_load(unsigned int l0, unsigned int l1, unsigned int l2)
+{
+	cute_check_uint(utilsut_upoll_grp.loops[0].load, equal, l0);
+	cute_check_uint(utilsut_upoll_grp.loops[1].load, equal, l1);
+	cute_check_uint(utilsut_upoll_grp.loops[2].load, equal, l2);
+}
+
+static void
+utilsut_upoll_unregister_memb(unsigned int memb, unsigned int loop)
+{
+	upoll_group_unregister(&utilsut_upoll_grp,
+	                       upoll_group_poller(&utilsut_upoll_grp, loop),
+	                       utilsut_upoll_memb_fds[memb],
+	                       &utilsut_upoll_membs[memb]);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_group_rr,
+                 utilsut_upoll_setup_group,
+                 utilsut_upoll_teardown_group,
+                 CUTE_DFLT_TMOUT)
+{
+	unsigned int m;
+
+	cute_check_sint(upoll_group_open(&utilsut_upoll_grp,
+	                                 UTILSUT_UPOLL_LOOP_NR,
+	                                 NULL,
+	                                 4,
+	                                 UPOLL_GROUP_RR_POLICY),
+	                equal,
+	                0);
+
+	/* Loops are selected in turn whatever their load. */
+	for (m = 0; m < UTILSUT_UPOLL_MEMB_NR; m++)
+		cute_check_sint(upoll_group_register(&utilsut_upoll_grp,
+		                                     utilsut_upoll_memb_fds[m],
+		                                     EPOLLIN,
+		                                     &utilsut_upoll_membs[m]),
+		                equal,
+		                (int)(m % UTILSUT_UPOLL_LOOP_NR));
+	utilsut_upoll_check_load(2, 2, 2);
+
+	utilsut_upoll_unregister_memb(0, 0);
+	utilsut_upoll_unregister_memb(3, 0);
+	utilsut_upoll_check_load(0, 2, 2);
+	cute_check_sint(upoll_group_register(&utilsut_upoll_grp,
+	                                     utilsut_upoll_memb_fds[0],
+	                                     EPOLLIN,
+	                                     &utilsut_upoll_membs[0]),
+	                equal,
+	                0);
+	cute_check_sint(upoll_group_register(&utilsut_upoll_grp,
+	                                     utilsut_upoll_memb_fds[3],
+	                                     EPOLLIN,
+	                                     &utilsut_upoll_membs[3]),
+	                equal,
+	                1);
+	utilsut_upoll_check_load(1, 3, 2);
+
+	for (m = 0; m < UTILSUT_UPOLL_MEMB_NR; m++)
+		utilsut_upoll_unregister_memb(m, (m != 3) ? m % 3 : 1);
+	utilsut_upoll_check_load(0, 0, 0);
+
+	upoll_group_close(&utilsut_upoll_grp);
+}
+
+static void
+utilsut_upoll_check_policy_load(void)
+{
+	unsigned int m;
+
+	/* Ties are broken in favour of the lowest loop index. */
+	for (m = 0; m < UTILSUT_UPOLL_LOOP_NR; m++)
+		cute_check_sint(upoll_group_register(&utilsut_upoll_grp,
+		                                     utilsut_upoll_memb_fds[m],
+		                                     EPOLLIN,
+		                                     &utilsut_upoll_membs[m]),
+		                equal,
+		                (int)m);
+	utilsut_upoll_check_load(1, 1, 1);
+
+	/* The least loaded loop is selected. */
+	utilsut_upoll_unregister_memb(1, 1);
+	utilsut_upoll_check_load(1, 0, 1);
+	cute_check_sint(upoll_group_register(&utilsut_upoll_grp,
+	                                     utilsut_upoll_memb_fds[3],
+	                                     EPOLLIN,
+	                                     &utilsut_upoll_membs[3]),
+	                equal,
+	                1);
+	cute_check_sint(upoll_group_register(&utilsut_upoll_grp,
+	                                     utilsut_upoll_memb_fds[4],
+	                                     EPOLLIN,
+	                                     &utilsut_upoll_membs[4]),
+	                equal,
+	                0);
+	utilsut_upoll_check_load(2, 1, 1);
+
+	utilsut_upoll_unregister_memb(0, 0);
+	utilsut_upoll_unregister_memb(2, 2);
+	utilsut_upoll_unregister_memb(3, 1);
+	utilsut_upoll_unregister_memb(4, 0);
+	utilsut_upoll_check_load(0, 0, 0);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_group_load,
+                 utilsut_upoll_setup_group,
+                 utilsut_upoll_teardown_group,
+                 CUTE_DFLT_TMOUT)
+{
+	cute_check_sint(upoll_group_open(&utilsut_upoll_grp,
+	                                 UTILSUT_UPOLL_LOOP_NR,
+	                                 NULL,
+	                                 4,
+	                                 UPOLL_GROUP_LOAD_POLICY),
+	                equal,
+	                0);
+
+	utilsut_upoll_check_policy_load();
+
+	upoll_group_close(&utilsut_upoll_grp);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_group_cpu,
+                 utilsut_upoll_setup_group,
+                 utilsut_upoll_teardown_group,
+                 CUTE_DFLT_TMOUT)
+{
+	cute_check_sint(upoll_group_open(&utilsut_upoll_grp,
+	                                 UTILSUT_UPOLL_LOOP_NR,
+	                                 NULL,
+	                                 4,
+	                                 UPOLL_GROUP_CPU_POLICY),
+	                equal,
+	                0);
+
+	/*
+	 * Eventfds carry no incoming CPU information: selection falls back to
+	 * the least loaded loop.
+	 */
+	utilsut_upoll_check_policy_load();
+
+	upoll_group_close(&utilsut_upoll_grp);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_group_start_stop,
+                 utilsut_upoll_setup_group,
+                 utilsut_upoll_teardown_group,
+                 CUTE_DFLT_TMOUT)
+{
+	unsigned int m;
+
+	cute_check_sint(upoll_group_open(&utilsut_upoll_grp,
+	                                 UTILSUT_UPOLL_LOOP_NR,
+	                                 NULL,
+	                                 4,
+	                                 UPOLL_GROUP_RR_POLICY),
+	                equal,
+	                0);
+	for (m = 0; m < UTILSUT_UPOLL_LOOP_NR; m++)
+		cute_check_sint(upoll_group_register(&utilsut_upoll_grp,
+		                                     utilsut_upoll_memb_fds[m],
+		                                     EPOLLIN,
+		                                     &utilsut_upoll_membs[m]),
+		                equal,
+		                (int)m);
+
+	/* Each loop dispatches its own worker. */
+	cute_check_sint(upoll_group_start(&utilsut_upoll_grp), equal, 0);
+	for (m = 0; m < UTILSUT_UPOLL_LOOP_NR; m++) {
+		utilsut_upoll_kick(utilsut_upoll_memb_fds[m]);
+		utilsut_upoll_wait_memb(m + 1);
+		cute_check_ptr(utilsut_upoll_memb_poller,
+		               equal,
+		               upoll_group_poller(&utilsut_upoll_grp, m));
+	}
+	cute_check_sint(upoll_group_stop(&utilsut_upoll_grp), equal, 0);
+
+	/* Nothing is dispatched while stopped... */
+	utilsut_upoll_kick(utilsut_upoll_memb_fds[0]);
+	usleep(10000);
+	cute_check_uint(atomic_load(&utilsut_upoll_memb_cnt),
+	                equal,
+	                UTILSUT_UPOLL_LOOP_NR);
+
+	/* ...and pending events are dispatched once restarted. */
+	cute_check_sint(upoll_group_start(&utilsut_upoll_grp), equal, 0);
+	utilsut_upoll_wait_memb(UTILSUT_UPOLL_LOOP_NR + 1);
+	cute_check_sint(upoll_group_stop(&utilsut_upoll_grp), equal, 0);
+	cute_check_ptr(utilsut_upoll_memb_poller,
+	               equal,
+	               upoll_group_poller(&utilsut_upoll_grp, 0));
+
+	for (m = 0; m < UTILSUT_UPOLL_LOOP_NR; m++)
+		utilsut_upoll_unregister_memb(m, m);
+	upoll_group_close(&utilsut_upoll_grp);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_group_status,
+                 utilsut_upoll_setup_group,
+                 utilsut_upoll_teardown_group,
+                 CUTE_DFLT_TMOUT)
+{
+	unsigned int m;
+
+	cute_check_sint(upoll_group_open(&utilsut_upoll_grp,
+	                                 UTILSUT_UPOLL_LOOP_NR,
+	                                 NULL,
+	                                 4,
+	                                 UPOLL_GROUP_RR_POLICY),
+	                equal,
+	                0);
+	for (m = 0; m < UTILSUT_UPOLL_LOOP_NR; m++)
+		cute_check_sint(upoll_group_register(&utilsut_upoll_grp,
+		                                     utilsut_upoll_memb_fds[m],
+		                                     EPOLLIN,
+		                                     &utilsut_upoll_membs[m]),
+		                equal,
+		                (int)m);
+
+	/*
+	 * A dispatch function failure makes its loop exit and is reported at
+	 * stopping time while other loops keep running meanwhile.
+	 */
+	utilsut_upoll_memb_ret = -EPIPE;
+	cute_check_sint(upoll_group_start(&utilsut_upoll_grp), equal, 0);
+	utilsut_upoll_kick(utilsut_upoll_memb_fds[1]);
+	utilsut_upoll_wait_memb(1);
+	utilsut_upoll_memb_ret = 0;
+	utilsut_upoll_kick(utilsut_upoll_memb_fds[2]);
+	utilsut_upoll_wait_memb(2);
+	cute_check_sint(upoll_group_stop(&utilsut_upoll_grp), equal, -EPIPE);
+
+	/* Status is reset on restart. */
+	cute_check_sint(upoll_group_start(&utilsut_upoll_grp), equal, 0);
+	cute_check_sint(upoll_group_stop(&utilsut_upoll_grp), equal, 0);
+
+	for (m = 0; m < UTILSUT_UPOLL_LOOP_NR; m++)
+		utilsut_upoll_unregister_memb(m, m);
+	upoll_group_close(&utilsut_upoll_grp);
+}
+
+CUTE_TEST_STATIC(utilsut_upoll_group_handoff,
+                 utilsut_upoll_setup_group,
+                 utilsut_upoll_teardown_group,
+                 CUTE_DFLT_TMOUT)
+{
+	struct upoll_worker * work = &utilsut_upoll_membs[0];
+
+	cute_check_sint(upoll_group_open(&utilsut_upoll_grp,
+	                                 UTILSUT_UPOLL_LOOP_NR,
+	                                 NULL,
+	                                 4,
+	                                 UPOLL_GROUP_RR_POLICY),
+	                equal,
+	                0);
+	cute_check_sint(upoll_group_register(&utilsut_upoll_grp,
+	                                     utilsut_upoll_memb_fds[0],
+	                                     EPOLLIN | EPOLLONESHOT,
+	                                     work),
+	                equal,
+	                0);
+	upoll_setup_prio(work, 1);
+
+	/* Move the worker to loop 2 from within its dispatch function. */
+	utilsut_upoll_memb_to = 2;
+	cute_check_sint(upoll_group_start(&utilsut_upoll_grp), equal, 0);
+	utilsut_upoll_kick(utilsut_upoll_memb_fds[0]);
+	utilsut_upoll_wait_memb(1);
+	cute_check_ptr(utilsut_upoll_memb_poller,
+	               equal,
+	               upoll_group_poller(&utilsut_upoll_grp, 0));
+	cute_check_sint(utilsut_upoll_memb_err, equal, 0);
+	utilsut_upoll_check_load(0, 0, 1);
+
+	/*
+	 * Oneshot worker disabled by the kernel once dispatched by loop 0 is
+	 * re-armed into loop 2.
+	 */
+	utilsut_upoll_kick(utilsut_upoll_memb_fds[0]);
+	utilsut_upoll_wait_memb(2);
+	cute_check_ptr(utilsut_upoll_memb_poller,
+	               equal,
+	               upoll_group_poller(&utilsut_upoll_grp, 2));
+	cute_check_sint(upoll_group_stop(&utilsut_upoll_grp), equal, 0);
+
+	cute_check_uint(upoll_watched_events(work), equal, EPOLLIN);
+	cute_check_uint(work->prio, equal, 1);
+
+	/* Handing off to the current loop is a no-op. */
+	cute_check_sint(upoll_group_handoff(&utilsut_upoll_grp,
+	                                    upoll_group_poller(&utilsut_upoll_grp,
+	                                                       2),
+	                                    2,
+	                                    utilsut_upoll_memb_fds[0],
+	                                    work),
+	                equal,
+	                0);
+	utilsut_upoll_check_load(0, 0, 1);
+
+	/* Handing off while stopped is allowed too. */
+	cute_check_sint(upoll_group_handoff(&utilsut_upoll_grp,
+	                                    upoll_group_poller(&utilsut_upoll_grp,
+	                                                       2),
+	                                    1,
+	                                    utilsut_upoll_memb_fds[0],
+	                                    work),
+	                equal,
+	                0);
+	utilsut_upoll_check_load(0, 1, 0);
+
+	utilsut_upoll_unregister_memb(0, 1);
+	upoll_group_close(&utilsut_upoll_grp);
+}
+
+#endif /* defined(CONFIG_UTILS_POLL_GROUP) */
+
+CUTE_GROUP(utilsut_poll_group) = {
+	CUTE_REF(utilsut_upoll_coalesce),
+	CUTE_REF(utilsut_upoll_unregister_ready),
+	CUTE_REF(utilsut_upoll_unregister_oneshot),
+	CUTE_REF(utilsut_upoll_oneshot_rearm),
+	CUTE_REF(utilsut_upoll_edge),
+	CUTE_REF(utilsut_upoll_exclusive_assert),
+	CUTE_REF(utilsut_upoll_ring_prio),
+	CUTE_REF(utilsut_upoll_ring_budget),
+	CUTE_REF(utilsut_upoll_ring_reprio),
+#if defined(CONFIG_UTILS_POLL_BATCH)
+	CUTE_REF(utilsut_upoll_batch),
+#endif /* defined(CONFIG_UTILS_POLL_BATCH) */
+#if defined(CONFIG_UTILS_POLL_TASK)
+	CUTE_REF(utilsut_upoll_task_mpsc),
+#endif /* defined(CONFIG_UTILS_POLL_TASK) */
+#if defined(CONFIG_UTILS_POLL_BUSY)
+	CUTE_REF(utilsut_upoll_busy_steady),
+	CUTE_REF(utilsut_upoll_busy_sparse),
+	CUTE_REF(utilsut_upoll_busy_error),
+#if defined(CONFIG_UTILS_POLL_URING)
+	CUTE_REF(utilsut_upoll_busy_uring),
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+#endif /* defined(CONFIG_UTILS_POLL_BUSY) */
+#if defined(CONFIG_UTILS_POLL_URING)
+	CUTE_REF(utilsut_upoll_uring_register),
+	CUTE_REF(utilsut_upoll_uring_modify),
+	CUTE_REF(utilsut_upoll_uring_oneshot),
+	CUTE_REF(utilsut_upoll_uring_cancel),
+	CUTE_REF(utilsut_upoll_uring_full),
+	CUTE_REF(utilsut_upoll_uring_stale),
+	CUTE_REF(utilsut_upoll_uring_fallback),
+#endif /* defined(CONFIG_UTILS_POLL_URING) */
+#if defined(CONFIG_UTILS_POLL_GROUP)
+	CUTE_REF(utilsut_upoll_group_rr),
+	CUTE_REF(utilsut_upoll_group_load),
+	CUTE_REF(utilsut_upoll_group_cpu),
+	CUTE_REF(utilsut_upoll_group_start_stop),
+	CUTE_REF(utilsut_upoll_group_status),
+	CUTE_REF(utilsut_upoll_group_handoff),
+#endif /* defined(CONFIG_UTILS_POLL_GROUP) */
+};
+
+CUTE_SUITE_EXTERN(utilsut_poll_suite,
+                  utilsut_poll_group,
+                  CUTE_NULL_SETUP,
+                  CUTE_NULL_TEARDOWN,
+                  CUTE_DFLT_TMOUT);
@@ -37,6 +37,45 @@ etuxpt_parse_sched_prio(const char * __restrict arg,
 	return EXIT_SUCCESS;
 }
 
+int
+etuxpt_parse_uint(const char * __restrict   arg,
+                  const char * __restrict   name,
+                  unsigned long             min,
+                  unsigned long             max,
+                  unsigned long * __restrict value)
+{
+	assert(arg);
+	assert(name);
+	assert(min <= max);
+	assert(value);
+
+	char *        str;
+	unsigned long val;
+	int           err = 0;
+
+	errno = 0;
+	val = strtoul(arg, &str, 0);
+	if (errno)
+		err = errno;
+	else if (*str || (str == arg))
+		err = EINVAL;
+	else if ((val < min) || (val > max))
+		err = ERANGE;
+
+	if (err) {
+		etuxpt_err("invalid %s '%s' specified: %s (%d).\n",
+		           name,
+		           arg,
+		           strerror(err),
+		           err);
+		return EXIT_FAILURE;
+	}
+
+	*value = val;
+
+	return EXIT_SUCCESS;
+}
+
 int
 etuxpt_setup_sched_prio(int priority)
 {
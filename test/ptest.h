@@ -21,6 +21,13 @@ extern int
 etuxpt_parse_sched_prio(const char * __restrict arg,
                         int * __restrict        priority);
 
+extern int
+etuxpt_parse_uint(const char * __restrict   arg,
+                  const char * __restrict   name,
+                  unsigned long             min,
+                  unsigned long             max,
+                  unsigned long * __restrict value);
+
 extern int etuxpt_setup_sched_prio(int priority);
 
 #endif /* _ETUX_PTEST_H */
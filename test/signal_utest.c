@@ -0,0 +1,186 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Utils.
+ * Copyright (C) 2017-2024 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "utils/signal.h"
+#include "utest.h"
+#include <errno.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#define UTILSUT_USIG_BURST_NR ((3 * USIG_DISPATCH_BATCH) + 5)
+
+static struct upoll         utilsut_usig_poll;
+static struct usig_dispatch utilsut_usig_disp;
+static sigset_t             utilsut_usig_omask;
+static unsigned int         utilsut_usig_cnt;
+static bool                 utilsut_usig_order;
+
+static int
+utilsut_usig_handle(const struct signalfd_siginfo * __restrict info,
+                    void *                                     data)
+{
+	cute_check_ptr(data, equal, &utilsut_usig_cnt);
+	cute_check_sint((int)info->ssi_signo, equal, SIGRTMIN);
+
+	/* Realtime signals are queued and delivered in sending order. */
+	if ((unsigned int)info->ssi_int != utilsut_usig_cnt)
+		utilsut_usig_order = false;
+	utilsut_usig_cnt++;
+
+	return 0;
+}
+
+static void
+utilsut_usig_setup(void)
+{
+	sigset_t msk;
+
+	usig_emptyset(&msk);
+	usig_addset(&msk, SIGRTMIN);
+	usig_procmask(SIG_BLOCK, &msk, &utilsut_usig_omask);
+
+	utilsut_usig_cnt = 0;
+	utilsut_usig_order = true;
+
+	cute_check_sint(upoll_open(&utilsut_usig_poll, 4), equal, 0);
+	usig_dispatch_init(&utilsut_usig_disp);
+	cute_check_sint(usig_dispatch_register(&utilsut_usig_disp,
+	                                       SIGRTMIN,
+	                                       utilsut_usig_handle,
+	                                       &utilsut_usig_cnt),
+	                equal,
+	                0);
+}
+
+static void
+utilsut_usig_teardown(void)
+{
+	sigset_t        msk;
+	struct timespec tmout = { 0, 0 };
+
+	if (utilsut_usig_disp.fd >= 0)
+		usig_dispatch_close(&utilsut_usig_disp, &utilsut_usig_poll);
+	upoll_close(&utilsut_usig_poll);
+
+	/* Flush signals left pending, if any, before unblocking. */
+	usig_emptyset(&msk);
+	usig_addset(&msk, SIGRTMIN);
+	while (sigtimedwait(&msk, NULL, &tmout) == SIGRTMIN)
+		;
+	usig_procmask(SIG_SETMASK, &utilsut_usig_omask, NULL);
+}
+
+static void
+utilsut_usig_burst(unsigned int nr)
+{
+	unsigned int s;
+
+	for (s = 0; s < nr; s++) {
+		const union sigval val = { .sival_int = (int)s };
+
+		cute_check_sint(sigqueue(getpid(), SIGRTMIN, val), equal, 0);
+	}
+}
+
+CUTE_TEST_STATIC(utilsut_usig_dispatch_burst,
+                 utilsut_usig_setup,
+                 utilsut_usig_teardown,
+                 CUTE_DFLT_TMOUT)
+{
+	unsigned int wakes = 0;
+
+	cute_check_sint(usig_dispatch_open(&utilsut_usig_disp,
+	                                   &utilsut_usig_poll),
+	                equal,
+	                0);
+
+	utilsut_usig_burst(UTILSUT_USIG_BURST_NR);
+
+	/*
+	 * At most USIG_DISPATCH_BATCH records are handled per wakeup: the
+	 * burst is handled over several ones without any loss.
+	 */
+	while (utilsut_usig_cnt < UTILSUT_USIG_BURST_NR) {
+		cute_check_sint(upoll_process(&utilsut_usig_poll, 1000),
+		                equal,
+		                0);
+		cute_check_uint(utilsut_usig_cnt,
+		                lower_equal,
+		                (wakes + 1) * USIG_DISPATCH_BATCH);
+		wakes++;
+	}
+
+	cute_check_uint(utilsut_usig_cnt, equal, UTILSUT_USIG_BURST_NR);
+	cute_check_bool(utilsut_usig_order, is, true);
+	cute_check_uint(wakes,
+	                greater_equal,
+	                (UTILSUT_USIG_BURST_NR + USIG_DISPATCH_BATCH - 1) /
+	                USIG_DISPATCH_BATCH);
+
+	cute_check_sint(upoll_process(&utilsut_usig_poll, 0), equal, -ETIME);
+}
+
+static int
+utilsut_usig_close(struct upoll_worker * worker __unused,
+                   uint32_t              events __unused,
+                   const struct upoll *  poller)
+{
+	usig_dispatch_close(&utilsut_usig_disp, poller);
+
+	return 0;
+}
+
+CUTE_TEST_STATIC(utilsut_usig_dispatch_close,
+                 utilsut_usig_setup,
+                 utilsut_usig_teardown,
+                 CUTE_DFLT_TMOUT)
+{
+	struct upoll_worker work;
+	int                 fd;
+	const uint64_t      one = 1;
+
+	cute_check_sint(upoll_setup_ring(&utilsut_usig_poll, 0), equal, 0);
+	cute_check_sint(usig_dispatch_open(&utilsut_usig_disp,
+	                                   &utilsut_usig_poll),
+	                equal,
+	                0);
+
+	fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	cute_check_sint(fd, greater_equal, 0);
+	cute_check_sint(upoll_register_dispatch(&utilsut_usig_poll,
+	                                        fd,
+	                                        EPOLLIN,
+	                                        &work,
+	                                        utilsut_usig_close),
+	                equal,
+	                0);
+	upoll_setup_prio(&work, 0);
+
+	/*
+	 * Dispatcher is closed by a worker dispatched first while signals are
+	 * collected for it: these must be dropped.
+	 */
+	utilsut_usig_burst(1);
+	cute_check_sint(write(fd, &one, sizeof(one)), equal, sizeof(one));
+	cute_check_sint(upoll_process(&utilsut_usig_poll, 1000), equal, 0);
+	cute_check_sint(utilsut_usig_disp.fd, equal, -1);
+	cute_check_uint(utilsut_usig_cnt, equal, 0);
+
+	upoll_unregister(&utilsut_usig_poll, fd);
+	close(fd);
+}
+
+CUTE_GROUP(utilsut_signal_group) = {
+	CUTE_REF(utilsut_usig_dispatch_burst),
+	CUTE_REF(utilsut_usig_dispatch_close),
+};
+
+CUTE_SUITE_EXTERN(utilsut_signal_suite,
+                  utilsut_signal_group,
+                  CUTE_NULL_SETUP,
+                  CUTE_NULL_TEARDOWN,
+                  CUTE_DFLT_TMOUT);
@@ -0,0 +1,87 @@
+#!/bin/sh -e
+################################################################################
+# SPDX-License-Identifier: LGPL-3.0-only
+#
+# This file is part of Utils.
+# Copyright (C) 2017-2024 Grégor Boirie <gregor.boirie@free.fr>
+################################################################################
+
+backends='list heap hwheel hybrid'
+
+ECHOE="/bin/echo -e"
+
+error()
+{
+	$ECHOE "$arg0: $*" >&2
+}
+
+usage()
+{
+	cat >&2 <<_EOF
+Usage: $arg0 [OPTIONS] -- PTEST_ARGS...
+Replay the same timer workload against all eTux timer implementations.
+
+Where OPTIONS:
+    -d | --dir DIRECTORY  directory where to search for timer performance test
+                          programs (defaults to the directory of this script)
+    -h | --help           this help message
+With:
+    DIRECTORY  -- pathname to directory hosting etux-timer-<backend>-ptest
+                  programs
+    PTEST_ARGS -- arguments given to each etux-timer-<backend>-ptest program,
+                  e.g. \`-g bimodal -n 100000 -s 3' or an event file
+                  pathname (see \`etux-timer-<backend>-ptest --help')
+_EOF
+}
+
+arg0="$(basename $0)"
+
+cmdln=$(getopt --options +d:h \
+               --longoptions dir:,help \
+               --name "$arg0" \
+               -- "$@")
+if [ $? -gt 0 ]; then
+	usage
+	exit 1
+fi
+
+dir="$(dirname $0)"
+eval set -- "$cmdln"
+while true; do
+	case "$1" in
+	-d|--dir)
+		dir="$2"
+		shift 2;;
+	-h|--help)
+		usage
+		exit 0;;
+	--)
+		shift;
+		break;;
+	*)
+		break;;
+	esac
+done
+
+if [ $# -lt 1 ]; then
+	error 'invalid number of arguments.\n'
+	usage
+	exit 1
+fi
+
+found=0
+for b in $backends; do
+	ptest="$dir/etux-timer-$b-ptest"
+	if [ ! -x "$ptest" ]; then
+		continue
+	fi
+
+	"$ptest" "$@"
+	echo
+	found=$((found + 1))
+done
+
+if [ $found -eq 0 ]; then
+	error "no timer performance test program found under '$dir'.\n"
+	exit 1
+fi
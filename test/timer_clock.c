@@ -51,3 +51,14 @@ etuxpt_timer_clock_expect(const struct timespec * __restrict expected)
 	else
 		etuxpt_timer_clock_on = false;
 }
+
+/*
+ * Fetch current time from the hardware based monotonic clock, bypassing
+ * clock_gettime() mocking so that processing durations may be measured while
+ * replaying timer events.
+ */
+void
+etuxpt_timer_clock_raw(struct timespec * __restrict now)
+{
+	__clock_gettime(CLOCK_MONOTONIC_RAW, now);
+}
@@ -9,4 +9,8 @@ extern void
 etuxpt_timer_clock_expect(const struct timespec * __restrict expected)
 	__nothrow __leaf __export_intern;
 
+extern void
+etuxpt_timer_clock_raw(struct timespec * __restrict now)
+	__nothrow __leaf __export_intern;
+
 #endif /* _ETUX_TEST_TIMER_CLOCK_H */
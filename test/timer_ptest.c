@@ -3,11 +3,17 @@
 #include "timer_clock.h"
 #include "trace_clock.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdint.h>
+#include <limits.h>
 #include <string.h>
 #include <getopt.h>
 #include <errno.h>
 
+#define ETUXPT_TIMER_DFLT_EVENTS (100000U)
+#define ETUXPT_TIMER_DFLT_TIMERS (1024U)
+#define ETUXPT_TIMER_DFLT_SEED   (1U)
+
 enum etuxpt_timer_kind {
 	ETUXPT_TIMER_ARM_TSPEC_KIND = 0,
 	ETUXPT_TIMER_ARM_MSEC_KIND  = 1,
@@ -20,15 +26,25 @@ enum etuxpt_timer_kind {
 	ETUXPT_TIMER_KIND_NR
 };
 
+enum etuxpt_timer_op {
+	ETUXPT_TIMER_ARM_OP    = 0,
+	ETUXPT_TIMER_CANCEL_OP = 1,
+	ETUXPT_TIMER_RUN_OP    = 2,
+	ETUXPT_TIMER_OP_NR,
+	ETUXPT_TIMER_NULL_OP   = ETUXPT_TIMER_OP_NR
+};
+
 struct etuxpt_timer_event;
 typedef void (etuxpt_timer_process_fn)
              (const struct etuxpt_timer_event * __restrict);
 
 struct etuxpt_timer_event {
 	etuxpt_timer_process_fn *     process;
+	enum etuxpt_timer_op          op;
 	struct timespec               stamp;
 	char *                        task;
 	unsigned long                 addr;
+	struct etux_timer *           timer;
 	union {
 		struct timespec       tspec;
 		int                   msec;
@@ -36,26 +52,80 @@ struct etuxpt_timer_event {
 	};
 };
 
+/*
+ * Timers are registered into an open addressing hash table indexed by timer
+ * identifier, i.e. the kernel timer address found into event files. Lookup
+ * happens once per event at preparation time so that the replay loop
+ * dereferences event timers directly.
+ */
 struct etuxpt_timer {
 	unsigned long       id;
 	struct etux_timer * base;
 };
 
+#define ETUXPT_TIMER_HASH_BITS_MIN (6U)
+
 static unsigned int          etuxpt_timer_cnt;
-static unsigned int          etuxpt_timer_nr;
+static unsigned int          etuxpt_timer_bits;
 static struct etuxpt_timer * etuxpt_timers;
 
+static
+unsigned int
+etuxpt_timer_hash(unsigned long id, unsigned int bits)
+{
+	assert(id);
+	assert(bits);
+	assert(bits < 32);
+
+	return (unsigned int)(((uint64_t)id * UINT64_C(0x9e3779b97f4a7c15)) >>
+	                      (64 - bits));
+}
+
 static
 struct etuxpt_timer *
-etuxpt_timer_get(unsigned long id)
+etuxpt_timer_probe(struct etuxpt_timer * __restrict timers,
+                   unsigned int                     bits,
+                   unsigned long                    id)
 {
-	unsigned int t;
+	unsigned int mask = (1U << bits) - 1;
+	unsigned int t = etuxpt_timer_hash(id, bits);
 
-	for (t = 0; t < etuxpt_timer_cnt; t++)
-		if (etuxpt_timers[t].id == id)
-			return &etuxpt_timers[t];
+	while (timers[t].id && (timers[t].id != id))
+		t = (t + 1) & mask;
 
-	return NULL;
+	return &timers[t];
+}
+
+static
+int
+etuxpt_timer_grow(void)
+{
+	unsigned int          bits = etuxpt_timer_bits ?
+	                             etuxpt_timer_bits + 1 :
+	                             ETUXPT_TIMER_HASH_BITS_MIN;
+	struct etuxpt_timer * timers;
+	unsigned int          t;
+
+	timers = calloc(1U << bits, sizeof(timers[0]));
+	if (!timers)
+		return -errno;
+
+	if (etuxpt_timers) {
+		for (t = 0; t < (1U << etuxpt_timer_bits); t++) {
+			const struct etuxpt_timer * old = &etuxpt_timers[t];
+
+			if (old->id)
+				*etuxpt_timer_probe(timers, bits, old->id) =
+					*old;
+		}
+
+		free(etuxpt_timers);
+	}
+
+	etuxpt_timers = timers;
+	etuxpt_timer_bits = bits;
+
+	return 0;
 }
 
 static
@@ -70,11 +140,9 @@ void
 etuxpt_timer_process_arm_tspec(
 	const struct etuxpt_timer_event * __restrict event)
 {
-	struct etuxpt_timer * tmr = etuxpt_timer_get(event->addr);
-
-	assert(tmr);
+	assert(event->timer);
 
-	etux_timer_arm_tspec(tmr->base, &event->tspec);
+	etux_timer_arm_tspec(event->timer, &event->tspec);
 }
 
 static
@@ -82,11 +150,9 @@ void
 etuxpt_timer_process_arm_msec(
 	const struct etuxpt_timer_event * __restrict event)
 {
-	struct etuxpt_timer * tmr = etuxpt_timer_get(event->addr);
+	assert(event->timer);
 
-	assert(tmr);
-
-	etux_timer_arm_msec(tmr->base, event->msec);
+	etux_timer_arm_msec(event->timer, event->msec);
 }
 
 static
@@ -94,22 +160,18 @@ void
 etuxpt_timer_process_arm_sec(
 	const struct etuxpt_timer_event * __restrict event)
 {
-	struct etuxpt_timer * tmr = etuxpt_timer_get(event->addr);
-
-	assert(tmr);
+	assert(event->timer);
 
-	etux_timer_arm_sec(tmr->base, event->sec);
+	etux_timer_arm_sec(event->timer, event->sec);
 }
 
 static
 void
 etuxpt_timer_process_cancel(const struct etuxpt_timer_event * __restrict event)
 {
-	struct etuxpt_timer * tmr = etuxpt_timer_get(event->addr);
+	assert(event->timer);
 
-	assert(tmr);
-
-	etux_timer_cancel(tmr->base);
+	etux_timer_cancel(event->timer);
 }
 
 static
@@ -128,39 +190,51 @@ etuxpt_timer_expire(struct etux_timer * timer __unused)
 }
 
 static
-struct etuxpt_timer *
+struct etux_timer *
 etuxpt_timer_build(unsigned long id)
 {
 	struct etuxpt_timer * tmr;
 
-	tmr = etuxpt_timer_get(id);
-	if (!tmr) {
-		struct etux_timer * base;
-
-		if (etuxpt_timer_cnt >= etuxpt_timer_nr) {
-			unsigned int nr = stroll_max(etuxpt_timer_nr * 2, 1U);
+	assert(id);
 
-			tmr = realloc(etuxpt_timers,
-			              nr * sizeof(etuxpt_timers[0]));
-			if (!tmr)
-				return NULL;
+	if (((etuxpt_timer_cnt + 1) * 2) > (1U << etuxpt_timer_bits)) {
+		if (etuxpt_timer_grow())
+			return NULL;
+	}
 
-			etuxpt_timers = tmr;
-			etuxpt_timer_nr = nr;
-		}
+	tmr = etuxpt_timer_probe(etuxpt_timers, etuxpt_timer_bits, id);
+	if (!tmr->id) {
+		struct etux_timer * base;
 
 		base = malloc(sizeof(*base));
 		if (!base)
 			return NULL;
 		etux_timer_init(base, etuxpt_timer_expire);
 
-		etuxpt_timers[etuxpt_timer_cnt].id = id;
-		etuxpt_timers[etuxpt_timer_cnt].base = base;
-
-		return &etuxpt_timers[etuxpt_timer_cnt++];
+		tmr->id = id;
+		tmr->base = base;
+		etuxpt_timer_cnt++;
 	}
 
-	return tmr;
+	return tmr->base;
+}
+
+static
+void
+etuxpt_timer_destroy_all(void)
+{
+	unsigned int t;
+
+	if (!etuxpt_timers)
+		return;
+
+	for (t = 0; t < (1U << etuxpt_timer_bits); t++)
+		free(etuxpt_timers[t].base);
+
+	free(etuxpt_timers);
+	etuxpt_timers = NULL;
+	etuxpt_timer_bits = 0;
+	etuxpt_timer_cnt = 0;
 }
 
 enum etuxpt_endian {
@@ -519,6 +593,7 @@ etuxpt_timer_step_data_iter(const struct etuxpt_timer_data * __restrict data,
 	switch (kind) {
 	case ETUXPT_TIMER_ARM_TSPEC_KIND:
 		event->process = etuxpt_timer_process_arm_tspec;
+		event->op = ETUXPT_TIMER_ARM_OP;
 		err = etuxpt_timer_read_data_addr(data, &event->addr);
 		if (!err)
 			err = etuxpt_timer_read_data_expiry(data,
@@ -527,6 +602,7 @@ etuxpt_timer_step_data_iter(const struct etuxpt_timer_data * __restrict data,
 
 	case ETUXPT_TIMER_ARM_MSEC_KIND:
 		event->process = etuxpt_timer_process_arm_msec;
+		event->op = ETUXPT_TIMER_ARM_OP;
 		err = etuxpt_timer_read_data_addr(data, &event->addr);
 		if (!err)
 			err = etuxpt_timer_read_data_msec(data, &event->msec);
@@ -534,6 +610,7 @@ etuxpt_timer_step_data_iter(const struct etuxpt_timer_data * __restrict data,
 
 	case ETUXPT_TIMER_ARM_SEC_KIND:
 		event->process = etuxpt_timer_process_arm_sec;
+		event->op = ETUXPT_TIMER_ARM_OP;
 		err = etuxpt_timer_read_data_addr(data, &event->addr);
 		if (!err)
 			err = etuxpt_timer_read_data_sec(data, &event->sec);
@@ -541,11 +618,13 @@ etuxpt_timer_step_data_iter(const struct etuxpt_timer_data * __restrict data,
 
 	case ETUXPT_TIMER_CANCEL_KIND:
 		event->process = etuxpt_timer_process_cancel;
+		event->op = ETUXPT_TIMER_CANCEL_OP;
 		err = etuxpt_timer_read_data_addr(data, &event->addr);
 		break;
 
 	case ETUXPT_TIMER_RUN_KIND:
 		event->process = etuxpt_timer_process_run;
+		event->op = ETUXPT_TIMER_RUN_OP;
 		event->addr = 0;
 		break;
 
@@ -553,6 +632,7 @@ etuxpt_timer_step_data_iter(const struct etuxpt_timer_data * __restrict data,
 	case ETUXPT_TIMER_ISSUE_MSEC:
 	case ETUXPT_TIMER_EXPIRE_KIND:
 		event->process = etuxpt_timer_process_null;
+		event->op = ETUXPT_TIMER_NULL_OP;
 		event->addr = 0;
 		break;
 
@@ -709,35 +789,414 @@ close:
 	return NULL;
 }
 
+/*
+ * Synthetic workload generators.
+ *
+ * Each generator produces a stream of timer arming / canceling events
+ * interleaved with timer run events, i.e. one run event per arming / canceling
+ * event, mimicking an event loop that processes expired timers after each
+ * wakeup. Streams are generated thanks to a seeded pseudo-random number
+ * generator so that the same workload may be replayed against every timer
+ * implementation.
+ */
+struct etuxpt_timer_synth {
+	uint64_t        rand;
+	unsigned long   timers;
+	unsigned int    burst;
+	struct timespec stamp;
+};
+
+typedef void (etuxpt_timer_synth_fn)
+             (struct etuxpt_timer_synth * __restrict,
+              struct etuxpt_timer_event * __restrict);
+
+struct etuxpt_timer_gen {
+	const char *            name;
+	etuxpt_timer_synth_fn * step;
+};
+
+static
+uint64_t
+etuxpt_timer_synth_rand(struct etuxpt_timer_synth * __restrict synth)
+{
+	/* xorshift64* pseudo-random number generator. */
+	synth->rand ^= synth->rand >> 12;
+	synth->rand ^= synth->rand << 25;
+	synth->rand ^= synth->rand >> 27;
+
+	return synth->rand * UINT64_C(0x2545f4914f6cdd1d);
+}
+
+static
+unsigned long
+etuxpt_timer_synth_range(struct etuxpt_timer_synth * __restrict synth,
+                         unsigned long                          min,
+                         unsigned long                          max)
+{
+	assert(min <= max);
+
+	return min +
+	       (unsigned long)(etuxpt_timer_synth_rand(synth) %
+	                       ((uint64_t)(max - min) + 1));
+}
+
+static
+bool
+etuxpt_timer_synth_odds(struct etuxpt_timer_synth * __restrict synth,
+                        unsigned int                           percent)
+{
+	return etuxpt_timer_synth_range(synth, 0, 99) < percent;
+}
+
+static
+void
+etuxpt_timer_synth_advance(struct etuxpt_timer_synth * __restrict synth,
+                           unsigned long                          min_nsec,
+                           unsigned long                          max_nsec)
+{
+	struct timespec delta;
+	unsigned long   nsec = etuxpt_timer_synth_range(synth,
+	                                                min_nsec,
+	                                                max_nsec);
+
+	delta.tv_sec = (time_t)(nsec / 1000000000UL);
+	delta.tv_nsec = (long)(nsec % 1000000000UL);
+	utime_tspec_add_clamp(&synth->stamp, &delta);
+}
+
+static
+void
+etuxpt_timer_synth_arm(struct etuxpt_timer_synth * __restrict synth,
+                       struct etuxpt_timer_event * __restrict event,
+                       unsigned long                          min_msec,
+                       unsigned long                          max_msec)
+{
+	event->process = etuxpt_timer_process_arm_msec;
+	event->op = ETUXPT_TIMER_ARM_OP;
+	event->stamp = synth->stamp;
+	event->addr = etuxpt_timer_synth_range(synth, 1, synth->timers);
+	event->msec = (int)etuxpt_timer_synth_range(synth, min_msec, max_msec);
+}
+
+static
+void
+etuxpt_timer_synth_cancel(struct etuxpt_timer_synth * __restrict synth,
+                          struct etuxpt_timer_event * __restrict event)
+{
+	event->process = etuxpt_timer_process_cancel;
+	event->op = ETUXPT_TIMER_CANCEL_OP;
+	event->stamp = synth->stamp;
+	event->addr = etuxpt_timer_synth_range(synth, 1, synth->timers);
+}
+
+/*
+ * Expiries uniformly distributed over [1 millisecond, 10 seconds], 1 cancel
+ * for 3 arms.
+ */
+static
+void
+etuxpt_timer_synth_uniform(struct etuxpt_timer_synth * __restrict synth,
+                           struct etuxpt_timer_event * __restrict event)
+{
+	etuxpt_timer_synth_advance(synth, 0, 100000);
+
+	if (etuxpt_timer_synth_odds(synth, 75))
+		etuxpt_timer_synth_arm(synth, event, 1, 10000);
+	else
+		etuxpt_timer_synth_cancel(synth, event);
+}
+
+/*
+ * 90% of short timeouts within [1, 50] milliseconds and 10% of long leases
+ * within [30, 300] seconds, 1 cancel for 3 arms.
+ */
+static
+void
+etuxpt_timer_synth_bimodal(struct etuxpt_timer_synth * __restrict synth,
+                           struct etuxpt_timer_event * __restrict event)
+{
+	etuxpt_timer_synth_advance(synth, 0, 100000);
+
+	if (etuxpt_timer_synth_odds(synth, 75)) {
+		if (etuxpt_timer_synth_odds(synth, 90))
+			etuxpt_timer_synth_arm(synth, event, 1, 50);
+		else
+			etuxpt_timer_synth_arm(synth, event, 30000, 300000);
+	}
+	else
+		etuxpt_timer_synth_cancel(synth, event);
+}
+
+/*
+ * Network protocol like timeouts within [100 milliseconds, 5 seconds] that
+ * mostly get canceled before expiry.
+ */
+static
+void
+etuxpt_timer_synth_cancel_heavy(struct etuxpt_timer_synth * __restrict synth,
+                                struct etuxpt_timer_event * __restrict event)
+{
+	etuxpt_timer_synth_advance(synth, 0, 100000);
+
+	if (etuxpt_timer_synth_odds(synth, 50))
+		etuxpt_timer_synth_arm(synth, event, 100, 5000);
+	else
+		etuxpt_timer_synth_cancel(synth, event);
+}
+
+/*
+ * Bursts of [16, 256] timers armed at once with clustered expiries within
+ * [100, 110] milliseconds, separated by [1, 20] milliseconds idle periods.
+ */
+static
+void
+etuxpt_timer_synth_burst(struct etuxpt_timer_synth * __restrict synth,
+                         struct etuxpt_timer_event * __restrict event)
+{
+	if (!synth->burst) {
+		etuxpt_timer_synth_advance(synth, 1000000, 20000000);
+		synth->burst = (unsigned int)etuxpt_timer_synth_range(synth,
+		                                                      16,
+		                                                      256);
+	}
+
+	synth->burst--;
+
+	if (etuxpt_timer_synth_odds(synth, 90))
+		etuxpt_timer_synth_arm(synth, event, 100, 110);
+	else
+		etuxpt_timer_synth_cancel(synth, event);
+}
+
+static const struct etuxpt_timer_gen etuxpt_timer_gens[] = {
+	{ .name = "uniform", .step = etuxpt_timer_synth_uniform },
+	{ .name = "bimodal", .step = etuxpt_timer_synth_bimodal },
+	{ .name = "cancel",  .step = etuxpt_timer_synth_cancel_heavy },
+	{ .name = "burst",   .step = etuxpt_timer_synth_burst }
+};
+
+static
+const struct etuxpt_timer_gen *
+etuxpt_timer_find_gen(const char * __restrict name)
+{
+	unsigned int g;
+
+	for (g = 0; g < stroll_array_nr(etuxpt_timer_gens); g++)
+		if (!strcmp(name, etuxpt_timer_gens[g].name))
+			return &etuxpt_timer_gens[g];
+
+	etuxpt_err("unknown '%s' workload generator.\n", name);
+
+	return NULL;
+}
+
+static
+struct etuxpt_timer_event *
+etuxpt_timer_synth_evts(const struct etuxpt_timer_gen * __restrict gen,
+                        unsigned int                               nr,
+                        unsigned long                              timers,
+                        unsigned long                              seed)
+{
+	assert(gen);
+	assert(nr);
+	assert(!(nr % 2));
+	assert(timers);
+
+	struct etuxpt_timer_event * evts;
+	struct etuxpt_timer_synth   synth = {
+		.rand   = ((uint64_t)seed << 1) | 1,
+		.timers = timers,
+		.burst  = 0,
+		.stamp  = { 0, 0 }
+	};
+	unsigned int                e;
+
+	evts = calloc(nr, sizeof(evts[0]));
+	if (!evts) {
+		etuxpt_err("failed to generate timer event data: %s (%d).\n",
+		           strerror(errno),
+		           errno);
+		return NULL;
+	}
+
+	for (e = 0; e < nr; e += 2) {
+		gen->step(&synth, &evts[e]);
+
+		evts[e + 1].process = etuxpt_timer_process_run;
+		evts[e + 1].op = ETUXPT_TIMER_RUN_OP;
+		evts[e + 1].stamp = synth.stamp;
+	}
+
+	return evts;
+}
+
+/*
+ * Per operation processing latencies, in nanoseconds.
+ */
+struct etuxpt_timer_lat {
+	unsigned int    cnt;
+	unsigned long * nsec;
+};
+
+static const char * const etuxpt_timer_op_names[ETUXPT_TIMER_OP_NR] = {
+	[ETUXPT_TIMER_ARM_OP]    = "arm",
+	[ETUXPT_TIMER_CANCEL_OP] = "cancel",
+	[ETUXPT_TIMER_RUN_OP]    = "run"
+};
+
+static
+unsigned long
+etuxpt_timer_elapsed_nsec(const struct timespec * __restrict start,
+                          const struct timespec * __restrict end)
+{
+	return (unsigned long)(((end->tv_sec - start->tv_sec) * 1000000000L) +
+	                       (end->tv_nsec - start->tv_nsec));
+}
+
+static
+int
+etuxpt_timer_cmp_nsec(const void * first, const void * second)
+{
+	unsigned long fst = *(const unsigned long *)first;
+	unsigned long snd = *(const unsigned long *)second;
+
+	return (fst > snd) - (fst < snd);
+}
+
+/* Return latency at the given quantile expressed in units of 0.01%. */
+static
+unsigned long
+etuxpt_timer_lat_quantile(const struct etuxpt_timer_lat * __restrict lat,
+                          unsigned int                               bips)
+{
+	assert(lat->cnt);
+	assert(bips <= 10000);
+
+	uint64_t idx = (((uint64_t)lat->cnt * bips) + 9999) / 10000;
+
+	return lat->nsec[idx ? idx - 1 : 0];
+}
+
 static
 void
+etuxpt_timer_report_lats(struct etuxpt_timer_lat lats[ETUXPT_TIMER_OP_NR],
+                         unsigned int            nr)
+{
+	unsigned int o;
+
+	printf("%s: %u events, %u timers\n"
+	       "%-8s %10s %8s %8s %8s %8s %8s %8s %8s (nanoseconds)\n",
+	       program_invocation_short_name,
+	       nr,
+	       etuxpt_timer_cnt,
+	       "#op",
+	       "count",
+	       "min",
+	       "p50",
+	       "p90",
+	       "p99",
+	       "p99.9",
+	       "max",
+	       "mean");
+
+	for (o = 0; o < ETUXPT_TIMER_OP_NR; o++) {
+		struct etuxpt_timer_lat * lat = &lats[o];
+		unsigned long long        sum = 0;
+		unsigned int              n;
+
+		if (!lat->cnt)
+			continue;
+
+		qsort(lat->nsec,
+		      lat->cnt,
+		      sizeof(lat->nsec[0]),
+		      etuxpt_timer_cmp_nsec);
+		for (n = 0; n < lat->cnt; n++)
+			sum += lat->nsec[n];
+
+		printf("%-8s %10u %8lu %8lu %8lu %8lu %8lu %8lu %8llu\n",
+		       etuxpt_timer_op_names[o],
+		       lat->cnt,
+		       lat->nsec[0],
+		       etuxpt_timer_lat_quantile(lat, 5000),
+		       etuxpt_timer_lat_quantile(lat, 9000),
+		       etuxpt_timer_lat_quantile(lat, 9900),
+		       etuxpt_timer_lat_quantile(lat, 9990),
+		       lat->nsec[lat->cnt - 1],
+		       sum / lat->cnt);
+	}
+}
+
+static
+int
 etuxpt_timer_run_evts(struct etuxpt_timer_event * events, unsigned int nr)
 {
-	unsigned int    e;
-	unsigned int    t;
-	struct timespec start;
-	struct timespec off = events[0].stamp;
+	unsigned int            e;
+	unsigned int            o;
+	struct timespec         start;
+	struct timespec         off = events[0].stamp;
+	struct etuxpt_timer_lat lats[ETUXPT_TIMER_OP_NR] = { { 0, NULL }, };
+	int                     ret = EXIT_FAILURE;
 
 	for (e = 0; e < nr; e++) {
 		utime_tspec_sub(&events[e].stamp, &off);
-		etuxpt_timer_build(events[e].addr);
+		if (events[e].addr) {
+			events[e].timer = etuxpt_timer_build(events[e].addr);
+			if (!events[e].timer) {
+				etuxpt_err("failed to build timers.\n");
+				goto destroy;
+			}
+		}
+		if (events[e].op < ETUXPT_TIMER_OP_NR)
+			lats[events[e].op].cnt++;
+	}
+
+	for (o = 0; o < ETUXPT_TIMER_OP_NR; o++) {
+		if (!lats[o].cnt)
+			continue;
+		lats[o].nsec = malloc(lats[o].cnt * sizeof(lats[o].nsec[0]));
+		if (!lats[o].nsec) {
+			etuxpt_err("failed to allocate latency samples.\n");
+			goto free;
+		}
+		lats[o].cnt = 0;
 	}
 
 	utime_monotonic_now(&start);
 	for (e = 0; e < nr; e++) {
-		struct timespec wait = start;
+		struct timespec             wait = start;
+		struct etuxpt_timer_event * evt = &events[e];
+		struct timespec             beg;
+		struct timespec             end;
 
-		utime_tspec_add_clamp(&wait, &events[e].stamp);
+		utime_tspec_add_clamp(&wait, &evt->stamp);
 
 		etuxpt_timer_clock_expect(&wait);
-		events[e].process(&events[e]);
+		etuxpt_timer_clock_raw(&beg);
+		evt->process(evt);
+		etuxpt_timer_clock_raw(&end);
 		etuxpt_timer_clock_expect(NULL);
+
+		if (evt->op < ETUXPT_TIMER_OP_NR) {
+			struct etuxpt_timer_lat * lat = &lats[evt->op];
+
+			lat->nsec[lat->cnt++] = etuxpt_timer_elapsed_nsec(&beg,
+			                                                  &end);
+		}
 	}
 
-	for (t = 0; t < etuxpt_timer_cnt; t++)
-		free(etuxpt_timers[t].base);
+	etuxpt_timer_report_lats(lats, nr);
 
-	free(etuxpt_timers);
+	ret = EXIT_SUCCESS;
+
+free:
+	for (o = 0; o < ETUXPT_TIMER_OP_NR; o++)
+		free(lats[o].nsec);
+
+destroy:
+	etuxpt_timer_destroy_all();
+
+	return ret;
 }
 
 static
@@ -757,38 +1216,113 @@ etuxpt_timer_usage(FILE * __restrict stdio)
 {
 	fprintf(stdio,
 	        "Usage: %s [OPTIONS] FILE\n"
+	        "       %s [OPTIONS] -g|--generate GENERATOR\n"
 	        "where OPTIONS:\n"
+	        "    -n|--events EVENTS\n"
+	        "    -t|--timers TIMERS\n"
+	        "    -s|--seed SEED\n"
 	        "    -p|--prio PRIORITY\n"
 	        "    -h|--help\n"
 	        "with:\n"
-	        "    PRIORITY -- a SCHED_FIFO priority integer\n"
-	        "    FILE     -- pathname to eTux timer event file\n"
-	        "                (generated thanks to `etux-timer-perf').\n",
-	        program_invocation_short_name);
+	        "    GENERATOR -- synthetic workload generator, one of:\n"
+	        "                 uniform -- expiries uniformly distributed\n"
+	        "                            within [1ms, 10s],\n"
+	        "                 bimodal -- short timeouts mixed with long\n"
+	        "                            leases,\n"
+	        "                 cancel  -- timeouts mostly canceled before\n"
+	        "                            expiry,\n"
+	        "                 burst   -- bursts of timers armed at once\n"
+	        "                            with clustered expiries,\n"
+	        "    EVENTS    -- number of generated timer operations\n"
+	        "                 (defaults to %u),\n"
+	        "    TIMERS    -- number of generated timers (defaults to %u),\n"
+	        "    SEED      -- generator random seed (defaults to %u),\n"
+	        "    PRIORITY  -- a SCHED_FIFO priority integer\n"
+	        "    FILE      -- pathname to eTux timer event file\n"
+	        "                 (generated thanks to `etux-timer-perf').\n",
+	        program_invocation_short_name,
+	        program_invocation_short_name,
+	        ETUXPT_TIMER_DFLT_EVENTS,
+	        ETUXPT_TIMER_DFLT_TIMERS,
+	        ETUXPT_TIMER_DFLT_SEED);
 }
 
 int
 main(int argc, char * const argv[])
 {
-	struct etuxpt_timer_data    data;
-	struct etuxpt_timer_event * events;
-	int                         prio = 0;
-	int                         ret;
+	struct etuxpt_timer_data        data;
+	struct etuxpt_timer_event *     events;
+	unsigned int                    nr;
+	const struct etuxpt_timer_gen * gen = NULL;
+	unsigned long                   ops = ETUXPT_TIMER_DFLT_EVENTS;
+	unsigned long                   timers = ETUXPT_TIMER_DFLT_TIMERS;
+	unsigned long                   seed = ETUXPT_TIMER_DFLT_SEED;
+	int                             prio = 0;
+	int                             ret;
 
 	while (true) {
 		int                        opt;
 		static const struct option lopts[] = {
-			{"help",    0, NULL, 'h'},
-			{"prio",    1, NULL, 'p'},
-			{0,         0, 0,    0}
+			{"help",     0, NULL, 'h'},
+			{"generate", 1, NULL, 'g'},
+			{"events",   1, NULL, 'n'},
+			{"timers",   1, NULL, 't'},
+			{"seed",     1, NULL, 's'},
+			{"prio",     1, NULL, 'p'},
+			{0,          0, 0,    0}
 		};
 
-		opt = getopt_long(argc, argv, "hp:", lopts, NULL);
+		opt = getopt_long(argc, argv, "hg:n:t:s:p:", lopts, NULL);
 		if (opt < 0)
 			/* No more options: go parsing positional arguments. */
 			break;
 
 		switch (opt) {
+		case 'g': /* synthetic workload generator */
+			gen = etuxpt_timer_find_gen(optarg);
+			if (!gen) {
+				etuxpt_timer_usage(stderr);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'n': /* number of generated operations */
+			if (etuxpt_parse_uint(optarg,
+			                      "number of events",
+			                      1,
+			                      UINT_MAX / 2,
+			                      &ops)) {
+				etuxpt_timer_usage(stderr);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 't': /* number of generated timers */
+			if (etuxpt_parse_uint(optarg,
+			                      "number of timers",
+			                      1,
+			                      UINT_MAX / 4,
+			                      &timers)) {
+				etuxpt_timer_usage(stderr);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 's': /* generator seed */
+			if (etuxpt_parse_uint(optarg,
+			                      "seed",
+			                      0,
+			                      ULONG_MAX,
+			                      &seed)) {
+				etuxpt_timer_usage(stderr);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
 		case 'p': /* priority */
 			if (etuxpt_parse_sched_prio(optarg, &prio)) {
 				etuxpt_timer_usage(stderr);
@@ -809,9 +1343,11 @@ main(int argc, char * const argv[])
 	}
 
 	/*
-	 * Check positional argument is properly specified on command line. */
+	 * Check positional argument is properly specified on command line,
+	 * i.e., an event file unless a synthetic workload is requested.
+	 */
 	argc -= optind;
-	if (argc != 1) {
+	if (argc != (gen ? 0 : 1)) {
 		etuxpt_err("invalid number of arguments.\n");
 		etuxpt_timer_usage(stderr);
 		return EXIT_FAILURE;
@@ -825,19 +1361,25 @@ main(int argc, char * const argv[])
 		return EXIT_FAILURE;
 	}
 
-	events = etuxpt_timer_load_evts(&data, argv[optind]);
+	if (gen) {
+		nr = (unsigned int)ops * 2;
+		events = etuxpt_timer_synth_evts(gen, nr, timers, seed);
+	}
+	else {
+		events = etuxpt_timer_load_evts(&data, argv[optind]);
+		nr = data.nr;
+	}
 	if (!events)
 		return EXIT_FAILURE;
 
-	if (etuxpt_setup_sched_prio(prio)) {
-		ret = EXIT_FAILURE;
+	ret = etuxpt_setup_sched_prio(prio);
+	if (ret)
 		goto unload;
-	}
 
-	etuxpt_timer_run_evts(events, data.nr);
+	ret = etuxpt_timer_run_evts(events, nr);
 
 unload:
-	etuxpt_timer_unload_evts(events, data.nr);
+	etuxpt_timer_unload_evts(events, nr);
 
 	return ret;
 }
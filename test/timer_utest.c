@@ -77,6 +77,51 @@ CUTE_TEST_STATIC(etuxut_timer_is_armed,
 	cute_check_bool(etux_timer_is_armed(&etuxut_the_timer), is, false);
 }
 
+/*
+ * Make sure that converting a tick to a timespec and back gives the original
+ * tick, whatever the tick period is a whole number of nanoseconds or not.
+ */
+CUTE_TEST(etuxut_timer_tick_conv)
+{
+	int64_t subsec;
+
+	for (subsec = 0; subsec < (int64_t)ETUX_TIMER_TICKS_PER_SEC; subsec++) {
+		int64_t         tick = (INT64_C(3) <<
+		                        ETUX_TIMER_TICK_SUBSEC_BITS) | subsec;
+		struct timespec tspec = etux_timer_tspec_from_tick(tick);
+
+		cute_check_sint(tspec.tv_sec, equal, 3);
+		cute_check_sint(tspec.tv_nsec, lower, 1000000000L);
+		cute_check_sint(etux_timer_tick_from_tspec_lower(&tspec),
+		                equal,
+		                tick);
+		cute_check_sint(etux_timer_tick_from_tspec_upper(&tspec),
+		                equal,
+		                tick);
+
+		if (tspec.tv_nsec) {
+			/* One nanosecond before the tick must not reach it. */
+			tspec.tv_nsec--;
+			cute_check_sint(
+				etux_timer_tick_from_tspec_lower(&tspec),
+				equal,
+				tick - 1);
+		}
+	}
+}
+
+/*
+ * Round nanoseconds up to the next tick boundary.
+ *
+ * Result may reach 1000000000 nanoseconds, i.e. carry to the seconds part.
+ */
+static long
+etuxut_timer_round_nsec(long nsec)
+{
+	return etux_timer_nsec_from_subsec(
+		etux_timer_subsec_from_nsec_upper(nsec));
+}
+
 static const struct timespec etuxut_clock[] = {
 	{
 		.tv_sec  = 0,
@@ -244,8 +289,7 @@ CUTE_TEST_STATIC(etuxut_timer_issue_msec,
 			struct timespec clk = etuxut_clock[c];
 			int             msec;
 
-			diff.tv_nsec = stroll_round_upper(diff.tv_nsec,
-			                                  ETUX_TIMER_TICK_NSEC);
+			diff.tv_nsec = etuxut_timer_round_nsec(diff.tv_nsec);
 			if (diff.tv_nsec >= 1000000000L) {
 				if (diff.tv_sec <
 				    (ETUX_TIMER_TICK_MAX >>
@@ -258,9 +302,9 @@ CUTE_TEST_STATIC(etuxut_timer_issue_msec,
 						ETUX_TIMER_TICK_MAX >>
 						ETUX_TIMER_TICK_SUBSEC_BITS;
 					diff.tv_nsec =
-						(ETUX_TIMER_TICK_MAX &
-						 ETUX_TIMER_TICK_SUBSEC_MASK) *
-						ETUX_TIMER_TICK_NSEC;
+						etux_timer_nsec_from_subsec(
+							ETUX_TIMER_TICK_MAX &
+							ETUX_TIMER_TICK_SUBSEC_MASK);
 				}
 			}
 			if (utime_tspec_sub(&diff, &clk) > 0)
@@ -498,8 +542,7 @@ CUTE_TEST_STATIC(etuxut_timer_arm_tspec,
 
 			tmr->expected = tmr->expire;
 			tmr->expected.tv_nsec =
-				stroll_round_upper(tmr->expected.tv_nsec,
-				                   ETUX_TIMER_TICK_NSEC);
+				etuxut_timer_round_nsec(tmr->expected.tv_nsec);
 			tmr->expected.tv_nsec =
 				stroll_round_upper(tmr->expected.tv_nsec,
 				                   msecs[m] * 1000000);
@@ -732,8 +775,1021 @@ CUTE_TEST_STATIC(etuxut_timer_cancel,
 	}
 }
 
+#if defined(CONFIG_UTILS_ASSERT_API)
+
+CUTE_TEST(etuxut_timer_base_assert)
+{
+	struct etux_timer_base base;
+	struct etux_timer      tmr = ETUX_TIMER_INIT(tmr, etuxut_timer_expire);
+	const struct timespec  exp = { 10, 0 };
+	struct timespec        tspec;
+	int                    ret __unused;
+
+	cute_expect_assertion(etux_timer_base_init(NULL));
+	cute_expect_assertion(etux_timer_base_fini(NULL));
+	cute_expect_assertion(etux_timer_base_arm_tspec(NULL, &tmr, &exp));
+	cute_expect_assertion(etux_timer_base_arm_msec(NULL, &tmr, 10));
+	cute_expect_assertion(etux_timer_base_arm_sec(NULL, &tmr, 10));
+	cute_expect_assertion(etux_timer_base_cancel(NULL, &tmr));
+	cute_expect_assertion(ret = etux_timer_base_issue_msec(NULL));
+	cute_expect_assertion(
+		ret = !!etux_timer_base_issue_tspec(NULL, &tspec));
+	cute_expect_assertion(etux_timer_base_run(NULL));
+
+	etux_timer_base_init(&base);
+	cute_expect_assertion(etux_timer_base_cancel(&base, NULL));
+	etux_timer_base_fini(&base);
+}
+
+#else  /* !defined(CONFIG_UTILS_ASSERT_API) */
+
+UTILSUT_NOASSERT_TEST(etuxut_timer_base_assert)
+
+#endif /* defined(CONFIG_UTILS_ASSERT_API) */
+
+static struct etux_timer_base etuxut_bases[2];
+
+static void
+etuxut_timer_setup_base(void)
+{
+	const struct timespec clk = { .tv_sec = 0, .tv_nsec = 0 };
+	unsigned int          b;
+
+	etuxpt_timer_clock_expect(&clk);
+	for (b = 0; b < stroll_array_nr(etuxut_bases); b++) {
+		etux_timer_base_init(&etuxut_bases[b]);
+		etux_timer_init(&etuxut_timers[b].base,
+		                etuxut_timer_expire_cancel);
+	}
+	etuxpt_timer_clock_expect(NULL);
+}
+
+static void
+etuxut_timer_teardown_base(void)
+{
+	unsigned int b;
+
+	for (b = 0; b < stroll_array_nr(etuxut_bases); b++) {
+		etux_timer_base_cancel(&etuxut_bases[b],
+		                       &etuxut_timers[b].base);
+		etux_timer_base_fini(&etuxut_bases[b]);
+	}
+
+	etuxpt_timer_clock_expect(NULL);
+}
+
+CUTE_TEST_STATIC(etuxut_timer_base,
+                 etuxut_timer_setup_base,
+                 etuxut_timer_teardown_base,
+                 CUTE_DFLT_TMOUT)
+{
+	struct timespec clk = { .tv_sec = 0, .tv_nsec = 0 };
+	unsigned int    b;
+
+	etuxpt_timer_clock_expect(&clk);
+	for (b = 0; b < stroll_array_nr(etuxut_bases); b++) {
+		const struct timespec exp = {
+			.tv_sec  = (time_t)b + 1,
+			.tv_nsec = 0
+		};
+
+		etux_timer_base_arm_tspec(&etuxut_bases[b],
+		                          &etuxut_timers[b].base,
+		                          &exp);
+		etuxut_timers[b].count = 1;
+	}
+
+	/* Timers armed onto private bases are not visible from default one. */
+	cute_check_sint(etux_timer_issue_msec(), equal, -1);
+	cute_check_sint(etux_timer_base_issue_msec(&etuxut_bases[0]),
+	                equal,
+	                1000);
+	cute_check_sint(etux_timer_base_issue_msec(&etuxut_bases[1]),
+	                equal,
+	                2000);
+
+	/* Running a base must not expire timers of another one. */
+	clk.tv_sec = 1;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(&etuxut_bases[1]);
+	cute_check_sint(etuxut_timers[0].count, equal, 1);
+	cute_check_bool(etux_timer_is_armed(&etuxut_timers[0].base),
+	                is,
+	                true);
+
+	etux_timer_base_run(&etuxut_bases[0]);
+	cute_check_sint(etuxut_timers[0].count, equal, 0);
+	cute_check_bool(etux_timer_is_armed(&etuxut_timers[0].base),
+	                is,
+	                false);
+	cute_check_sint(etux_timer_base_issue_msec(&etuxut_bases[0]),
+	                equal,
+	                -1);
+	cute_check_bool(etux_timer_is_armed(&etuxut_timers[1].base),
+	                is,
+	                true);
+
+	clk.tv_sec = 2;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(&etuxut_bases[1]);
+	etuxpt_timer_clock_expect(NULL);
+	cute_check_sint(etuxut_timers[1].count, equal, 0);
+	cute_check_bool(etux_timer_is_armed(&etuxut_timers[1].base),
+	                is,
+	                false);
+}
+
+CUTE_TEST_STATIC(etuxut_timer_base_past,
+                 etuxut_timer_setup_base,
+                 etuxut_timer_teardown_base,
+                 CUTE_DFLT_TMOUT)
+{
+	struct timespec       clk = { .tv_sec = 10, .tv_nsec = 0 };
+	const struct timespec exp = { .tv_sec = 5, .tv_nsec = 0 };
+
+	/* Let base time go forward first. */
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(&etuxut_bases[0]);
+
+	/* Timers armed in the past must expire at next run. */
+	etux_timer_base_arm_tspec(&etuxut_bases[0],
+	                          &etuxut_timers[0].base,
+	                          &exp);
+	etuxut_timers[0].count = 1;
+	cute_check_sint(etux_timer_base_issue_msec(&etuxut_bases[0]),
+	                equal,
+	                0);
+
+	clk.tv_nsec = 1000000L;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(&etuxut_bases[0]);
+	etuxpt_timer_clock_expect(NULL);
+	cute_check_sint(etuxut_timers[0].count, equal, 0);
+	cute_check_bool(etux_timer_is_armed(&etuxut_timers[0].base),
+	                is,
+	                false);
+}
+
+CUTE_TEST_STATIC(etuxut_timer_slack,
+                 etuxut_timer_setup_base,
+                 etuxut_timer_teardown_base,
+                 CUTE_DFLT_TMOUT)
+{
+	struct etux_timer_base * base = &etuxut_bases[0];
+	struct timespec          clk = { .tv_sec = 0, .tv_nsec = 0 };
+	const struct timespec    exp[] = {
+		{ .tv_sec = 5, .tv_nsec = 0 },
+		{ .tv_sec = 6, .tv_nsec = 0 }
+	};
+	unsigned int             t;
+
+	/*
+	 * Both timers may be delayed by up to 4 seconds: they must be
+	 * coalesced onto the 8 seconds tick.
+	 */
+	etuxpt_timer_clock_expect(&clk);
+	for (t = 0; t < stroll_array_nr(exp); t++) {
+		etux_timer_setup_slack_msec(&etuxut_timers[t].base, 4000);
+		etux_timer_base_arm_tspec(base, &etuxut_timers[t].base, &exp[t]);
+		etuxut_timers[t].count = 1;
+	}
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, 8000);
+
+	clk.tv_sec = 7;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(base);
+	for (t = 0; t < stroll_array_nr(exp); t++)
+		cute_check_sint(etuxut_timers[t].count, equal, 1);
+
+	clk.tv_sec = 8;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(base);
+	etuxpt_timer_clock_expect(NULL);
+	for (t = 0; t < stroll_array_nr(exp); t++) {
+		cute_check_sint(etuxut_timers[t].count, equal, 0);
+		etux_timer_setup_slack_msec(&etuxut_timers[t].base, 0);
+	}
+}
+
+static unsigned int etuxut_overrun;
+
+static void
+etuxut_timer_expire_period(struct etux_timer * __restrict timer)
+{
+	struct etuxut_timer * tmr = (struct etuxut_timer *)timer;
+
+	tmr->count++;
+	etuxut_overrun = etux_timer_overrun(timer);
+}
+
+CUTE_TEST_STATIC(etuxut_timer_period,
+                 etuxut_timer_setup_base,
+                 etuxut_timer_teardown_base,
+                 CUTE_DFLT_TMOUT)
+{
+	struct etux_timer_base * base = &etuxut_bases[0];
+	struct etuxut_timer *    tmr = &etuxut_timers[0];
+	struct timespec          clk = { .tv_sec = 0, .tv_nsec = 0 };
+	const struct timespec    exp = { .tv_sec = 1, .tv_nsec = 0 };
+
+	etux_timer_init(&tmr->base, etuxut_timer_expire_period);
+	etux_timer_setup_period_msec(&tmr->base, 1000);
+	tmr->count = 0;
+
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_arm_tspec(base, &tmr->base, &exp);
+
+	/* Timer must be rearmed relative to previous expiry. */
+	clk.tv_sec = 1;
+	clk.tv_nsec = 250000000L;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(base);
+	cute_check_sint(tmr->count, equal, 1);
+	cute_check_uint(etuxut_overrun, equal, 0);
+	cute_check_bool(etux_timer_is_armed(&tmr->base), is, true);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, 750);
+
+	/* Missed expiries must be reported as overrun. */
+	clk.tv_sec = 4;
+	clk.tv_nsec = 500000000L;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(base);
+	cute_check_sint(tmr->count, equal, 2);
+	cute_check_uint(etuxut_overrun, equal, 2);
+	cute_check_bool(etux_timer_is_armed(&tmr->base), is, true);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, 500);
+
+	etux_timer_base_cancel(base, &tmr->base);
+	cute_check_bool(etux_timer_is_armed(&tmr->base), is, false);
+	etuxpt_timer_clock_expect(NULL);
+
+	etux_timer_setup_period_msec(&tmr->base, 0);
+}
+
+static void
+etuxut_timer_expire_period_cancel(struct etux_timer * __restrict timer)
+{
+	struct etuxut_timer * tmr = (struct etuxut_timer *)timer;
+
+	tmr->count++;
+	etux_timer_base_cancel(&etuxut_bases[0], timer);
+}
+
+CUTE_TEST_STATIC(etuxut_timer_period_cancel,
+                 etuxut_timer_setup_base,
+                 etuxut_timer_teardown_base,
+                 CUTE_DFLT_TMOUT)
+{
+	struct etux_timer_base * base = &etuxut_bases[0];
+	struct etuxut_timer *    tmr = &etuxut_timers[0];
+	struct timespec          clk = { .tv_sec = 0, .tv_nsec = 0 };
+	const struct timespec    exp = { .tv_sec = 1, .tv_nsec = 0 };
+
+	etux_timer_init(&tmr->base, etuxut_timer_expire_period_cancel);
+	etux_timer_setup_period_msec(&tmr->base, 1000);
+	tmr->count = 0;
+
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_arm_tspec(base, &tmr->base, &exp);
+
+	/* Timer canceled from its own callback must not be rearmed. */
+	clk.tv_sec = 1;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(base);
+	cute_check_sint(tmr->count, equal, 1);
+	cute_check_bool(etux_timer_is_armed(&tmr->base), is, false);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, -1);
+
+	/* And must never fire again. */
+	clk.tv_sec = 10;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(base);
+	etuxpt_timer_clock_expect(NULL);
+	cute_check_sint(tmr->count, equal, 1);
+	cute_check_bool(etux_timer_is_armed(&tmr->base), is, false);
+
+	etux_timer_setup_period_msec(&tmr->base, 0);
+}
+
+static struct etuxut_timer etuxut_timers_many[4];
+
+static void
+etuxut_timer_setup_many(void)
+{
+	const struct timespec clk = { .tv_sec = 0, .tv_nsec = 0 };
+	unsigned int          t;
+
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_init(&etuxut_bases[0]);
+	for (t = 0; t < stroll_array_nr(etuxut_timers_many); t++) {
+		etux_timer_init(&etuxut_timers_many[t].base,
+		                etuxut_timer_expire_cancel);
+		etuxut_timers_many[t].count = 0;
+	}
+	etuxpt_timer_clock_expect(NULL);
+}
+
+static void
+etuxut_timer_teardown_many(void)
+{
+	unsigned int t;
+
+	for (t = 0; t < stroll_array_nr(etuxut_timers_many); t++)
+		etux_timer_base_cancel(&etuxut_bases[0],
+		                       &etuxut_timers_many[t].base);
+	etux_timer_base_fini(&etuxut_bases[0]);
+
+	etuxpt_timer_clock_expect(NULL);
+}
+
+CUTE_TEST_STATIC(etuxut_timer_many,
+                 etuxut_timer_setup_many,
+                 etuxut_timer_teardown_many,
+                 CUTE_DFLT_TMOUT)
+{
+	struct etux_timer_base * base = &etuxut_bases[0];
+	struct etux_timer *      tmrs[stroll_array_nr(etuxut_timers_many)];
+	struct timespec          clk = { .tv_sec = 10, .tv_nsec = 0 };
+	const struct timespec    exp = { .tv_sec = 12, .tv_nsec = 0 };
+	unsigned int             t;
+
+	for (t = 0; t < stroll_array_nr(tmrs); t++)
+		tmrs[t] = &etuxut_timers_many[t].base;
+
+	/* All timers must be armed relative to the same clock sample. */
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_arm_many_msec(base, tmrs, stroll_array_nr(tmrs), 1000);
+	for (t = 0; t < stroll_array_nr(tmrs); t++) {
+		cute_check_bool(etux_timer_is_armed(tmrs[t]), is, true);
+		cute_check_sint(etux_timer_expiry_tspec(tmrs[t])->tv_sec,
+		                equal,
+		                11);
+		cute_check_sint(etux_timer_expiry_tspec(tmrs[t])->tv_nsec,
+		                equal,
+		                0);
+		etuxut_timers_many[t].count = 1;
+	}
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, 1000);
+
+	/* Cancel a subset of timers. */
+	etux_timer_base_cancel_many(base, &tmrs[1], 2);
+	cute_check_bool(etux_timer_is_armed(tmrs[0]), is, true);
+	cute_check_bool(etux_timer_is_armed(tmrs[1]), is, false);
+	cute_check_bool(etux_timer_is_armed(tmrs[2]), is, false);
+	cute_check_bool(etux_timer_is_armed(tmrs[3]), is, true);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, 1000);
+
+	/* Batches may mix idle and pending timers. */
+	etux_timer_base_arm_many_tspec(base, &tmrs[2], 2, &exp);
+	etuxut_timers_many[2].count = 1;
+	cute_check_bool(etux_timer_is_armed(tmrs[2]), is, true);
+	cute_check_bool(etux_timer_is_armed(tmrs[3]), is, true);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, 1000);
+
+	clk.tv_sec = 11;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(base);
+	cute_check_sint(etuxut_timers_many[0].count, equal, 0);
+	cute_check_sint(etuxut_timers_many[2].count, equal, 1);
+	cute_check_sint(etuxut_timers_many[3].count, equal, 1);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, 1000);
+
+	etux_timer_base_arm_many_sec(base, tmrs, 1, 2);
+	etuxut_timers_many[0].count = 1;
+
+	clk.tv_sec = 12;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(base);
+	cute_check_sint(etuxut_timers_many[0].count, equal, 1);
+	cute_check_sint(etuxut_timers_many[2].count, equal, 0);
+	cute_check_sint(etuxut_timers_many[3].count, equal, 0);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, 1000);
+
+	/* Cancelling idle timers is harmless. */
+	etux_timer_base_cancel_many(base, tmrs, stroll_array_nr(tmrs));
+	for (t = 0; t < stroll_array_nr(tmrs); t++)
+		cute_check_bool(etux_timer_is_armed(tmrs[t]), is, false);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, -1);
+	etuxpt_timer_clock_expect(NULL);
+}
+
+#if defined(CONFIG_ETUX_TIMER_CLOCK_CACHE)
+
+static void
+etuxut_timer_check_expiry(const struct etux_timer * __restrict timer,
+                          time_t                               sec,
+                          long                                 nsec)
+{
+	cute_check_sint(etux_timer_expiry_tspec(timer)->tv_sec, equal, sec);
+	cute_check_sint(etux_timer_expiry_tspec(timer)->tv_nsec, equal, nsec);
+}
+
+CUTE_TEST_STATIC(etuxut_timer_clock,
+                 etuxut_timer_setup_base,
+                 etuxut_timer_teardown_base,
+                 CUTE_DFLT_TMOUT)
+{
+	struct etux_timer_base * base = &etuxut_bases[0];
+	struct etux_timer *      tmr = &etuxut_timers[0].base;
+	struct timespec          clk = { .tv_sec = 10, .tv_nsec = 0 };
+
+	/* Cached clock is sampled at setup time... */
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_setup_clock(base, ETUX_TIMER_CACHED_CLOCK);
+
+	/* ...so that arming does not read the clock. */
+	clk.tv_nsec = 500000000L;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_arm_msec(base, tmr, 1000);
+	etuxut_timer_check_expiry(tmr, 11, 0);
+
+	etux_timer_base_refresh_clock(base);
+	etux_timer_base_arm_msec(base, tmr, 1000);
+	etuxut_timer_check_expiry(tmr, 11, 500000000L);
+
+	/* Running base refreshes cached clock as well. */
+	clk.tv_sec = 11;
+	clk.tv_nsec = 250000000L;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(base);
+	clk.tv_nsec = 750000000L;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_arm_many_sec(base, &tmr, 1, 2);
+	etuxut_timer_check_expiry(tmr, 13, 250000000L);
+
+	/* Coarse clock is read at arming time. */
+	etux_timer_base_setup_clock(base, ETUX_TIMER_COARSE_CLOCK);
+	etux_timer_base_arm_sec(base, tmr, 1);
+	etuxut_timer_check_expiry(tmr, 12, 750000000L);
+
+	etux_timer_base_setup_clock(base, ETUX_TIMER_PRECISE_CLOCK);
+	clk.tv_sec = 12;
+	clk.tv_nsec = 0;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_arm_msec(base, tmr, 500);
+	etuxut_timer_check_expiry(tmr, 12, 500000000L);
+
+	etux_timer_base_cancel(base, tmr);
+	etuxpt_timer_clock_expect(NULL);
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_CLOCK_CACHE) */
+
+#if defined(ETUX_TIMER_UTEST_HEAP) && defined(CONFIG_ETUX_TIMER_HEAP_LAZY)
+
+CUTE_TEST_STATIC(etuxut_timer_lazy,
+                 etuxut_timer_setup_many,
+                 etuxut_timer_teardown_many,
+                 CUTE_DFLT_TMOUT)
+{
+	struct etux_timer_base * base = &etuxut_bases[0];
+	struct etux_timer *      tmrs[stroll_array_nr(etuxut_timers_many)];
+	struct timespec          clk = { .tv_sec = 10, .tv_nsec = 0 };
+	unsigned int             t;
+
+	for (t = 0; t < stroll_array_nr(tmrs); t++)
+		tmrs[t] = &etuxut_timers_many[t].base;
+
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_setup_lazy(base, 50);
+	for (t = 0; t < stroll_array_nr(tmrs); t++)
+		etux_timer_base_arm_sec(base, tmrs[t], (int)t + 1);
+	cute_check_uint(base->lazy.nodes, equal, 4);
+
+	/* Canceled timers are kept into the heap... */
+	etux_timer_base_cancel(base, tmrs[1]);
+	cute_check_bool(etux_timer_is_armed(tmrs[1]), is, false);
+	cute_check_uint(base->lazy.nodes, equal, 4);
+	cute_check_uint(base->lazy.dead, equal, 1);
+
+	/* ...and moved within the heap when re-armed. */
+	etux_timer_base_arm_msec(base, tmrs[1], 0);
+	cute_check_bool(etux_timer_is_armed(tmrs[1]), is, true);
+	cute_check_uint(base->lazy.nodes, equal, 4);
+	cute_check_uint(base->lazy.dead, equal, 0);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, 0);
+
+	/* Dead timers reaching the heap top are removed. */
+	etux_timer_base_cancel(base, tmrs[1]);
+	etux_timer_base_cancel(base, tmrs[0]);
+	cute_check_uint(base->lazy.dead, equal, 2);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, 3000);
+	cute_check_uint(base->lazy.nodes, equal, 2);
+	cute_check_uint(base->lazy.dead, equal, 0);
+
+	/* Heap is compacted once dead timers exceed the configured ratio. */
+	etux_timer_base_cancel(base, tmrs[3]);
+	etux_timer_base_arm_sec(base, tmrs[0], 5);
+	etux_timer_base_cancel(base, tmrs[0]);
+	cute_check_uint(base->lazy.nodes, equal, 3);
+	cute_check_uint(base->lazy.dead, equal, 2);
+	clk.tv_sec = 12;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(base);
+	cute_check_uint(base->lazy.nodes, equal, 1);
+	cute_check_uint(base->lazy.dead, equal, 0);
+	cute_check_bool(etux_timer_is_armed(tmrs[2]), is, true);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, 1000);
+
+	/* Detaching removes dead timers from the heap. */
+	etux_timer_base_cancel(base, tmrs[2]);
+	etux_timer_base_detach(base, tmrs[2]);
+	cute_check_uint(base->lazy.nodes, equal, 0);
+	cute_check_uint(base->lazy.dead, equal, 0);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, -1);
+
+	/* Disabling lazy cancelation removes all dead timers. */
+	etux_timer_base_arm_many_msec(base, tmrs, 2, 1000);
+	etux_timer_base_cancel_many(base, tmrs, 2);
+	cute_check_uint(base->lazy.dead, equal, 2);
+	etux_timer_base_setup_lazy(base, 0);
+	cute_check_uint(base->lazy.nodes, equal, 0);
+	cute_check_uint(base->lazy.dead, equal, 0);
+
+	etux_timer_base_arm_msec(base, tmrs[0], 1000);
+	etux_timer_base_cancel(base, tmrs[0]);
+	cute_check_uint(base->lazy.nodes, equal, 0);
+	etuxpt_timer_clock_expect(NULL);
+}
+
+#endif /* defined(ETUX_TIMER_UTEST_HEAP) && ... */
+
+#if defined(CONFIG_ETUX_TIMER_STATS)
+
+CUTE_TEST_STATIC(etuxut_timer_stats,
+                 etuxut_timer_setup_base,
+                 etuxut_timer_teardown_base,
+                 CUTE_DFLT_TMOUT)
+{
+	struct etux_timer_base * base = &etuxut_bases[0];
+	struct etux_timer_stats  stats;
+	struct timespec          clk = { .tv_sec = 0, .tv_nsec = 0 };
+	const struct timespec    exp[] = {
+		{ .tv_sec = 1, .tv_nsec = 0 },
+		{ .tv_sec = 2, .tv_nsec = 0 }
+	};
+	struct timespec          late;
+	unsigned int             t;
+
+	etuxpt_timer_clock_expect(&clk);
+	for (t = 0; t < stroll_array_nr(exp); t++) {
+		etux_timer_base_arm_tspec(base, &etuxut_timers[t].base, &exp[t]);
+		etuxut_timers[t].count = 1;
+	}
+	/* Rearming a pending timer must not account for a new pending one. */
+	etux_timer_base_arm_tspec(base, &etuxut_timers[0].base, &exp[0]);
+
+	etux_timer_base_get_stats(base, &stats);
+	cute_check_uint(stats.arms, equal, 3);
+	cute_check_uint(stats.pending, equal, 2);
+
+	etux_timer_base_cancel(base, &etuxut_timers[1].base);
+	etux_timer_base_get_stats(base, &stats);
+	cute_check_uint(stats.cancels, equal, 1);
+	cute_check_uint(stats.pending, equal, 1);
+
+	/* Run 3 ticks late. */
+	clk = etux_timer_tspec_from_tick(
+		etux_timer_tick_from_tspec_upper(&exp[0]) + 3);
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(base);
+	etuxpt_timer_clock_expect(NULL);
+	cute_check_sint(etuxut_timers[0].count, equal, 0);
+
+	etux_timer_base_get_stats(base, &stats);
+	cute_check_uint(stats.expiries, equal, 1);
+	cute_check_uint(stats.pending, equal, 0);
+	cute_check_uint(stats.lateness[3], equal, 1);
+	for (t = 0; t < stroll_array_nr(stats.lateness); t++) {
+		if (t != 3)
+			cute_check_uint(stats.lateness[t], equal, 0);
+	}
+
+	/* Check log-linear buckets lower bounds. */
+	etux_timer_stats_bucket_tspec(3, &late);
+	cute_check_sint(etux_timer_tick_from_tspec_lower(&late), equal, 3);
+	etux_timer_stats_bucket_tspec(4, &late);
+	cute_check_sint(etux_timer_tick_from_tspec_lower(&late), equal, 4);
+	etux_timer_stats_bucket_tspec(8, &late);
+	cute_check_sint(etux_timer_tick_from_tspec_lower(&late), equal, 8);
+	etux_timer_stats_bucket_tspec(11, &late);
+	cute_check_sint(etux_timer_tick_from_tspec_lower(&late), equal, 14);
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_STATS) */
+
+#if defined(ETUX_TIMER_UTEST_HWHEEL)
+
+static void
+etuxut_timer_setup_geometry(void)
+{
+	const struct timespec clk = { .tv_sec = 0, .tv_nsec = 0 };
+	unsigned int          b;
+
+	etuxpt_timer_clock_expect(&clk);
+
+	/* Tiny wheel with the finest resolution: relies on eternal list. */
+	cute_check_sint(etux_timer_base_init_hwheel(&etuxut_bases[0], 3, 2, 0),
+	                equal,
+	                0);
+	/*
+	 * 1 second resolution wheel, large enough to require slots
+	 * allocation.
+	 */
+	cute_check_sint(etux_timer_base_init_hwheel(
+	                        &etuxut_bases[1],
+	                        6,
+	                        6,
+	                        CONFIG_ETUX_TIMER_SUBSEC_BITS),
+	                equal,
+	                0);
+
+	for (b = 0; b < stroll_array_nr(etuxut_bases); b++)
+		etux_timer_init(&etuxut_timers[b].base,
+		                etuxut_timer_expire_cancel);
+
+	etuxpt_timer_clock_expect(NULL);
+}
+
+CUTE_TEST_STATIC(etuxut_timer_geometry,
+                 etuxut_timer_setup_geometry,
+                 etuxut_timer_teardown_base,
+                 CUTE_DFLT_TMOUT)
+{
+	struct timespec       clk = { .tv_sec = 0, .tv_nsec = 0 };
+	const struct timespec exp[] = {
+		{ .tv_sec = 3, .tv_nsec = 0 },
+		{ .tv_sec = 1, .tv_nsec = 500000000L }
+	};
+	unsigned int          b;
+
+	etuxpt_timer_clock_expect(&clk);
+	for (b = 0; b < stroll_array_nr(etuxut_bases); b++) {
+		etux_timer_base_arm_tspec(&etuxut_bases[b],
+		                          &etuxut_timers[b].base,
+		                          &exp[b]);
+		etuxut_timers[b].count = 1;
+	}
+
+	/* Expiry must be rounded up to the 1 second wheel tick. */
+	cute_check_sint(etux_timer_base_issue_msec(&etuxut_bases[0]),
+	                equal,
+	                3000);
+	cute_check_sint(etux_timer_base_issue_msec(&etuxut_bases[1]),
+	                equal,
+	                2000);
+
+	clk.tv_sec = 1;
+	clk.tv_nsec = 500000000L;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(&etuxut_bases[1]);
+	cute_check_sint(etuxut_timers[1].count, equal, 1);
+	cute_check_bool(etux_timer_is_armed(&etuxut_timers[1].base),
+	                is,
+	                true);
+
+	clk.tv_sec = 2;
+	clk.tv_nsec = 0;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(&etuxut_bases[0]);
+	etux_timer_base_run(&etuxut_bases[1]);
+	cute_check_sint(etuxut_timers[0].count, equal, 1);
+	cute_check_sint(etuxut_timers[1].count, equal, 0);
+	cute_check_sint(etux_timer_base_issue_msec(&etuxut_bases[0]),
+	                equal,
+	                1000);
+	cute_check_sint(etux_timer_base_issue_msec(&etuxut_bases[1]),
+	                equal,
+	                -1);
+
+	clk.tv_sec = 3;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(&etuxut_bases[0]);
+	etuxpt_timer_clock_expect(NULL);
+	cute_check_sint(etuxut_timers[0].count, equal, 0);
+	cute_check_bool(etux_timer_is_armed(&etuxut_timers[0].base),
+	                is,
+	                false);
+}
+
+CUTE_TEST_STATIC(etuxut_timer_eternal,
+                 etuxut_timer_setup_geometry,
+                 etuxut_timer_teardown_base,
+                 CUTE_DFLT_TMOUT)
+{
+	struct etux_timer_base * base = &etuxut_bases[0];
+	struct timespec          clk = { .tv_sec = 0, .tv_nsec = 0 };
+	const struct timespec    exp[] = {
+		{ .tv_sec = 20, .tv_nsec = 0 },
+		{ .tv_sec = 10, .tv_nsec = 0 }
+	};
+	unsigned int             t;
+
+	/*
+	 * Unless ticks are very coarse, both timers are beyond tiny wheel
+	 * range: they must be eternal.
+	 */
+	etuxpt_timer_clock_expect(&clk);
+	for (t = 0; t < stroll_array_nr(exp); t++) {
+		etux_timer_base_arm_tspec(base, &etuxut_timers[t].base, &exp[t]);
+		etuxut_timers[t].count = 1;
+	}
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, 10000);
+#if defined(CONFIG_ETUX_TIMER_STATS) && (ETUX_TIMER_TICK_SUBSEC_BITS >= 3)
+	cute_check_uint(base->stats.eternals, equal, 2);
+#endif /* defined(CONFIG_ETUX_TIMER_STATS) && ... */
+
+	etux_timer_base_cancel(base, &etuxut_timers[1].base);
+	cute_check_bool(etux_timer_is_armed(&etuxut_timers[1].base),
+	                is,
+	                false);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, 20000);
+
+	clk.tv_sec = 19;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(base);
+	cute_check_sint(etuxut_timers[0].count, equal, 1);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, 1000);
+
+	clk.tv_sec = 20;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(base);
+	etuxpt_timer_clock_expect(NULL);
+	cute_check_sint(etuxut_timers[0].count, equal, 0);
+	cute_check_sint(etuxut_timers[1].count, equal, 1);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, -1);
+#if defined(CONFIG_ETUX_TIMER_STATS) && (ETUX_TIMER_TICK_SUBSEC_BITS >= 3)
+	cute_check_uint(base->stats.eternals, equal, 0);
+	cute_check_uint(base->stats.migrations, equal, 1);
+#endif /* defined(CONFIG_ETUX_TIMER_STATS) && ... */
+}
+
+#endif /* defined(ETUX_TIMER_UTEST_HWHEEL) */
+
+#if defined(CONFIG_ETUX_TIMER_REMOTE)
+
+#include <poll.h>
+
+static bool
+etuxut_timer_kick_pending(int fd)
+{
+	struct pollfd pfd = { .fd = fd, .events = POLLIN };
+
+	return poll(&pfd, 1, 0) == 1;
+}
+
+#if defined(CONFIG_UTILS_ASSERT_API)
+
+CUTE_TEST(etuxut_timer_remote_assert)
+{
+	struct etux_timer_base base;
+	struct etux_timer      tmr = ETUX_TIMER_INIT(tmr,
+	                                             etuxut_timer_expire_cancel);
+	const struct timespec  exp = { .tv_sec = 1, .tv_nsec = 0 };
+	int                    ret __unused;
+
+	cute_expect_assertion(etux_timer_base_remote_arm_tspec(NULL,
+	                                                       &tmr,
+	                                                       &exp));
+	cute_expect_assertion(etux_timer_base_remote_arm_tspec(&base,
+	                                                       NULL,
+	                                                       &exp));
+	cute_expect_assertion(etux_timer_base_remote_arm_tspec(&base,
+	                                                       &tmr,
+	                                                       NULL));
+	cute_expect_assertion(etux_timer_base_remote_arm_msec(&base, &tmr, -1));
+	cute_expect_assertion(etux_timer_base_remote_arm_sec(&base, &tmr, -1));
+	cute_expect_assertion(etux_timer_base_remote_cancel(NULL, &tmr));
+	cute_expect_assertion(etux_timer_base_remote_cancel(&base, NULL));
+	cute_expect_assertion(ret = etux_timer_base_open_kick(NULL));
+	cute_expect_assertion(etux_timer_base_close_kick(NULL));
+}
+
+#else  /* !defined(CONFIG_UTILS_ASSERT_API) */
+
+UTILSUT_NOASSERT_TEST(etuxut_timer_remote_assert)
+
+#endif /* defined(CONFIG_UTILS_ASSERT_API) */
+
+CUTE_TEST_STATIC(etuxut_timer_remote,
+                 etuxut_timer_setup_base,
+                 etuxut_timer_teardown_base,
+                 CUTE_DFLT_TMOUT)
+{
+	struct etux_timer_base * base = &etuxut_bases[0];
+	struct etux_timer *      tmr = &etuxut_timers[0].base;
+	struct timespec          clk = { .tv_sec = 0, .tv_nsec = 0 };
+	const struct timespec    exp = { .tv_sec = 1, .tv_nsec = 0 };
+	int                      fd;
+
+	etuxpt_timer_clock_expect(&clk);
+
+	/* Remote requests are not applied until base is run. */
+	etux_timer_base_remote_arm_tspec(base, tmr, &exp);
+	etuxut_timers[0].count = 1;
+	cute_check_bool(etux_timer_is_armed(tmr), is, false);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, -1);
+
+	/* Opening kick while requests are pending must wake owner up. */
+	fd = etux_timer_base_open_kick(base);
+	cute_check_sint(fd, greater_equal, 0);
+	cute_check_bool(etuxut_timer_kick_pending(fd), is, true);
+
+	etux_timer_base_run(base);
+	cute_check_bool(etuxut_timer_kick_pending(fd), is, false);
+	cute_check_bool(etux_timer_is_armed(tmr), is, true);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, 1000);
+
+	/* Latest request wins. */
+	etux_timer_base_remote_arm_sec(base, tmr, 2);
+	cute_check_bool(etuxut_timer_kick_pending(fd), is, true);
+	etux_timer_base_remote_cancel(base, tmr);
+	etux_timer_base_run(base);
+	cute_check_bool(etux_timer_is_armed(tmr), is, false);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, -1);
+
+	etux_timer_base_remote_arm_tspec(base, tmr, &exp);
+	etux_timer_base_run(base);
+	cute_check_bool(etux_timer_is_armed(tmr), is, true);
+	cute_check_sint(etuxut_timers[0].count, equal, 1);
+
+	clk.tv_sec = 1;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(base);
+	etuxpt_timer_clock_expect(NULL);
+	cute_check_bool(etux_timer_is_armed(tmr), is, false);
+	cute_check_sint(etuxut_timers[0].count, equal, 0);
+
+	etux_timer_base_close_kick(base);
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_REMOTE) */
+
+#if defined(CONFIG_ETUX_TIMER_POOL)
+
+static pthread_t etuxut_timer_pool_thread;
+
+static void
+etuxut_timer_expire_pool(struct etux_timer * __restrict timer)
+{
+	struct etuxut_timer * tmr = (struct etuxut_timer *)timer;
+
+	/* Published to the main thread by completion reporting. */
+	etuxut_timer_pool_thread = pthread_self();
+	tmr->count++;
+}
+
+static void
+etuxut_timer_pool_wait(struct etux_timer_base * __restrict base)
+{
+	while (etux_timer_base_pool_busy(base)) {
+		uthr_yield();
+		etux_timer_base_run(base);
+	}
+}
+
+CUTE_TEST_STATIC(etuxut_timer_pool,
+                 etuxut_timer_setup_base,
+                 etuxut_timer_teardown_base,
+                 CUTE_DFLT_TMOUT)
+{
+	struct etux_timer_base * base = &etuxut_bases[0];
+	struct etux_timer *      tmr = &etuxut_timers[0].base;
+	struct etux_timer *      per = &etuxut_timers[1].base;
+	struct etux_timer_pool   pool;
+	struct timespec          clk = { .tv_sec = 10, .tv_nsec = 0 };
+	const struct timespec    exp = { .tv_sec = 11, .tv_nsec = 0 };
+
+	cute_check_sint(etux_timer_pool_init(&pool, 2), equal, 0);
+
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_setup_pool(base, &pool);
+
+	etux_timer_setup(tmr, etuxut_timer_expire_pool);
+	etux_timer_setup(per, etuxut_timer_expire_pool);
+	etux_timer_setup_period_msec(per, 1000);
+	etuxut_timers[0].count = 0;
+	etuxut_timers[1].count = 0;
+	etux_timer_base_arm_tspec(base, tmr, &exp);
+	etux_timer_base_arm_tspec(base, per, &exp);
+
+	/*
+	 * Expired timers are handed over to the pool and keep running until
+	 * completion is applied by the base owner.
+	 */
+	clk.tv_sec = 11;
+	etuxpt_timer_clock_expect(&clk);
+	etux_timer_base_run(base);
+	cute_check_uint(etux_timer_base_pool_busy(base), equal, 2);
+	cute_check_bool(etux_timer_is_armed(tmr), is, false);
+	cute_check_bool(etux_timer_is_armed(per), is, false);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, -1);
+
+#if defined(CONFIG_UTILS_ASSERT_API)
+	/* Timers owned by the pool may not be operated through their base. */
+	cute_expect_assertion(etux_timer_base_arm_tspec(base, tmr, &exp));
+	cute_expect_assertion(etux_timer_base_arm_msec(base, tmr, 1000));
+	cute_expect_assertion(etux_timer_base_arm_sec(base, per, 1));
+	cute_expect_assertion(etux_timer_base_cancel(base, per));
+#endif /* defined(CONFIG_UTILS_ASSERT_API) */
+
+	etuxut_timer_pool_wait(base);
+	cute_check_sint(etuxut_timers[0].count, equal, 1);
+	cute_check_sint(etuxut_timers[1].count, equal, 1);
+	cute_check_sint(pthread_equal(etuxut_timer_pool_thread, pthread_self()),
+	                equal,
+	                0);
+
+	/* One-shot timer is idle whereas periodic one is re-armed. */
+	cute_check_bool(etux_timer_is_armed(tmr), is, false);
+	cute_check_bool(etux_timer_is_armed(per), is, true);
+	cute_check_sint(etux_timer_expiry_tspec(per)->tv_sec, equal, 12);
+	cute_check_sint(etux_timer_base_issue_msec(base), equal, 1000);
+
+	etux_timer_base_cancel(base, per);
+	etux_timer_setup_period_msec(per, 0);
+	etux_timer_base_setup_pool(base, NULL);
+	etux_timer_pool_fini(&pool);
+	etuxpt_timer_clock_expect(NULL);
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_POOL) */
+
+#if defined(CONFIG_ETUX_TIMER_POLL)
+
+static struct upoll           etuxut_poller;
+static struct etux_timer_poll etuxut_tpoll;
+
+static void
+etuxut_timer_setup_poll(void)
+{
+	int err;
+
+	/* Use real clock since timerfd relies upon kernel's clock. */
+	etuxpt_timer_clock_expect(NULL);
+
+	etux_timer_base_init(&etuxut_bases[0]);
+	etux_timer_init(&etuxut_timers[0].base, etuxut_timer_expire_cancel);
+
+	err = upoll_open(&etuxut_poller, 2);
+	cute_check_sint(err, equal, 0);
+
+	err = etux_timer_base_poll_open(&etuxut_tpoll,
+	                                &etuxut_bases[0],
+	                                &etuxut_poller);
+	cute_check_sint(err, equal, 0);
+}
+
+static void
+etuxut_timer_teardown_poll(void)
+{
+	etux_timer_poll_close(&etuxut_tpoll, &etuxut_poller);
+	upoll_close(&etuxut_poller);
+
+	etux_timer_base_cancel(&etuxut_bases[0], &etuxut_timers[0].base);
+	etux_timer_base_fini(&etuxut_bases[0]);
+}
+
+CUTE_TEST_STATIC(etuxut_timer_poll,
+                 etuxut_timer_setup_poll,
+                 etuxut_timer_teardown_poll,
+                 CUTE_DFLT_TMOUT)
+{
+	struct timespec start;
+	struct timespec now;
+	unsigned int    loops = 0;
+
+	utime_monotonic_now(&start);
+
+	etux_timer_base_arm_msec(&etuxut_bases[0],
+	                         &etuxut_timers[0].base,
+	                         20);
+	etuxut_timers[0].count = 1;
+
+	while (etuxut_timers[0].count && (loops++ < 8))
+		cute_check_sint(etux_timer_poll_process(&etuxut_tpoll,
+		                                        &etuxut_poller),
+		                equal,
+		                0);
+
+	utime_monotonic_now(&now);
+	utime_tspec_sub(&now, &start);
+
+	cute_check_sint(etuxut_timers[0].count, equal, 0);
+	cute_check_bool(etux_timer_is_armed(&etuxut_timers[0].base),
+	                is,
+	                false);
+	cute_check_sint(utime_msec_from_tspec_upper(&now), greater_equal, 20);
+
+	/* Timerfd must be disarmed once no more timers are pending. */
+	cute_check_sint(etuxut_tpoll.tick, equal, -1);
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_POLL) */
+
 CUTE_GROUP(etuxut_timer_group) = {
 	CUTE_REF(etuxut_timer_monotonic_now),
+	CUTE_REF(etuxut_timer_tick_conv),
 
 	CUTE_REF(etuxut_timer_is_armed_assert),
 	CUTE_REF(etuxut_timer_is_armed),
@@ -746,6 +1802,42 @@ CUTE_GROUP(etuxut_timer_group) = {
 
 	CUTE_REF(etuxut_timer_cancel_assert),
 	CUTE_REF(etuxut_timer_cancel),
+
+	CUTE_REF(etuxut_timer_base_assert),
+	CUTE_REF(etuxut_timer_base),
+	CUTE_REF(etuxut_timer_base_past),
+	CUTE_REF(etuxut_timer_slack),
+	CUTE_REF(etuxut_timer_period),
+	CUTE_REF(etuxut_timer_period_cancel),
+	CUTE_REF(etuxut_timer_many),
+#if defined(CONFIG_ETUX_TIMER_CLOCK_CACHE)
+	CUTE_REF(etuxut_timer_clock),
+#endif /* defined(CONFIG_ETUX_TIMER_CLOCK_CACHE) */
+#if defined(ETUX_TIMER_UTEST_HEAP) && defined(CONFIG_ETUX_TIMER_HEAP_LAZY)
+	CUTE_REF(etuxut_timer_lazy),
+#endif /* defined(ETUX_TIMER_UTEST_HEAP) && ... */
+
+#if defined(CONFIG_ETUX_TIMER_STATS)
+	CUTE_REF(etuxut_timer_stats),
+#endif /* defined(CONFIG_ETUX_TIMER_STATS) */
+
+#if defined(ETUX_TIMER_UTEST_HWHEEL)
+	CUTE_REF(etuxut_timer_geometry),
+	CUTE_REF(etuxut_timer_eternal),
+#endif /* defined(ETUX_TIMER_UTEST_HWHEEL) */
+
+#if defined(CONFIG_ETUX_TIMER_REMOTE)
+	CUTE_REF(etuxut_timer_remote_assert),
+	CUTE_REF(etuxut_timer_remote),
+#endif /* defined(CONFIG_ETUX_TIMER_REMOTE) */
+
+#if defined(CONFIG_ETUX_TIMER_POOL)
+	CUTE_REF(etuxut_timer_pool),
+#endif /* defined(CONFIG_ETUX_TIMER_POOL) */
+
+#if defined(CONFIG_ETUX_TIMER_POLL)
+	CUTE_REF(etuxut_timer_poll),
+#endif /* defined(CONFIG_ETUX_TIMER_POLL) */
 };
 
 CUTE_SUITE_STATIC(etuxut_timer_suite,
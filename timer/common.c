@@ -59,7 +59,7 @@ etux_timer_tick_from_tspec_lower(const struct timespec * __restrict tspec)
 	 * rounded to upper multiple of tick period.
 	 */
 	return ((int64_t)tspec->tv_sec << ETUX_TIMER_TICK_SUBSEC_BITS) |
-	       ((int64_t)tspec->tv_nsec / (int64_t)ETUX_TIMER_TICK_NSEC);
+	       etux_timer_subsec_from_nsec_lower(tspec->tv_nsec);
 }
 
 int64_t
@@ -72,9 +72,7 @@ etux_timer_tick_from_tspec_upper(const struct timespec * __restrict tspec)
 
 		if (!etux_timer_int64_add_overflow(
 			(int64_t)tspec->tv_sec << ETUX_TIMER_TICK_SUBSEC_BITS,
-			((int64_t)tspec->tv_nsec +
-			 (int64_t)ETUX_TIMER_TICK_NSEC - 1) /
-			(int64_t)ETUX_TIMER_TICK_NSEC,
+			etux_timer_subsec_from_nsec_upper(tspec->tv_nsec),
 			&tick))
 		return tick;
 	}
@@ -95,7 +93,7 @@ etux_timer_tick_from_tspec_lower(const struct timespec * __restrict tspec)
 	 * rounded to upper multiple of tick period.
 	 */
 	return ((int64_t)tspec->tv_sec << ETUX_TIMER_TICK_SUBSEC_BITS) |
-	       ((int64_t)tspec->tv_nsec / (int64_t)ETUX_TIMER_TICK_NSEC);
+	       etux_timer_subsec_from_nsec_lower(tspec->tv_nsec);
 }
 
 int64_t
@@ -109,9 +107,7 @@ etux_timer_tick_from_tspec_upper(const struct timespec * __restrict tspec)
 	 * rounded to upper multiple of tick period.
 	 */
 	int64_t tick = ((int64_t)tspec->tv_sec << ETUX_TIMER_TICK_SUBSEC_BITS) +
-	               (((int64_t)tspec->tv_nsec +
-	                 (int64_t)ETUX_TIMER_TICK_NSEC - 1) /
-	                (int64_t)ETUX_TIMER_TICK_NSEC);
+	               etux_timer_subsec_from_nsec_upper(tspec->tv_nsec);
 
 	return (tick <= ETUX_TIMER_TICK_MAX) ? tick : (int64_t)-ERANGE;
 }
@@ -120,24 +116,6 @@ etux_timer_tick_from_tspec_upper(const struct timespec * __restrict tspec)
 #error Unexpected time_t bit width value (can only be 32 or 64-bit) !
 #endif
 
-static __utils_const __utils_nothrow __warn_result
-struct timespec
-etux_timer_tspec_from_tick(int64_t tick)
-{
-	etux_timer_assert_api(tick >= 0);
-	etux_timer_assert_api(tick <= ETUX_TIMER_TICK_MAX);
-
-	const struct timespec tspec = {
-		/* seconds = number of ticks / number of ticks per second */
-		.tv_sec = (time_t)(tick >> ETUX_TIMER_TICK_SUBSEC_BITS),
-		/* nanoseconds = number of sub second ticks * tick period */
-		.tv_nsec = (long)((tick & ETUX_TIMER_TICK_SUBSEC_MASK) *
-		                  ETUX_TIMER_TICK_NSEC)
-	};
-
-	return tspec;
-}
-
 int64_t
 etux_timer_tick_load(struct timespec * __restrict now)
 {
@@ -190,15 +168,59 @@ etux_timer_insert_inorder(struct stroll_dlist_node * __restrict list,
 	                                 NULL);
 }
 
-static __utils_nonull(1) __utils_nothrow __warn_result
+void
+etux_timer_setup_slack_tspec(struct etux_timer * __restrict     timer,
+                             const struct timespec * __restrict slack)
+{
+	etux_timer_assert_timer_api(timer);
+	utime_assert_tspec_api(slack);
+
+	int64_t tick = etux_timer_tick_from_tspec_lower_clamp(slack);
+
+	timer->slack = (unsigned int)stroll_min(tick, (int64_t)UINT_MAX);
+}
+
+void
+etux_timer_setup_slack_msec(struct etux_timer * __restrict timer, int msec)
+{
+	etux_timer_assert_api(msec >= 0);
+
+	const struct timespec slack = utime_tspec_from_msec(msec);
+
+	etux_timer_setup_slack_tspec(timer, &slack);
+}
+
+void
+etux_timer_setup_period_tspec(struct etux_timer * __restrict     timer,
+                              const struct timespec * __restrict period)
+{
+	etux_timer_assert_timer_api(timer);
+	utime_assert_tspec_api(period);
+
+	timer->period = etux_timer_tick_from_tspec_upper_clamp(period);
+}
+
+void
+etux_timer_setup_period_msec(struct etux_timer * __restrict timer, int msec)
+{
+	etux_timer_assert_api(msec >= 0);
+
+	const struct timespec period = utime_tspec_from_msec(msec);
+
+	etux_timer_setup_period_tspec(timer, &period);
+}
+
+static __utils_nonull(1, 2) __utils_nothrow __warn_result
 struct timespec *
-_etux_timer_issue_tspec(struct timespec * __restrict tspec)
+_etux_timer_issue_tspec(struct etux_timer_base * __restrict base,
+                        struct timespec * __restrict        tspec)
 {
+	etux_timer_assert_intern(base);
 	etux_timer_assert_intern(tspec);
 
 	int64_t issue;
 
-	issue = etux_timer_issue_tick();
+	issue = etux_timer_base_issue_tick(base);
 	if (issue >= 0) {
 		*tspec = etux_timer_tspec_from_tick(issue);
 
@@ -209,13 +231,15 @@ _etux_timer_issue_tspec(struct timespec * __restrict tspec)
 }
 
 struct timespec *
-etux_timer_issue_tspec(struct timespec * __restrict tspec)
+etux_timer_base_issue_tspec(struct etux_timer_base * __restrict base,
+                            struct timespec * __restrict        tspec)
 {
+	etux_timer_assert_api(base);
 	etux_timer_assert_api(tspec);
 
 	etux_timer_issue_tspec_trace_enter();
 
-	tspec = _etux_timer_issue_tspec(tspec);
+	tspec = _etux_timer_issue_tspec(base, tspec);
 
 	etux_timer_issue_tspec_trace_exit(tspec);
 
@@ -223,14 +247,16 @@ etux_timer_issue_tspec(struct timespec * __restrict tspec)
 }
 
 int
-etux_timer_issue_msec(void)
+etux_timer_base_issue_msec(struct etux_timer_base * __restrict base)
 {
+	etux_timer_assert_api(base);
+
 	struct timespec diff;
 	int             msec;
 
 	etux_timer_issue_msec_trace_enter();
 
-	if (_etux_timer_issue_tspec(&diff)) {
+	if (_etux_timer_issue_tspec(base, &diff)) {
 		struct timespec now;
 
 		utime_monotonic_now(&now);
@@ -247,4 +273,886 @@ etux_timer_issue_msec(void)
 	return msec;
 }
 
+void
+etux_timer_base_arm_many_tspec(struct etux_timer_base * __restrict    base,
+                               struct etux_timer * const * __restrict timers,
+                               unsigned int                           nr,
+                               const struct timespec * __restrict     tspec)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_api(timers);
+	utime_assert_tspec_api(tspec);
+
+	etux_timer_base_arm_many(base, timers, nr, tspec, NULL);
+}
+
+void
+etux_timer_base_arm_many_msec(struct etux_timer_base * __restrict    base,
+                              struct etux_timer * const * __restrict timers,
+                              unsigned int                           nr,
+                              int                                    msec)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_api(timers);
+	etux_timer_assert_api(msec >= 0);
+
+	struct timespec now;
+	struct timespec tspec;
+
+	etux_timer_base_now(base, &now);
+
+	tspec = now;
+	utime_tspec_add_msec_clamp(&tspec, msec);
+	etux_timer_base_arm_many(base, timers, nr, &tspec, &now);
+}
+
+void
+etux_timer_base_arm_many_sec(struct etux_timer_base * __restrict    base,
+                             struct etux_timer * const * __restrict timers,
+                             unsigned int                           nr,
+                             int                                    sec)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_api(timers);
+	etux_timer_assert_api(sec >= 0);
+
+	struct timespec now;
+	struct timespec tspec;
+
+	etux_timer_base_now(base, &now);
+
+	tspec = now;
+	utime_tspec_add_sec_clamp(&tspec, sec);
+	etux_timer_base_arm_many(base, timers, nr, &tspec, &now);
+}
+
+/******************************************************************************
+ * Relative arming clock handling
+ ******************************************************************************/
+
+#if defined(CONFIG_ETUX_TIMER_CLOCK_CACHE)
+
+void
+etux_timer_base_setup_clock(struct etux_timer_base * __restrict base,
+                            enum etux_timer_clock               clock)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_api((clock == ETUX_TIMER_PRECISE_CLOCK) ||
+	                      (clock == ETUX_TIMER_CACHED_CLOCK) ||
+	                      (clock == ETUX_TIMER_COARSE_CLOCK));
+
+	base->clock = clock;
+
+	/* Make sure cached clock sample is valid right from the start. */
+	etux_timer_base_cache_clock(base);
+}
+
+void
+etux_timer_base_refresh_clock(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_api(base);
+
+	etux_timer_base_cache_clock(base);
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_CLOCK_CACHE) */
+
+/******************************************************************************
+ * Remote timer requests handling
+ ******************************************************************************/
+
+#if defined(CONFIG_ETUX_TIMER_REMOTE)
+
+#include "utils/atomic.h"
+#include "utils/fd.h"
+#include <sys/eventfd.h>
+
+/*
+ * Requested expiry tick value meaning that the timer should be canceled.
+ */
+#define ETUX_TIMER_REMOTE_CANCEL_TICK \
+	(INT64_C(-1))
+
+static __utils_nonull(1) __utils_nothrow
+void
+etux_timer_remote_kick(const struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+
+	if (base->xfd >= 0) {
+		const uint64_t one = 1;
+		ssize_t        ret __unused;
+
+		/*
+		 * -EAGAIN means that eventfd counter is saturated, i.e. the
+		 * owner thread has already been kicked: ignore it.
+		 */
+		ret = ufd_write(base->xfd, (const char *)&one, sizeof(one));
+		etux_timer_assert_intern((ret == (ssize_t)sizeof(one)) ||
+		                         (ret == -EAGAIN));
+	}
+}
+
+static __utils_nonull(1) __utils_nothrow
+void
+etux_timer_remote_clear(const struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+
+	if (base->xfd >= 0) {
+		uint64_t cnt;
+		ssize_t  ret __unused;
+
+		ret = ufd_read(base->xfd, (char *)&cnt, sizeof(cnt));
+		etux_timer_assert_intern((ret == (ssize_t)sizeof(cnt)) ||
+		                         (ret == -EAGAIN));
+	}
+}
+
+/*
+ * Push a timer onto the queue of requests and tell whether queue was empty.
+ *
+ * Queue is a lock-free singly linked stack (producers push using a CAS loop,
+ * the consumer grabs the whole stack at once) so that no ABA issue can arise.
+ */
+static __utils_nonull(1, 2) __utils_nothrow
+bool
+etux_timer_remote_push(struct etux_timer_base * __restrict base,
+                       struct etux_timer * __restrict      timer)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(timer);
+
+	struct etux_timer * head;
+
+	head = atomic_load(&base->xreqs);
+	do {
+		timer->xnext = head;
+	} while (!atomic_cmpxchg(&base->xreqs, &head, timer));
+
+	return !head;
+}
+
+/*
+ * Queue a request for the given timer.
+ *
+ * Requested expiry tick is stored into the timer before queueing so that only
+ * the latest request is retained. A timer is queued at most once: producers
+ * that find it already pending simply update the requested tick.
+ */
+static __utils_nonull(1, 2) __utils_nothrow
+void
+etux_timer_remote_post(struct etux_timer_base * __restrict base,
+                       struct etux_timer * __restrict      timer,
+                       int64_t                             tick)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(timer);
+	etux_timer_assert_intern(timer->expire);
+	etux_timer_assert_intern(tick <= ETUX_TIMER_TICK_MAX);
+
+	atomic_store(&timer->xtick, tick);
+	if (atomic_xchg(&timer->xpend, true))
+		/* Already queued: consumer will load the latest tick. */
+		return;
+
+	if (etux_timer_remote_push(base, timer))
+		/* Queue was empty: wake the owner thread up. */
+		etux_timer_remote_kick(base);
+}
+
+void
+etux_timer_remote_drain(struct etux_timer_base * base)
+{
+	etux_timer_assert_intern(base);
+
+	struct etux_timer * reqs;
+	struct etux_timer * fifo = NULL;
+
+	if (!atomic_load(&base->xreqs) &&
+	    !etux_timer_pool_pending(base))
+		return;
+
+	/*
+	 * Clear kick before grabbing requests and pool completions so that a
+	 * kick issued by a producer pushing right after the exchanges below is
+	 * not lost.
+	 */
+	etux_timer_remote_clear(base);
+
+	/*
+	 * Apply pool completions first so that requests issued by expiry
+	 * callbacks find their timer back into the base.
+	 */
+	etux_timer_pool_drain(base);
+
+	reqs = atomic_xchg(&base->xreqs, NULL);
+
+	/* Restore requests submission order. */
+	while (reqs) {
+		struct etux_timer * tmr = reqs;
+
+		reqs = tmr->xnext;
+		tmr->xnext = fifo;
+		fifo = tmr;
+	}
+
+	while (fifo) {
+		struct etux_timer * tmr = fifo;
+		bool                pend __unused;
+		int64_t             tick;
+
+		fifo = tmr->xnext;
+
+		if (etux_timer_pool_busy(tmr)) {
+			/*
+			 * Timer expiry callback is still being run by a pool
+			 * worker: requeue request as is. It will be applied
+			 * once callback completion kicks us again.
+			 */
+			etux_timer_remote_push(base, tmr);
+			continue;
+		}
+
+		/*
+		 * Unmark timer before loading requested tick: a producer
+		 * racing with us either stored its tick before we load it or
+		 * will queue the timer again. Both sides mark/unmark using an
+		 * exchange so that the producer's tick store is visible once
+		 * its exchange has been observed.
+		 */
+		pend = atomic_xchg(&tmr->xpend, false);
+		etux_timer_assert_intern(pend);
+		tick = atomic_load(&tmr->xtick);
+
+		if (tick != ETUX_TIMER_REMOTE_CANCEL_TICK) {
+			const struct timespec tspec =
+				etux_timer_tspec_from_tick(tick);
+
+			etux_timer_base_arm_tspec(base, tmr, &tspec);
+		}
+		else
+			etux_timer_base_cancel(base, tmr);
+	}
+}
+
+void
+etux_timer_base_remote_arm_tspec(struct etux_timer_base * __restrict base,
+                                 struct etux_timer * __restrict      timer,
+                                 const struct timespec * __restrict  tspec)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_api(timer);
+	etux_timer_assert_api(timer->expire);
+	utime_assert_tspec_api(tspec);
+
+	etux_timer_remote_post(base,
+	                       timer,
+	                       etux_timer_tick_from_tspec_upper_clamp(tspec));
+}
+
+void
+etux_timer_base_remote_arm_msec(struct etux_timer_base * __restrict base,
+                                struct etux_timer * __restrict      timer,
+                                int                                 msec)
+{
+	etux_timer_assert_api(msec >= 0);
+
+	struct timespec tspec;
+
+	utime_monotonic_now(&tspec);
+	utime_tspec_add_msec_clamp(&tspec, msec);
+
+	etux_timer_base_remote_arm_tspec(base, timer, &tspec);
+}
+
+void
+etux_timer_base_remote_arm_sec(struct etux_timer_base * __restrict base,
+                               struct etux_timer * __restrict      timer,
+                               int                                 sec)
+{
+	etux_timer_assert_api(sec >= 0);
+
+	struct timespec tspec;
+
+	utime_monotonic_now(&tspec);
+	utime_tspec_add_sec_clamp(&tspec, sec);
+
+	etux_timer_base_remote_arm_tspec(base, timer, &tspec);
+}
+
+void
+etux_timer_base_remote_cancel(struct etux_timer_base * __restrict base,
+                              struct etux_timer * __restrict      timer)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_api(timer);
+	etux_timer_assert_api(timer->expire);
+
+	etux_timer_remote_post(base, timer, ETUX_TIMER_REMOTE_CANCEL_TICK);
+}
+
+int
+etux_timer_base_open_kick(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_api(base->xfd < 0);
+
+	int fd;
+
+	fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (fd < 0) {
+		etux_timer_assert_api(errno != EINVAL);
+		return -errno;
+	}
+
+	base->xfd = fd;
+
+	/* Requests may have been queued before: make sure they are seen. */
+	if (atomic_load(&base->xreqs))
+		etux_timer_remote_kick(base);
+
+	return fd;
+}
+
+void
+etux_timer_base_close_kick(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_api(base);
+
+	if (base->xfd >= 0) {
+		int err __unused;
+
+		err = ufd_close(base->xfd);
+		etux_timer_assert_intern(!err || (err == -EINTR));
+
+		base->xfd = -1;
+	}
+}
+
+void
+etux_timer_remote_init(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+
+	base->xreqs = NULL;
+	base->xfd = -1;
+#if defined(CONFIG_ETUX_TIMER_POOL)
+	base->pool = NULL;
+	base->pdone = NULL;
+	base->pbusy = 0;
+#endif /* defined(CONFIG_ETUX_TIMER_POOL) */
+}
+
+void
+etux_timer_remote_fini(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_api(!base->xreqs);
+#if defined(CONFIG_ETUX_TIMER_POOL)
+	etux_timer_assert_api(!base->pbusy);
+	etux_timer_assert_api(!base->pdone);
+#endif /* defined(CONFIG_ETUX_TIMER_POOL) */
+
+	etux_timer_base_close_kick(base);
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_REMOTE) */
+
+#if defined(CONFIG_ETUX_TIMER_POOL)
+
+/******************************************************************************
+ * Timer expiry worker pool handling
+ ******************************************************************************/
+
+#include <stdlib.h>
+
+/*
+ * Report completion of a timer expiry callback to the base owner thread.
+ *
+ * Completions are pushed onto a lock-free singly linked stack the same way
+ * remote requests are.
+ */
+static __utils_nonull(1) __utils_nothrow
+void
+etux_timer_pool_complete(struct etux_timer * __restrict timer)
+{
+	etux_timer_assert_intern(timer);
+	etux_timer_assert_intern(timer->pbase);
+
+	struct etux_timer_base * base = timer->pbase;
+	struct etux_timer *      head;
+
+	head = atomic_load(&base->pdone);
+	do {
+		timer->pnext = head;
+	} while (!atomic_cmpxchg(&base->pdone, &head, timer));
+
+	if (!head)
+		etux_timer_remote_kick(base);
+}
+
+static __utils_nonull(1)
+void *
+etux_timer_pool_work(void * arg)
+{
+	etux_timer_assert_intern(arg);
+
+	struct etux_timer_pool * pool = arg;
+
+	uthr_lock_mutex(&pool->lock);
+
+	while (true) {
+		struct etux_timer * tmr;
+
+		while (stroll_dlist_empty(&pool->jobs) && !pool->quit)
+			uthr_wait_cond(&pool->cond, &pool->lock);
+
+		if (stroll_dlist_empty(&pool->jobs))
+			/* Asked to quit and no more pending jobs. */
+			break;
+
+		tmr = stroll_dlist_entry(stroll_dlist_dqueue_front(&pool->jobs),
+		                         struct etux_timer,
+		                         list);
+
+		uthr_unlock_mutex(&pool->lock);
+
+		etux_timer_assert_intern(tmr->state == ETUX_TIMER_RUN_STAT);
+		etux_timer_assert_intern(tmr->expire);
+
+		etux_timer_expire_trace_enter(tmr, &tmr->tspec, tmr->tick);
+		tmr->expire(tmr);
+		etux_timer_expire_trace_exit(tmr);
+
+		/* Timer MUST NOT be accessed once completion is reported. */
+		etux_timer_pool_complete(tmr);
+
+		uthr_lock_mutex(&pool->lock);
+	}
+
+	uthr_unlock_mutex(&pool->lock);
+
+	return NULL;
+}
+
+void
+etux_timer_pool_submit(struct etux_timer_base * __restrict base,
+                       struct etux_timer * __restrict      timer)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(base->pool);
+	etux_timer_assert_intern(timer);
+	etux_timer_assert_intern(timer->state == ETUX_TIMER_RUN_STAT);
+	etux_timer_assert_intern(!timer->pbusy);
+
+	struct etux_timer_pool * pool = base->pool;
+
+	timer->pbase = base;
+	timer->pbusy = true;
+	base->pbusy++;
+
+	uthr_lock_mutex(&pool->lock);
+	stroll_dlist_nqueue_back(&pool->jobs, &timer->list);
+	uthr_unlock_mutex(&pool->lock);
+
+	uthr_signal_cond(&pool->cond);
+}
+
+void
+etux_timer_pool_drain(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+
+	struct etux_timer * done;
+	int64_t             tick = -1;
+	struct timespec     now;
+
+	if (!etux_timer_pool_pending(base))
+		return;
+
+	done = atomic_xchg(&base->pdone, NULL);
+	while (done) {
+		struct etux_timer * tmr = done;
+
+		done = tmr->pnext;
+
+		etux_timer_assert_intern(tmr->pbusy);
+		etux_timer_assert_intern(tmr->state == ETUX_TIMER_RUN_STAT);
+		etux_timer_assert_intern(base->pbusy);
+
+		tmr->pbusy = false;
+		base->pbusy--;
+
+		if (!tmr->period) {
+			tmr->state = ETUX_TIMER_IDLE_STAT;
+			etux_timer_stats_idle(base);
+		}
+		else {
+			if (tick < 0)
+				tick = etux_timer_tick_load(&now);
+			etux_timer_forward(tmr, tick);
+			etux_timer_base_resume(base, tmr);
+		}
+	}
+}
+
+void
+etux_timer_base_setup_pool(struct etux_timer_base * __restrict base,
+                           struct etux_timer_pool *            pool)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_api(!pool || pool->nr);
+
+	base->pool = pool;
+}
+
+static __utils_nonull(1)
+void
+etux_timer_pool_stop(struct etux_timer_pool * __restrict pool)
+{
+	etux_timer_assert_intern(pool);
+
+	unsigned int w;
+
+	uthr_lock_mutex(&pool->lock);
+	pool->quit = true;
+	uthr_unlock_mutex(&pool->lock);
+
+	uthr_broadcast_cond(&pool->cond);
+
+	for (w = 0; w < pool->nr; w++) {
+		int err __unused;
+
+		err = pthread_join(pool->workers[w], NULL);
+		etux_timer_assert_intern(!err);
+	}
+}
+
+int
+etux_timer_pool_init(struct etux_timer_pool * __restrict pool,
+                     unsigned int                        nr)
+{
+	etux_timer_assert_api(pool);
+	etux_timer_assert_api(nr);
+	etux_timer_assert_api(nr <= ETUX_TIMER_POOL_WORKERS_MAX);
+
+	int err;
+
+	pool->workers = malloc(nr * sizeof(pool->workers[0]));
+	if (!pool->workers)
+		return -errno;
+
+	err = uthr_init_mutex(&pool->lock);
+	if (err)
+		goto free;
+
+	err = uthr_init_cond(&pool->cond, CLOCK_MONOTONIC);
+	if (err)
+		goto fini_lock;
+
+	stroll_dlist_init(&pool->jobs);
+	pool->quit = false;
+
+	for (pool->nr = 0; pool->nr < nr; pool->nr++) {
+		err = uthr_create(&pool->workers[pool->nr],
+		                  NULL,
+		                  etux_timer_pool_work,
+		                  pool);
+		if (err)
+			goto stop;
+	}
+
+	return 0;
+
+stop:
+	etux_timer_pool_stop(pool);
+	uthr_fini_cond(&pool->cond);
+fini_lock:
+	uthr_fini_mutex(&pool->lock);
+free:
+	free(pool->workers);
+
+	return err;
+}
+
+void
+etux_timer_pool_fini(struct etux_timer_pool * __restrict pool)
+{
+	etux_timer_assert_api(pool);
+	etux_timer_assert_api(pool->nr);
+
+	etux_timer_pool_stop(pool);
+
+	etux_timer_assert_intern(stroll_dlist_empty(&pool->jobs));
+
+	uthr_fini_cond(&pool->cond);
+	uthr_fini_mutex(&pool->lock);
+	free(pool->workers);
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_POOL) */
+
+#if defined(CONFIG_ETUX_TIMER_STATS)
+
+/******************************************************************************
+ * Statistics handling
+ ******************************************************************************/
+
+#include <string.h>
+
+#define ETUX_TIMER_STATS_SUB_NR \
+	(1U << ETUX_TIMER_STATS_SUB_BITS)
+
+unsigned int
+etux_timer_stats_bucket(int64_t late)
+{
+	etux_timer_assert_intern(late >= 0);
+
+	unsigned int msb;
+	unsigned int idx;
+
+	if (late < (int64_t)ETUX_TIMER_STATS_SUB_NR)
+		return (unsigned int)late;
+
+	/*
+	 * Log-linear bucketing: select the power of 2 range thanks to the most
+	 * significant bit then the linear sub-bucket thanks to the
+	 * ETUX_TIMER_STATS_SUB_BITS following bits.
+	 */
+	msb = 63U - (unsigned int)__builtin_clzll((unsigned long long)late);
+	idx = ((msb - ETUX_TIMER_STATS_SUB_BITS + 1) *
+	       ETUX_TIMER_STATS_SUB_NR) +
+	      (unsigned int)((late >> (msb - ETUX_TIMER_STATS_SUB_BITS)) &
+	                     (ETUX_TIMER_STATS_SUB_NR - 1));
+
+	return stroll_min(idx, ETUX_TIMER_STATS_BUCKETS_NR - 1);
+}
+
+void
+etux_timer_stats_bucket_tspec(unsigned int                 bucket,
+                              struct timespec * __restrict tspec)
+{
+	etux_timer_assert_api(bucket < ETUX_TIMER_STATS_BUCKETS_NR);
+	etux_timer_assert_api(tspec);
+
+	int64_t late;
+
+	if (bucket >= ETUX_TIMER_STATS_SUB_NR) {
+		unsigned int grp = bucket / ETUX_TIMER_STATS_SUB_NR;
+		unsigned int sub = bucket % ETUX_TIMER_STATS_SUB_NR;
+
+		late = (int64_t)(ETUX_TIMER_STATS_SUB_NR + sub) << (grp - 1);
+	}
+	else
+		late = (int64_t)bucket;
+
+	*tspec = etux_timer_tspec_from_tick(late);
+}
+
+#define etux_timer_stats_load(_cnt) \
+	__atomic_load_n(&(_cnt), __ATOMIC_RELAXED)
+
+void
+etux_timer_base_get_stats(const struct etux_timer_base * __restrict base,
+                          struct etux_timer_stats * __restrict      stats)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_api(stats);
+
+	unsigned int c;
+
+	utime_monotonic_now(&stats->stamp);
+
+	stats->arms = etux_timer_stats_load(base->stats.arms);
+	stats->cancels = etux_timer_stats_load(base->stats.cancels);
+	stats->expiries = etux_timer_stats_load(base->stats.expiries);
+	stats->pending = etux_timer_stats_load(base->stats.pending);
+	stats->eternals = etux_timer_stats_load(base->stats.eternals);
+	for (c = 0; c < stroll_array_nr(stats->cascades); c++)
+		stats->cascades[c] =
+			etux_timer_stats_load(base->stats.cascades[c]);
+	stats->migrations = etux_timer_stats_load(base->stats.migrations);
+	for (c = 0; c < stroll_array_nr(stats->lateness); c++)
+		stats->lateness[c] =
+			etux_timer_stats_load(base->stats.lateness[c]);
+}
+
+void
+etux_timer_stats_init(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+
+	memset(&base->stats, 0, sizeof(base->stats));
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_STATS) */
+
+/******************************************************************************
+ * Default timer base handling
+ ******************************************************************************/
+
+struct etux_timer_base etux_timer_dflt_base;
+
+void
+etux_timer_arm_tspec(struct etux_timer * __restrict     timer,
+                     const struct timespec * __restrict tspec)
+{
+	etux_timer_base_arm_tspec(&etux_timer_dflt_base, timer, tspec);
+}
+
+void
+etux_timer_arm_msec(struct etux_timer * __restrict timer, int msec)
+{
+	etux_timer_base_arm_msec(&etux_timer_dflt_base, timer, msec);
+}
+
+void
+etux_timer_arm_sec(struct etux_timer * __restrict timer, int sec)
+{
+	etux_timer_base_arm_sec(&etux_timer_dflt_base, timer, sec);
+}
+
+void
+etux_timer_cancel(struct etux_timer * __restrict timer)
+{
+	etux_timer_base_cancel(&etux_timer_dflt_base, timer);
+}
+
+void
+etux_timer_arm_many_tspec(struct etux_timer * const * __restrict timers,
+                          unsigned int                           nr,
+                          const struct timespec * __restrict     tspec)
+{
+	etux_timer_base_arm_many_tspec(&etux_timer_dflt_base,
+	                               timers,
+	                               nr,
+	                               tspec);
+}
+
+void
+etux_timer_arm_many_msec(struct etux_timer * const * __restrict timers,
+                         unsigned int                           nr,
+                         int                                    msec)
+{
+	etux_timer_base_arm_many_msec(&etux_timer_dflt_base, timers, nr, msec);
+}
+
+void
+etux_timer_arm_many_sec(struct etux_timer * const * __restrict timers,
+                        unsigned int                           nr,
+                        int                                    sec)
+{
+	etux_timer_base_arm_many_sec(&etux_timer_dflt_base, timers, nr, sec);
+}
+
+void
+etux_timer_cancel_many(struct etux_timer * const * __restrict timers,
+                       unsigned int                           nr)
+{
+	etux_timer_base_cancel_many(&etux_timer_dflt_base, timers, nr);
+}
+
+#if defined(CONFIG_ETUX_TIMER_CLOCK_CACHE)
+
+void
+etux_timer_setup_clock(enum etux_timer_clock clock)
+{
+	etux_timer_base_setup_clock(&etux_timer_dflt_base, clock);
+}
+
+void
+etux_timer_refresh_clock(void)
+{
+	etux_timer_base_refresh_clock(&etux_timer_dflt_base);
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_CLOCK_CACHE) */
+
+struct timespec *
+etux_timer_issue_tspec(struct timespec * __restrict tspec)
+{
+	return etux_timer_base_issue_tspec(&etux_timer_dflt_base, tspec);
+}
+
+int
+etux_timer_issue_msec(void)
+{
+	return etux_timer_base_issue_msec(&etux_timer_dflt_base);
+}
+
+void
+etux_timer_run(void)
+{
+	etux_timer_base_run(&etux_timer_dflt_base);
+}
+
+#if defined(CONFIG_ETUX_TIMER_REMOTE)
+
+void
+etux_timer_remote_arm_tspec(struct etux_timer * __restrict     timer,
+                            const struct timespec * __restrict tspec)
+{
+	etux_timer_base_remote_arm_tspec(&etux_timer_dflt_base, timer, tspec);
+}
+
+void
+etux_timer_remote_arm_msec(struct etux_timer * __restrict timer, int msec)
+{
+	etux_timer_base_remote_arm_msec(&etux_timer_dflt_base, timer, msec);
+}
+
+void
+etux_timer_remote_arm_sec(struct etux_timer * __restrict timer, int sec)
+{
+	etux_timer_base_remote_arm_sec(&etux_timer_dflt_base, timer, sec);
+}
+
+void
+etux_timer_remote_cancel(struct etux_timer * __restrict timer)
+{
+	etux_timer_base_remote_cancel(&etux_timer_dflt_base, timer);
+}
+
+int
+etux_timer_open_kick(void)
+{
+	return etux_timer_base_open_kick(&etux_timer_dflt_base);
+}
+
+void
+etux_timer_close_kick(void)
+{
+	etux_timer_base_close_kick(&etux_timer_dflt_base);
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_REMOTE) */
+
+#if defined(CONFIG_ETUX_TIMER_POOL)
+
+void
+etux_timer_setup_pool(struct etux_timer_pool * pool)
+{
+	etux_timer_base_setup_pool(&etux_timer_dflt_base, pool);
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_POOL) */
+
+#if defined(CONFIG_ETUX_TIMER_STATS)
+
+void
+etux_timer_get_stats(struct etux_timer_stats * __restrict stats)
+{
+	etux_timer_base_get_stats(&etux_timer_dflt_base, stats);
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_STATS) */
+
+static __ctor() __utils_nothrow
+void
+etux_timer_ctor(void)
+{
+	etux_timer_base_init(&etux_timer_dflt_base);
+}
+
 /* ex: set filetype=c : */
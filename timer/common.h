@@ -44,34 +44,54 @@
  * ETUX_TIMER_TICK_SUBSEC_BITS values:
  *
  *     ETUX_TIMER_TICK_SUBSEC_BITS     Tick period  Tick frequency
- *                                  (milliseconds)         (Hertz)
- *                               0     1000.000000               1
- *                               1      500.000000               2
- *                               2      250.000000               4
- *                               3      125.000000               8
- *                               4       62.500000              16
- *                               5       31.250000              32
- *                               6       15.625000              64
- *                               7        7.812500             128
- *                               8        3.906250             256
- *                               9        1.953125             512
+ *                                  (microseconds)         (Hertz)
+ *                               0  1000000.000000               1
+ *                               1   500000.000000               2
+ *                               2   250000.000000               4
+ *                               3   125000.000000               8
+ *                               4    62500.000000              16
+ *                               5    31250.000000              32
+ *                               6    15625.000000              64
+ *                               7     7812.500000             128
+ *                               8     3906.250000             256
+ *                               9     1953.125000             512
+ *                              10      976.562500            1024
+ *                              11      488.281250            2048
+ *                              12      244.140625            4096
+ *                              13      122.070312            8192
+ *                              14       61.035156           16384
+ *                              15       30.517578           32768
+ *                              16       15.258789           65536
+ *                              17        7.629395          131072
+ *                              18        3.814697          262144
+ *                              19        1.907349          524288
+ *                              20        0.953674         1048576
  *
- * Watch out!
- * The tick period MUST be a divisor of 1000000000 nanoseconds so that we can
- * perform power of 2 arithmetics (see etux_timer_tick_from_tspec_lower(),
- * etux_timer_tick_from_tspec_upper() and etux_timer_tspec_from_tick()).
- * This is the reason why ETUX_TIMER_TICK_SUBSEC_BITS MUST be < 10.
+ * A tick encodes the number of seconds into its upper bits and the number of
+ * sub second tick periods into its ETUX_TIMER_TICK_SUBSEC_BITS lower bits.
+ *
+ * Starting from 10 bits, the tick period is no more a whole number of
+ * nanoseconds. Sub second parts are hence converted using fixed-point
+ * arithmetics, i.e. by scaling nanoseconds by 2^ETUX_TIMER_TICK_SUBSEC_BITS
+ * and dividing by 1000000000 (see etux_timer_subsec_from_nsec_lower(),
+ * etux_timer_subsec_from_nsec_upper() and etux_timer_nsec_from_subsec()).
+ * Compilers turn the constant divisions into multiply and shift sequences.
  */
 #define ETUX_TIMER_TICK_SUBSEC_BITS \
 	STROLL_CONCAT(CONFIG_ETUX_TIMER_SUBSEC_BITS, U)
-#if (ETUX_TIMER_TICK_SUBSEC_BITS < 0) || (ETUX_TIMER_TICK_SUBSEC_BITS > 9)
+#if (ETUX_TIMER_TICK_SUBSEC_BITS < 0) || (ETUX_TIMER_TICK_SUBSEC_BITS > 20)
 #error Invalid tick sub second precision bits.
 #endif
 
 #define ETUX_TIMER_TICK_SUBSEC_MASK \
 	((INT64_C(1) << ETUX_TIMER_TICK_SUBSEC_BITS) - 1)
 
-/* Period of a tick in nanoseconds */
+/*
+ * Period of a tick in nanoseconds.
+ *
+ * Rounded down to the nearest nanosecond when ETUX_TIMER_TICK_SUBSEC_BITS
+ * >= 10. Do not use it to perform tick conversions !
+ */
 #define ETUX_TIMER_TICK_NSEC \
 	(INT64_C(1000000000) >> ETUX_TIMER_TICK_SUBSEC_BITS)
 
@@ -79,6 +99,64 @@
 #define ETUX_TIMER_TICKS_PER_SEC \
 	(1UL << ETUX_TIMER_TICK_SUBSEC_BITS)
 
+/*
+ * Convert a number of nanoseconds to a number of sub second tick periods,
+ * rounded down.
+ */
+static inline __utils_const __utils_nothrow __warn_result
+int64_t
+etux_timer_subsec_from_nsec_lower(long nsec)
+{
+	etux_timer_assert_intern(nsec >= 0);
+	etux_timer_assert_intern(nsec < 1000000000L);
+
+	return (int64_t)(((uint64_t)nsec << ETUX_TIMER_TICK_SUBSEC_BITS) /
+	                 UINT64_C(1000000000));
+}
+
+/*
+ * Convert a number of nanoseconds to a number of sub second tick periods,
+ * rounded up, i.e. return the first tick whose start as given by
+ * etux_timer_nsec_from_subsec() is located at or after nsec.
+ *
+ * Watch out! Result may be equal to ETUX_TIMER_TICKS_PER_SEC, i.e. carry to
+ * the seconds part.
+ */
+static inline __utils_const __utils_nothrow __warn_result
+int64_t
+etux_timer_subsec_from_nsec_upper(long nsec)
+{
+	etux_timer_assert_intern(nsec >= 0);
+	etux_timer_assert_intern(nsec < 1000000000L);
+
+	if (!nsec)
+		return 0;
+
+	return (int64_t)((((uint64_t)nsec - 1) <<
+	                  ETUX_TIMER_TICK_SUBSEC_BITS) /
+	                 UINT64_C(1000000000)) + 1;
+}
+
+/*
+ * Convert a number of sub second tick periods to a number of nanoseconds.
+ *
+ * Result is rounded up so that converting it back using either
+ * etux_timer_subsec_from_nsec_lower() or etux_timer_subsec_from_nsec_upper()
+ * gives the original number of periods, i.e. a timer may never be considered
+ * as expired before its tick.
+ */
+static inline __utils_const __utils_nothrow __warn_result
+long
+etux_timer_nsec_from_subsec(int64_t subsec)
+{
+	etux_timer_assert_intern(subsec >= 0);
+	etux_timer_assert_intern(subsec <= (int64_t)ETUX_TIMER_TICKS_PER_SEC);
+
+	return (long)((((uint64_t)subsec * UINT64_C(1000000000)) +
+	               (uint64_t)ETUX_TIMER_TICK_SUBSEC_MASK) >>
+	              ETUX_TIMER_TICK_SUBSEC_BITS);
+}
+
 /*
  * Maximum tick value that can be encoded.
  *
@@ -141,6 +219,24 @@ etux_timer_tick_from_tspec_upper_clamp(const struct timespec * __restrict tspec)
 	return (tick >= 0) ? tick : ETUX_TIMER_TICK_MAX;
 }
 
+static inline __utils_const __utils_nothrow __warn_result
+struct timespec
+etux_timer_tspec_from_tick(int64_t tick)
+{
+	etux_timer_assert_api(tick >= 0);
+	etux_timer_assert_api(tick <= ETUX_TIMER_TICK_MAX);
+
+	const struct timespec tspec = {
+		/* seconds = number of ticks / number of ticks per second */
+		.tv_sec = (time_t)(tick >> ETUX_TIMER_TICK_SUBSEC_BITS),
+		/* nanoseconds = number of sub second ticks * tick period */
+		.tv_nsec = etux_timer_nsec_from_subsec(
+			tick & ETUX_TIMER_TICK_SUBSEC_MASK)
+	};
+
+	return tspec;
+}
+
 extern int64_t
 etux_timer_tick_load(struct timespec * __restrict now)
 	__utils_nonull(1)
@@ -169,14 +265,524 @@ etux_timer_list_lead_timer(const struct stroll_dlist_node * __restrict head)
 	return tmr;
 }
 
+/*
+ * Compute timer expiry tick, delaying it by up to timer's slack ticks.
+ *
+ * Expiry is moved onto the tick of the [expiry, expiry + slack] window having
+ * the greatest number of trailing zero bits (much like Linux kernel's former
+ * apply_slack() does) so that timers whose windows overlap are likely to end
+ * up onto the same tick.
+ */
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __warn_result
+int64_t
+etux_timer_expiry_tick(const struct etux_timer * __restrict timer)
+{
+	etux_timer_assert_intern(timer);
+
+	int64_t tick = etux_timer_tick_from_tspec_upper_clamp(&timer->tspec);
+
+	if (timer->slack) {
+		int64_t  limit;
+		uint64_t diff;
+
+		if (tick <= (ETUX_TIMER_TICK_MAX - (int64_t)timer->slack))
+			limit = tick + (int64_t)timer->slack;
+		else
+			limit = ETUX_TIMER_TICK_MAX;
+
+		/*
+		 * Clear all bits of limit below the most significant one that
+		 * differs from tick.
+		 */
+		diff = (uint64_t)(tick ^ limit);
+		if (diff)
+			tick = limit &
+			       ~((INT64_C(1) << (63 - __builtin_clzll(diff))) -
+			         1);
+	}
+
+	return tick;
+}
+
+/*
+ * Compute the number of periods a periodic timer has missed given the current
+ * tick. Expected to be called right before running timer expiry callback.
+ */
+static inline __utils_nonull(1) __utils_nothrow
+void
+etux_timer_count_overrun(struct etux_timer * __restrict timer, int64_t tick)
+{
+	etux_timer_assert_intern(timer);
+	etux_timer_assert_intern(timer->period > 0);
+	etux_timer_assert_intern(tick >= timer->tick);
+
+	int64_t nominal = etux_timer_tick_from_tspec_upper_clamp(&timer->tspec);
+	int64_t missed = (tick - nominal) / timer->period;
+
+	etux_timer_assert_intern(missed >= 0);
+
+	timer->overrun = (unsigned int)stroll_min(missed, (int64_t)UINT_MAX);
+}
+
+/*
+ * Move periodic timer expiry date to the first period boundary following the
+ * last expiry. Since computation is performed relative to previous nominal
+ * expiry (i.e. slack excluded), no drift is accumulated.
+ */
+static inline __utils_nonull(1) __utils_nothrow
+void
+etux_timer_forward(struct etux_timer * __restrict timer, int64_t tick)
+{
+	etux_timer_assert_intern(timer);
+	etux_timer_assert_intern(timer->period > 0);
+
+	int64_t nominal = etux_timer_tick_from_tspec_upper_clamp(&timer->tspec);
+	int64_t steps = (stroll_max(tick, nominal) - nominal) / timer->period;
+
+	if ((ETUX_TIMER_TICK_MAX - nominal) / timer->period > steps)
+		nominal += (steps + 1) * timer->period;
+	else
+		nominal = ETUX_TIMER_TICK_MAX;
+
+	timer->tspec = etux_timer_tspec_from_tick(nominal);
+}
+
 extern void
 etux_timer_insert_inorder(struct stroll_dlist_node * __restrict list,
                           struct etux_timer * __restrict        timer)
 	__utils_nonull(1, 2) __utils_nothrow __leaf __export_intern;
 
 extern int64_t
-etux_timer_issue_tick(void)
-	__utils_nothrow __warn_result __leaf __export_intern;
+etux_timer_base_issue_tick(struct etux_timer_base * __restrict base)
+	__utils_nonull(1) __utils_nothrow __warn_result __leaf __export_intern;
+
+/*
+ * Arm a batch of timers with the same expiry date.
+ *
+ * `now' is the clock sample `tspec' has been computed from, if any, so that
+ * backends do not need to sample the clock again.
+ */
+extern void
+etux_timer_base_arm_many(struct etux_timer_base * __restrict    base,
+                         struct etux_timer * const * __restrict timers,
+                         unsigned int                           nr,
+                         const struct timespec * __restrict     tspec,
+                         const struct timespec * __restrict     now)
+	__utils_nonull(1, 2, 4) __utils_nothrow __leaf __export_intern;
+
+/*
+ * Process wide default timer base used by etux_timer_arm_*(),
+ * etux_timer_cancel(), etux_timer_issue_*() and etux_timer_run().
+ */
+extern struct etux_timer_base etux_timer_dflt_base __export_intern;
+
+/******************************************************************************
+ * Relative arming clock handling
+ ******************************************************************************/
+
+#if defined(CONFIG_ETUX_TIMER_CLOCK_CACHE)
+
+/* Sample the clock relative timer expiry dates are computed from. */
+static inline __utils_nonull(1, 2) __utils_nothrow
+void
+etux_timer_base_now(const struct etux_timer_base * __restrict base,
+                    struct timespec * __restrict              now)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(now);
+
+	switch (base->clock) {
+	case ETUX_TIMER_PRECISE_CLOCK:
+		utime_monotonic_now(now);
+		break;
+
+	case ETUX_TIMER_CACHED_CLOCK:
+		*now = base->now;
+		break;
+
+	case ETUX_TIMER_COARSE_CLOCK:
+		utime_coarse_now(now);
+		break;
+
+	default:
+		etux_timer_assert_intern(0);
+	}
+}
+
+/* Refresh cached clock sample, if relevant. */
+static inline __utils_nonull(1) __utils_nothrow
+void
+etux_timer_base_cache_clock(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+
+	if (base->clock == ETUX_TIMER_CACHED_CLOCK)
+		utime_monotonic_now(&base->now);
+}
+
+static inline __utils_nonull(1) __utils_nothrow
+void
+etux_timer_clock_init(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+
+	base->clock = ETUX_TIMER_PRECISE_CLOCK;
+}
+
+#else  /* !defined(CONFIG_ETUX_TIMER_CLOCK_CACHE) */
+
+static inline __utils_nonull(2) __utils_nothrow
+void
+etux_timer_base_now(const struct etux_timer_base * __restrict base __unused,
+                    struct timespec * __restrict              now)
+{
+	utime_monotonic_now(now);
+}
+
+static inline
+void
+etux_timer_base_cache_clock(struct etux_timer_base * __restrict base __unused)
+{
+}
+
+static inline
+void
+etux_timer_clock_init(struct etux_timer_base * __restrict base __unused)
+{
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_CLOCK_CACHE) */
+
+/******************************************************************************
+ * Remote timer requests handling
+ ******************************************************************************/
+
+#if defined(CONFIG_ETUX_TIMER_REMOTE)
+
+extern void
+etux_timer_remote_drain(struct etux_timer_base * base)
+	__utils_nonull(1) __utils_nothrow __export_intern;
+
+extern void
+etux_timer_remote_init(struct etux_timer_base * __restrict base)
+	__utils_nonull(1) __utils_nothrow __leaf __export_intern;
+
+extern void
+etux_timer_remote_fini(struct etux_timer_base * __restrict base)
+	__utils_nonull(1) __utils_nothrow __leaf __export_intern;
+
+#else  /* !defined(CONFIG_ETUX_TIMER_REMOTE) */
+
+static inline
+void
+etux_timer_remote_drain(struct etux_timer_base * base __unused)
+{
+}
+
+static inline
+void
+etux_timer_remote_init(struct etux_timer_base * __restrict base __unused)
+{
+}
+
+static inline
+void
+etux_timer_remote_fini(struct etux_timer_base * __restrict base __unused)
+{
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_REMOTE) */
+
+/******************************************************************************
+ * Timer expiry worker pool handling
+ ******************************************************************************/
+
+#if defined(CONFIG_ETUX_TIMER_POOL)
+
+#include "utils/atomic.h"
+
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __warn_result
+bool
+etux_timer_pool_enabled(const struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+
+	return !!base->pool;
+}
+
+static inline __utils_nonull(1) __utils_nothrow __warn_result
+bool
+etux_timer_pool_pending(const struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+
+	return !!atomic_load(&base->pdone);
+}
+
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __warn_result
+bool
+etux_timer_pool_busy(const struct etux_timer * __restrict timer)
+{
+	etux_timer_assert_intern(timer);
+
+	return timer->pbusy;
+}
+
+/*
+ * Hand an expired timer already removed from its base over to the base's
+ * worker pool.
+ */
+extern void
+etux_timer_pool_submit(struct etux_timer_base * __restrict base,
+                       struct etux_timer * __restrict      timer)
+	__utils_nonull(1, 2) __utils_nothrow __export_intern;
+
+/*
+ * Apply completions of expiry callbacks run by pool workers.
+ */
+extern void
+etux_timer_pool_drain(struct etux_timer_base * __restrict base)
+	__utils_nonull(1) __utils_nothrow __export_intern;
+
+/*
+ * Re-insert into its base a periodic timer which expiry callback has been run
+ * by a pool worker. Implemented by each backend.
+ */
+extern void
+etux_timer_base_resume(struct etux_timer_base * __restrict base,
+                       struct etux_timer * __restrict      timer)
+	__utils_nonull(1, 2) __utils_nothrow __export_intern;
+
+#else  /* !defined(CONFIG_ETUX_TIMER_POOL) */
+
+static inline __warn_result
+bool
+etux_timer_pool_enabled(
+	const struct etux_timer_base * __restrict base __unused)
+{
+	return false;
+}
+
+static inline __warn_result
+bool
+etux_timer_pool_pending(
+	const struct etux_timer_base * __restrict base __unused)
+{
+	return false;
+}
+
+static inline __warn_result
+bool
+etux_timer_pool_busy(const struct etux_timer * __restrict timer __unused)
+{
+	return false;
+}
+
+static inline
+void
+etux_timer_pool_submit(struct etux_timer_base * __restrict base __unused,
+                       struct etux_timer * __restrict      timer __unused)
+{
+}
+
+static inline
+void
+etux_timer_pool_drain(struct etux_timer_base * __restrict base __unused)
+{
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_POOL) */
+
+/*
+ * A timer which expiry callback is being run by a pool worker is owned by the
+ * pool: it may only be armed or canceled through remote requests.
+ */
+#define etux_timer_assert_pool_api(_timer) \
+	etux_timer_assert_api(!etux_timer_pool_busy(_timer))
+
+/******************************************************************************
+ * Statistics handling
+ ******************************************************************************/
+
+#if defined(CONFIG_ETUX_TIMER_STATS)
+
+/*
+ * Statistics are updated by the base owner thread only: a relaxed load /
+ * store pair is enough to prevent readers from observing torn values.
+ */
+#define etux_timer_stats_add(_cnt, _val) \
+	__atomic_store_n(&(_cnt), \
+	                 __atomic_load_n(&(_cnt), __ATOMIC_RELAXED) + (_val), \
+	                 __ATOMIC_RELAXED)
+
+#define etux_timer_stats_sub(_cnt, _val) \
+	__atomic_store_n(&(_cnt), \
+	                 __atomic_load_n(&(_cnt), __ATOMIC_RELAXED) - (_val), \
+	                 __ATOMIC_RELAXED)
+
+extern unsigned int
+etux_timer_stats_bucket(int64_t late)
+	__utils_const __utils_nothrow __leaf __warn_result __export_intern;
+
+static inline __utils_nonull(1, 2) __utils_nothrow
+void
+etux_timer_stats_arm(struct etux_timer_base * __restrict  base,
+                     const struct etux_timer * __restrict timer)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(timer);
+
+	etux_timer_stats_add(base->stats.arms, 1);
+	if ((timer->state != ETUX_TIMER_PEND_STAT) &&
+	    (timer->state != ETUX_TIMER_RUN_STAT))
+		/* Idle or lazily canceled timer. */
+		etux_timer_stats_add(base->stats.pending, 1);
+}
+
+static inline __utils_nonull(1) __utils_nothrow
+void
+etux_timer_stats_cancel(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(base->stats.pending);
+
+	etux_timer_stats_add(base->stats.cancels, 1);
+	etux_timer_stats_sub(base->stats.pending, 1);
+}
+
+static inline __utils_nonull(1, 2) __utils_nothrow
+void
+etux_timer_stats_expire(struct etux_timer_base * __restrict  base,
+                        const struct etux_timer * __restrict timer,
+                        int64_t                              tick)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(timer);
+	etux_timer_assert_intern(tick >= timer->tick);
+
+	etux_timer_stats_add(base->stats.expiries, 1);
+	etux_timer_stats_add(
+		base->stats.lateness[etux_timer_stats_bucket(tick -
+		                                             timer->tick)],
+		1);
+}
+
+static inline __utils_nonull(1) __utils_nothrow
+void
+etux_timer_stats_idle(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(base->stats.pending);
+
+	etux_timer_stats_sub(base->stats.pending, 1);
+}
+
+static inline __utils_nonull(1) __utils_nothrow
+void
+etux_timer_stats_cascade(struct etux_timer_base * __restrict base,
+                         unsigned int                        level)
+{
+	etux_timer_assert_intern(base);
+
+	if (level < ETUX_TIMER_STATS_LEVELS_NR)
+		etux_timer_stats_add(base->stats.cascades[level], 1);
+}
+
+static inline __utils_nonull(1) __utils_nothrow
+void
+etux_timer_stats_enter_eternal(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+
+	etux_timer_stats_add(base->stats.eternals, 1);
+}
+
+static inline __utils_nonull(1) __utils_nothrow
+void
+etux_timer_stats_leave_eternal(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(base->stats.eternals);
+
+	etux_timer_stats_sub(base->stats.eternals, 1);
+}
+
+static inline __utils_nonull(1) __utils_nothrow
+void
+etux_timer_stats_migrate(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+
+	etux_timer_stats_add(base->stats.migrations, 1);
+}
+
+extern void
+etux_timer_stats_init(struct etux_timer_base * __restrict base)
+	__utils_nonull(1) __utils_nothrow __leaf __export_intern;
+
+#else  /* !defined(CONFIG_ETUX_TIMER_STATS) */
+
+static inline
+void
+etux_timer_stats_arm(struct etux_timer_base * __restrict  base __unused,
+                     const struct etux_timer * __restrict timer __unused)
+{
+}
+
+static inline
+void
+etux_timer_stats_cancel(struct etux_timer_base * __restrict base __unused)
+{
+}
+
+static inline
+void
+etux_timer_stats_expire(struct etux_timer_base * __restrict  base __unused,
+                        const struct etux_timer * __restrict timer __unused,
+                        int64_t                              tick __unused)
+{
+}
+
+static inline
+void
+etux_timer_stats_idle(struct etux_timer_base * __restrict base __unused)
+{
+}
+
+static inline
+void
+etux_timer_stats_cascade(struct etux_timer_base * __restrict base __unused,
+                         unsigned int                        level __unused)
+{
+}
+
+static inline
+void
+etux_timer_stats_enter_eternal(
+	struct etux_timer_base * __restrict base __unused)
+{
+}
+
+static inline
+void
+etux_timer_stats_leave_eternal(
+	struct etux_timer_base * __restrict base __unused)
+{
+}
+
+static inline
+void
+etux_timer_stats_migrate(struct etux_timer_base * __restrict base __unused)
+{
+}
+
+static inline
+void
+etux_timer_stats_init(struct etux_timer_base * __restrict base __unused)
+{
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_STATS) */
 
 /******************************************************************************
  * Tracing handling
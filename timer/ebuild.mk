@@ -15,9 +15,15 @@ shared-common-ldflags           := -L$(BUILDDIR)/../src \
                                    -fvisibility=hidden \
                                    -l:shared/builtin.a -lutils
 common-pkgconf                  += $(call kconf_enabled,ETUX_TRACE,lttng-ust)
+common-cflags                   += $(call kconf_enabled,ETUX_TIMER_POOL,-pthread)
+shared-common-cflags            += $(call kconf_enabled,ETUX_TIMER_POOL,-pthread)
+shared-common-ldflags           += $(call kconf_enabled,ETUX_TIMER_POOL,-pthread)
 
 builtins                        := shared/builtin.a
 shared/builtin.a-objs           := shared/common.o
+shared/builtin.a-objs           += $(call kconf_enabled, \
+                                          ETUX_TIMER_POLL, \
+                                          shared/poll.o)
 shared/builtin.a-objs           += $(call kconf_enabled, \
                                           ETUX_TRACE, \
                                           shared/trace.o)
@@ -26,6 +32,9 @@ shared/builtin.a-pkgconf        := $(common-pkgconf)
 
 builtins                        += static/builtin.a
 static/builtin.a-objs           := static/common.o
+static/builtin.a-objs           += $(call kconf_enabled, \
+                                          ETUX_TIMER_POLL, \
+                                          static/poll.o)
 static/builtin.a-objs           += $(call kconf_enabled, \
                                           ETUX_TRACE, \
                                           static/trace.o)
@@ -87,4 +96,23 @@ libetux_timer_hwheel.a-lots     := static/builtin.a
 libetux_timer_hwheel.a-cflags   := $(common-cflags)
 libetux_timer_hwheel.a-pkgconf  := $(common-pkgconf)
 
+# Hybrid timing wheel / heap based implementation.
+
+solibs                          += $(call kconf_enabled, \
+                                          ETUX_TIMER_HYBRID, \
+                                          libetux_timer_hybrid.so)
+libetux_timer_hybrid.so-objs    := shared/hybrid.o
+libetux_timer_hybrid.so-cflags  := $(shared-common-cflags)
+libetux_timer_hybrid.so-ldflags := $(shared-common-ldflags) \
+                                   -Wl,-soname,libetux_timer_hybrid.so
+libetux_timer_hybrid.so-pkgconf := $(common-pkgconf)
+
+arlibs                          += $(call kconf_enabled, \
+                                          ETUX_TIMER_HYBRID, \
+                                          libetux_timer_hybrid.a)
+libetux_timer_hybrid.a-objs     := static/hybrid.o
+libetux_timer_hybrid.a-lots     := static/builtin.a
+libetux_timer_hybrid.a-cflags   := $(common-cflags)
+libetux_timer_hybrid.a-pkgconf  := $(common-pkgconf)
+
 # ex: filetype=make :
@@ -8,9 +8,6 @@
 #include "common.h"
 #include <errno.h>
 
-static struct stroll_pprheap_base etux_timer_the_heap =
-	STROLL_PPRHEAP_BASE_INIT;
-
 static inline __utils_nonull(1) __utils_const __utils_nothrow __returns_nonull
 struct etux_timer *
 etux_timer_from_heap_node(const struct stroll_pprheap_node * __restrict node)
@@ -55,14 +52,88 @@ etux_timer_heap_tick_cmp(
 	return (fst->tick > snd->tick) - (fst->tick < snd->tick);
 }
 
+/******************************************************************************
+ * Lazy cancelation handling
+ ******************************************************************************/
+
+#if defined(CONFIG_ETUX_TIMER_HEAP_LAZY)
+
+static inline __utils_nonull(1) __utils_nothrow
+void
+etux_timer_heap_link(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+
+	base->lazy.nodes++;
+}
+
+static inline __utils_nonull(1) __utils_nothrow
+void
+etux_timer_heap_unlink(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(base->lazy.nodes);
+	etux_timer_assert_intern(base->lazy.dead <= base->lazy.nodes);
+
+	base->lazy.nodes--;
+}
+
+/*
+ * Mark a pending timer as dead instead of removing it from the heap when lazy
+ * cancelation is enabled.
+ */
+static inline __utils_nonull(1, 2) __utils_nothrow __warn_result
+bool
+etux_timer_heap_bury(struct etux_timer_base * __restrict base,
+                     struct etux_timer * __restrict      timer)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(base->lazy.ratio <= 100);
+	etux_timer_assert_intern(timer);
+	etux_timer_assert_intern(timer->state == ETUX_TIMER_PEND_STAT);
+
+	if (!base->lazy.ratio)
+		return false;
+
+	timer->state = ETUX_TIMER_DEAD_STAT;
+	base->lazy.dead++;
+	etux_timer_assert_intern(base->lazy.dead <= base->lazy.nodes);
+
+	return true;
+}
+
+#else  /* !defined(CONFIG_ETUX_TIMER_HEAP_LAZY) */
+
+static inline
+void
+etux_timer_heap_link(struct etux_timer_base * __restrict base __unused)
+{
+}
+
+static inline
+void
+etux_timer_heap_unlink(struct etux_timer_base * __restrict base __unused)
+{
+}
+
+static inline __warn_result
+bool
+etux_timer_heap_bury(struct etux_timer_base * __restrict base __unused,
+                     struct etux_timer * __restrict      timer __unused)
+{
+	return false;
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_HEAP_LAZY) */
+
 static __utils_nonull(1, 2) __utils_nothrow
 void
-etux_timer_heap_insert(struct stroll_pprheap_base * __restrict heap,
-                       struct etux_timer * __restrict          timer,
-                       int64_t                                 tick)
+etux_timer_heap_insert(struct etux_timer_base * __restrict base,
+                       struct etux_timer * __restrict      timer,
+                       int64_t                             tick)
 
 {
-	etux_timer_assert_intern(heap);
+	etux_timer_assert_intern(base);
 	etux_timer_assert_timer_intern(timer);
 	etux_timer_assert_intern(timer->expire);
 	etux_timer_assert_intern(tick >= 0);
@@ -71,10 +142,35 @@ etux_timer_heap_insert(struct stroll_pprheap_base * __restrict heap,
 	timer->state = ETUX_TIMER_PEND_STAT;
 	timer->tick = tick;
 
-	stroll_pprheap_base_insert(heap,
+	stroll_pprheap_base_insert(&base->heap,
+	                           &timer->heap,
+	                           etux_timer_heap_tick_cmp,
+	                           NULL);
+	etux_timer_heap_link(base);
+}
+
+static __utils_nonull(1, 2) __utils_nothrow
+void
+etux_timer_heap_unqueue(struct etux_timer_base * __restrict base,
+                        struct etux_timer * __restrict      timer)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_timer_intern(timer);
+
+	stroll_pprheap_base_remove(&base->heap,
 	                           &timer->heap,
 	                           etux_timer_heap_tick_cmp,
 	                           NULL);
+	etux_timer_heap_unlink(base);
+}
+
+static __utils_nonull(1, 2) __utils_nothrow
+void
+etux_timer_heap_remove(struct etux_timer_base * __restrict base,
+                       struct etux_timer * __restrict      timer)
+{
+	timer->state = ETUX_TIMER_IDLE_STAT;
+	etux_timer_heap_unqueue(base, timer);
 }
 
 static __utils_nonull(1, 2) __utils_nothrow
@@ -110,30 +206,36 @@ etux_timer_heap_adjust(struct stroll_pprheap_base * __restrict heap,
 
 static __utils_nonull(1, 2) __utils_nothrow
 void
-etux_timer_heap_arm(struct stroll_pprheap_base * __restrict heap,
-                    struct etux_timer * __restrict          timer)
+etux_timer_heap_arm(struct etux_timer_base * __restrict base,
+                    struct etux_timer * __restrict      timer)
 
 {
-	etux_timer_assert_intern(heap);
+	etux_timer_assert_intern(base);
 	etux_timer_assert_timer_intern(timer);
 	etux_timer_assert_intern(timer->expire);
 
 	int64_t tick;
 
-	tick = etux_timer_tick_from_tspec_upper_clamp(&timer->tspec);
+	tick = etux_timer_expiry_tick(timer);
 
 	switch (timer->state) {
 	case ETUX_TIMER_IDLE_STAT:
-		etux_timer_heap_insert(heap, timer, tick);
+		etux_timer_heap_insert(base, timer, tick);
 		break;
 
 STROLL_IGNORE_WARN("-Wimplicit-fallthrough")
+#if defined(CONFIG_ETUX_TIMER_HEAP_LAZY)
+	case ETUX_TIMER_DEAD_STAT:
+		/* Revive a lazily canceled timer still linked into the heap. */
+		etux_timer_assert_intern(base->lazy.dead);
+		base->lazy.dead--;
+#endif /* defined(CONFIG_ETUX_TIMER_HEAP_LAZY) */
 	case ETUX_TIMER_RUN_STAT:
 		timer->state = ETUX_TIMER_PEND_STAT;
 STROLL_RESTORE_WARN
 
 	case ETUX_TIMER_PEND_STAT:
-		etux_timer_heap_adjust(heap, timer, tick);
+		etux_timer_heap_adjust(&base->heap, timer, tick);
 		break;
 
 	default:
@@ -142,94 +244,353 @@ STROLL_RESTORE_WARN
 }
 
 void
-etux_timer_arm_tspec(struct etux_timer * __restrict     timer,
-                     const struct timespec * __restrict tspec)
+etux_timer_base_arm_tspec(struct etux_timer_base * __restrict base,
+                          struct etux_timer * __restrict      timer,
+                          const struct timespec * __restrict  tspec)
 {
+	etux_timer_assert_api(base);
 	etux_timer_assert_timer_api(timer);
+	etux_timer_assert_pool_api(timer);
 	etux_timer_assert_api(timer->expire);
 	utime_assert_tspec_api(tspec);
 
 	etux_timer_arm_tspec_trace_enter(timer, tspec);
 
 	timer->tspec = *tspec;
-	etux_timer_heap_arm(&etux_timer_the_heap, timer);
+	etux_timer_stats_arm(base, timer);
+	etux_timer_heap_arm(base, timer);
 
 	etux_timer_arm_tspec_trace_exit(timer);
 }
 
 void
-etux_timer_arm_msec(struct etux_timer * __restrict timer, int msec)
+etux_timer_base_arm_msec(struct etux_timer_base * __restrict base,
+                         struct etux_timer * __restrict      timer,
+                         int                                 msec)
 {
+	etux_timer_assert_api(base);
 	etux_timer_assert_timer_api(timer);
+	etux_timer_assert_pool_api(timer);
 	etux_timer_assert_api(timer->expire);
 	etux_timer_assert_api(msec >= 0);
 
 	etux_timer_arm_msec_trace_enter(timer, msec);
 
-	utime_monotonic_now(&timer->tspec);
+	etux_timer_base_now(base, &timer->tspec);
 	utime_tspec_add_msec_clamp(&timer->tspec, msec);
 
-	etux_timer_heap_arm(&etux_timer_the_heap, timer);
+	etux_timer_stats_arm(base, timer);
+	etux_timer_heap_arm(base, timer);
 
 	etux_timer_arm_msec_trace_exit(timer);
 }
 
 void
-etux_timer_arm_sec(struct etux_timer * __restrict timer, int sec)
+etux_timer_base_arm_sec(struct etux_timer_base * __restrict base,
+                        struct etux_timer * __restrict      timer,
+                        int                                 sec)
 {
+	etux_timer_assert_api(base);
 	etux_timer_assert_timer_api(timer);
+	etux_timer_assert_pool_api(timer);
 	etux_timer_assert_api(timer->expire);
 	etux_timer_assert_api(sec >= 0);
 
 	etux_timer_arm_sec_trace_enter(timer, sec);
 
-	utime_monotonic_now(&timer->tspec);
+	etux_timer_base_now(base, &timer->tspec);
 	utime_tspec_add_sec_clamp(&timer->tspec, sec);
 
-	etux_timer_heap_arm(&etux_timer_the_heap, timer);
+	etux_timer_stats_arm(base, timer);
+	etux_timer_heap_arm(base, timer);
 
 	etux_timer_arm_sec_trace_exit(timer);
 }
 
 void
-etux_timer_cancel(struct etux_timer * __restrict timer)
+etux_timer_base_cancel(struct etux_timer_base * __restrict base,
+                       struct etux_timer * __restrict      timer)
 {
+	etux_timer_assert_api(base);
 	etux_timer_assert_timer_api(timer);
+	etux_timer_assert_pool_api(timer);
 
 	etux_timer_cancel_trace_enter(timer);
 
-	if (timer->state == ETUX_TIMER_PEND_STAT) {
-		timer->state = ETUX_TIMER_IDLE_STAT;
-		stroll_pprheap_base_remove(&etux_timer_the_heap,
-		                           &timer->heap,
+	switch (timer->state) {
+	case ETUX_TIMER_PEND_STAT:
+		etux_timer_stats_cancel(base);
+		if (!etux_timer_heap_bury(base, timer))
+			etux_timer_heap_remove(base, timer);
+		break;
+
+	case ETUX_TIMER_RUN_STAT:
+		/*
+		 * Canceled from its own expiry callback: remove it explicitly,
+		 * a lazily canceled timer located at the heap top would be
+		 * expired again by etux_timer_base_run().
+		 */
+		etux_timer_stats_cancel(base);
+		etux_timer_heap_remove(base, timer);
+		break;
+
+	default:
+		break;
+	}
+
+	etux_timer_cancel_trace_exit(timer);
+}
+
+/*
+ * Pairing heap insertion is a constant time merge of the inserted node with
+ * the heap root: there is no sift-up to save by building a sub-heap out of the
+ * batch first. Batching hence boils down to sharing the clock sample.
+ */
+void
+etux_timer_base_arm_many(struct etux_timer_base * __restrict    base,
+                         struct etux_timer * const * __restrict timers,
+                         unsigned int                           nr,
+                         const struct timespec * __restrict     tspec,
+                         const struct timespec * __restrict     now __unused)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(timers);
+	etux_timer_assert_intern(tspec);
+
+	unsigned int t;
+
+	for (t = 0; t < nr; t++) {
+		struct etux_timer * tmr = timers[t];
+
+		etux_timer_assert_timer_api(tmr);
+		etux_timer_assert_pool_api(tmr);
+		etux_timer_assert_api(tmr->expire);
+
+		etux_timer_arm_tspec_trace_enter(tmr, tspec);
+
+		tmr->tspec = *tspec;
+		etux_timer_stats_arm(base, tmr);
+		etux_timer_heap_arm(base, tmr);
+
+		etux_timer_arm_tspec_trace_exit(tmr);
+	}
+}
+
+void
+etux_timer_base_cancel_many(struct etux_timer_base * __restrict    base,
+                            struct etux_timer * const * __restrict timers,
+                            unsigned int                           nr)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_api(timers);
+
+	unsigned int t;
+
+	for (t = 0; t < nr; t++)
+		etux_timer_base_cancel(base, timers[t]);
+}
+
+#if defined(CONFIG_ETUX_TIMER_HEAP_LAZY)
+
+/*
+ * Remove dead timers located at the top of the heap, then tell whether the heap
+ * holds pending timers or not.
+ */
+static __utils_nonull(1) __utils_nothrow __warn_result
+bool
+etux_timer_heap_isempty(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+
+	while (base->lazy.dead) {
+		struct etux_timer * tmr;
+
+		tmr = etux_timer_heap_lead_timer(&base->heap);
+		if (tmr->state != ETUX_TIMER_DEAD_STAT)
+			return false;
+
+		base->lazy.dead--;
+		etux_timer_heap_remove(base, tmr);
+	}
+
+	return stroll_pprheap_base_isempty(&base->heap);
+}
+
+/*
+ * Remove all dead timers from the heap.
+ *
+ * The heap is emptied and its live timers are collected into a temporary list
+ * before being re-inserted: a timer's list node may be used once its heap node
+ * has been removed since they share the same storage.
+ */
+static __utils_nonull(1) __utils_nothrow
+void
+etux_timer_heap_compact(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+
+	struct stroll_dlist_node live = STROLL_DLIST_INIT(live);
+	struct etux_timer *      tmr;
+	struct etux_timer *      tmp;
+
+	while (!stroll_pprheap_base_isempty(&base->heap)) {
+		tmr = etux_timer_heap_lead_timer(&base->heap);
+		stroll_pprheap_base_remove(&base->heap,
+		                           &tmr->heap,
 		                           etux_timer_heap_tick_cmp,
 		                           NULL);
+		if (tmr->state == ETUX_TIMER_DEAD_STAT)
+			tmr->state = ETUX_TIMER_IDLE_STAT;
+		else
+			stroll_dlist_nqueue_back(&live, &tmr->list);
 	}
 
-	etux_timer_cancel_trace_exit(timer);
+	base->lazy.nodes = 0;
+	base->lazy.dead = 0;
+
+	stroll_dlist_foreach_entry_safe(&live, tmr, list, tmp) {
+		stroll_dlist_remove(&tmr->list);
+		stroll_pprheap_base_insert(&base->heap,
+		                           &tmr->heap,
+		                           etux_timer_heap_tick_cmp,
+		                           NULL);
+		etux_timer_heap_link(base);
+	}
+}
+
+/*
+ * Compact the heap once dead timers make up more than the configured ratio of
+ * heap nodes so that heap size stays bounded.
+ */
+static __utils_nonull(1) __utils_nothrow
+void
+etux_timer_heap_tidy(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(base->lazy.dead <= base->lazy.nodes);
+
+	if (((unsigned long)base->lazy.dead * 100UL) >
+	    ((unsigned long)base->lazy.ratio * base->lazy.nodes))
+		etux_timer_heap_compact(base);
+}
+
+void
+etux_timer_base_setup_lazy(struct etux_timer_base * __restrict base,
+                           unsigned int                        ratio)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_api(ratio <= 100);
+
+	base->lazy.ratio = ratio;
+	if (!ratio && base->lazy.dead)
+		etux_timer_heap_compact(base);
+}
+
+void
+etux_timer_base_detach(struct etux_timer_base * __restrict base,
+                       struct etux_timer * __restrict      timer)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_timer_api(timer);
+
+	switch (timer->state) {
+	case ETUX_TIMER_PEND_STAT:
+		etux_timer_stats_cancel(base);
+		etux_timer_heap_remove(base, timer);
+		break;
+
+	case ETUX_TIMER_DEAD_STAT:
+		etux_timer_assert_intern(base->lazy.dead);
+		base->lazy.dead--;
+		etux_timer_heap_remove(base, timer);
+		break;
+
+	default:
+		break;
+	}
+}
+
+void
+etux_timer_setup_lazy(unsigned int ratio)
+{
+	etux_timer_base_setup_lazy(&etux_timer_dflt_base, ratio);
+}
+
+void
+etux_timer_detach(struct etux_timer * __restrict timer)
+{
+	etux_timer_base_detach(&etux_timer_dflt_base, timer);
 }
 
+static inline __utils_nonull(1) __utils_nothrow
+void
+etux_timer_heap_init_lazy(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_intern(base);
+
+	base->lazy.nodes = 0;
+	base->lazy.dead = 0;
+	base->lazy.ratio = 0;
+}
+
+#else  /* !defined(CONFIG_ETUX_TIMER_HEAP_LAZY) */
+
+static inline __utils_nonull(1) __utils_nothrow __warn_result
+bool
+etux_timer_heap_isempty(struct etux_timer_base * __restrict base)
+{
+	return stroll_pprheap_base_isempty(&base->heap);
+}
+
+static inline
+void
+etux_timer_heap_compact(struct etux_timer_base * __restrict base __unused)
+{
+}
+
+static inline
+void
+etux_timer_heap_tidy(struct etux_timer_base * __restrict base __unused)
+{
+}
+
+static inline
+void
+etux_timer_heap_init_lazy(struct etux_timer_base * __restrict base __unused)
+{
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_HEAP_LAZY) */
+
 int64_t
-etux_timer_issue_tick(void)
+etux_timer_base_issue_tick(struct etux_timer_base * __restrict base)
 {
-	if (!stroll_pprheap_base_isempty(&etux_timer_the_heap))
-		return etux_timer_heap_lead_timer(&etux_timer_the_heap)->tick;
+	etux_timer_assert_intern(base);
+
+	if (!etux_timer_heap_isempty(base))
+		return etux_timer_heap_lead_timer(&base->heap)->tick;
 	else
 		return (int64_t)-ENOENT;
 }
 
 void
-etux_timer_run(void)
+etux_timer_base_run(struct etux_timer_base * base)
 {
+	etux_timer_assert_api(base);
+
 	int64_t         tick = -1;
 	struct timespec now;
 
 	etux_timer_run_trace_enter();
 
-	while (!stroll_pprheap_base_isempty(&etux_timer_the_heap)) {
+	etux_timer_base_cache_clock(base);
+	etux_timer_remote_drain(base);
+	etux_timer_heap_tidy(base);
+
+	while (!etux_timer_heap_isempty(base)) {
 		struct etux_timer * tmr;
 
-		tmr = etux_timer_heap_lead_timer(&etux_timer_the_heap);
+		tmr = etux_timer_heap_lead_timer(&base->heap);
 		if (tick < tmr->tick) {
 			tick = etux_timer_tick_load(&now);
 			if (tick < tmr->tick)
@@ -237,19 +598,77 @@ etux_timer_run(void)
 		}
 
 		tmr->state = ETUX_TIMER_RUN_STAT;
+		etux_timer_stats_expire(base, tmr, tick);
+		if (tmr->period)
+			etux_timer_count_overrun(tmr, tick);
+
+		if (etux_timer_pool_enabled(base)) {
+			etux_timer_heap_unqueue(base, tmr);
+			etux_timer_pool_submit(base, tmr);
+			continue;
+		}
 
 		etux_timer_expire_trace_enter(tmr, &now, tick);
 		tmr->expire(tmr);
 		etux_timer_expire_trace_exit(tmr);
 
 		if (tmr->state == ETUX_TIMER_RUN_STAT) {
-			tmr->state = ETUX_TIMER_IDLE_STAT;
-			stroll_pprheap_base_extract(&etux_timer_the_heap,
-			                            etux_timer_heap_tick_cmp,
-			                            NULL);
+			if (!tmr->period) {
+				/*
+				 * Expiry callback may have armed timers
+				 * expiring earlier than tmr: remove tmr
+				 * explicitly rather than extracting the heap
+				 * top.
+				 */
+				etux_timer_stats_idle(base);
+				etux_timer_heap_remove(base, tmr);
+			}
+			else {
+				etux_timer_forward(tmr, tick);
+				etux_timer_heap_arm(base, tmr);
+			}
 		}
 	}
 
 out:
 	etux_timer_run_trace_exit();
 }
+
+#if defined(CONFIG_ETUX_TIMER_POOL)
+
+void
+etux_timer_base_resume(struct etux_timer_base * __restrict base,
+                       struct etux_timer * __restrict      timer)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(timer->state == ETUX_TIMER_RUN_STAT);
+
+	timer->state = ETUX_TIMER_IDLE_STAT;
+	etux_timer_heap_arm(base, timer);
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_POOL) */
+
+void
+etux_timer_base_init(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_api(base);
+
+	stroll_pprheap_base_init(&base->heap);
+	etux_timer_heap_init_lazy(base);
+
+	etux_timer_remote_init(base);
+	etux_timer_stats_init(base);
+	etux_timer_clock_init(base);
+}
+
+void
+etux_timer_base_fini(struct etux_timer_base * __restrict base __unused)
+{
+	etux_timer_assert_api(base);
+
+	etux_timer_heap_compact(base);
+	etux_timer_assert_api(stroll_pprheap_base_isempty(&base->heap));
+
+	etux_timer_remote_fini(base);
+}
@@ -6,79 +6,296 @@
  ******************************************************************************/
 
 #include "common.h"
+#include <stdlib.h>
 #include <errno.h>
 
-#define ETUX_TIMER_HWHEEL_SLOT_BITS \
-	(6U)
+/*
+ * Number of timing wheel levels of bases initialized using
+ * etux_timer_base_init().
+ * May be overridden by including source file (see hybrid.c).
+ */
+#if !defined(ETUX_TIMER_HWHEEL_DFLT_LEVELS)
+#define ETUX_TIMER_HWHEEL_DFLT_LEVELS ETUX_TIMER_HWHEEL_LEVELS_NR
+#endif /* !defined(ETUX_TIMER_HWHEEL_DFLT_LEVELS) */
+
+static inline __utils_nonull(1) __utils_const __utils_nothrow __returns_nonull
+struct etux_timer_base *
+etux_timer_hwheel_base(struct etux_timer_hwheel * __restrict hwheel)
+{
+	etux_timer_assert_intern(hwheel);
 
-#define ETUX_TIMER_HWHEEL_SLOT_MASK \
-	((INT64_C(1) << ETUX_TIMER_HWHEEL_SLOT_BITS) - 1)
+	return containerof(hwheel, struct etux_timer_base, hwheel);
+}
 
-#define ETUX_TIMER_HWHEEL_SLOTS_PER_WHEEL \
-	(1U << ETUX_TIMER_HWHEEL_SLOT_BITS)
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __warn_result
+unsigned int
+etux_timer_hwheel_slots_nr(const struct etux_timer_hwheel * __restrict hwheel)
+{
+	etux_timer_assert_intern(hwheel);
+
+	return 1U << hwheel->bits;
+}
+
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __warn_result
+int64_t
+etux_timer_hwheel_slot_mask(const struct etux_timer_hwheel * __restrict hwheel)
+{
+	etux_timer_assert_intern(hwheel);
+
+	return (INT64_C(1) << hwheel->bits) - 1;
+}
 
 /*
- * Setup maximum depth of hierarchical timing wheel.
- *
- * The table below gives time ranges that the hwheel may handle according to
- * to allowed ETUX_TIMER_TICK_SUBSEC_BITS values:
- *                                                      Tick                Time
- *                                    Time period  frequency  Hierarchy    range
- *    ETUX_TIMER_TICK_SUBSEC_BITS  (milliseconds)    (Hertz)     levels   (days)
- *                              0     1000.000000          1          4     >194
- *                              1      500.000000          2          4      >97
- *                              2      250.000000          4          4      >48
- *                              3      125.000000          8          4      >24
- *                              4       62.500000         16          4      >12
- *                              5       31.250000         32          5     >388
- *                              6       15.625000         64          5     >194
- *                              7        7.812500        128          5      >97
- *                              8        3.906250        256          5      >48
- *                              9        1.953125        512          5      >24
+ * Maximum number of wheel ticks that the hierarchical timer wheel may handle
+ * (without accounting for eternal timer heap).
+ */
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __warn_result
+int64_t
+etux_timer_hwheel_ticks_nr(const struct etux_timer_hwheel * __restrict hwheel)
+{
+	etux_timer_assert_intern(hwheel);
+
+	return INT64_C(1) << (hwheel->bits * hwheel->levels);
+}
+
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __returns_nonull
+struct stroll_dlist_node *
+etux_timer_hwheel_slot(const struct etux_timer_hwheel * __restrict hwheel,
+                       unsigned int                                level,
+                       unsigned int                                slot)
+{
+	etux_timer_assert_intern(hwheel);
+	etux_timer_assert_intern(level < hwheel->levels);
+	etux_timer_assert_intern(slot < etux_timer_hwheel_slots_nr(hwheel));
+
+	return &hwheel->slots[(level << hwheel->bits) + slot];
+}
+
+/*
+ * Convert a timer tick, already rounded to the wheel tick period (see
+ * etux_timer_hwheel_round_tick()), to wheel ticks.
  */
-#if ETUX_TIMER_TICK_SUBSEC_BITS < 5
-#define ETUX_TIMER_HWHEEL_LEVELS_NR (4U)
-#else  /* !(ETUX_TIMER_TICK_SUBSEC_BITS < 5) */
-#define ETUX_TIMER_HWHEEL_LEVELS_NR (5U)
-#endif /* ETUX_TIMER_TICK_SUBSEC_BITS < 5 */
+static inline __utils_nonull(1, 2) __utils_pure __utils_nothrow __warn_result
+int64_t
+etux_timer_hwheel_timer_tick(const struct etux_timer_hwheel * __restrict hwheel,
+                             const struct etux_timer * __restrict        timer)
+{
+	etux_timer_assert_intern(hwheel);
+	etux_timer_assert_intern(timer);
+	etux_timer_assert_intern(timer->tick >= 0);
+
+	return timer->tick >> hwheel->shift;
+}
 
 /*
- * Maximum number of ticks that the hierarchical timer wheel may handle (without
- * accounting for sorted eternal timer list).
+ * Round a timer tick up to the next wheel tick boundary so that timers never
+ * expire early.
  */
-#define ETUX_TIMER_HWHEEL_TICKS_NR \
-	(INT64_C(1) << (ETUX_TIMER_HWHEEL_SLOT_BITS * \
-	                ETUX_TIMER_HWHEEL_LEVELS_NR))
-
-struct etux_timer_hwheel {
-	unsigned int             count;
-	int64_t                  tick;
-	int64_t                  issue;
-	struct stroll_dlist_node slots[ETUX_TIMER_HWHEEL_LEVELS_NR]
-	                              [ETUX_TIMER_HWHEEL_SLOTS_PER_WHEEL];
-	struct stroll_dlist_node eternal;
-};
-
-static struct etux_timer_hwheel etux_timer_the_hwheel;
-
-static __utils_nothrow __warn_result
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __warn_result
 int64_t
-etux_timer_hwheel_tick(void)
+etux_timer_hwheel_round_tick(const struct etux_timer_hwheel * __restrict hwheel,
+                             int64_t                                     tick)
 {
+	etux_timer_assert_intern(hwheel);
+	etux_timer_assert_intern(tick >= 0);
+	etux_timer_assert_intern(tick <= ETUX_TIMER_TICK_MAX);
+
+	int64_t mask = (INT64_C(1) << hwheel->shift) - 1;
+
+	if (tick <= (ETUX_TIMER_TICK_MAX - mask))
+		return (tick + mask) & ~mask;
+
+	return ETUX_TIMER_TICK_MAX & ~mask;
+}
+
+static __utils_nonull(1) __utils_nothrow __warn_result
+int64_t
+etux_timer_hwheel_tick(const struct etux_timer_hwheel * __restrict hwheel)
+{
+	etux_timer_assert_intern(hwheel);
+
 	struct timespec now;
 
-	return etux_timer_tick_load(&now);
+	return etux_timer_tick_load(&now) >> hwheel->shift;
 }
 
-static __utils_nothrow
+static __utils_nonull(1) __utils_nothrow
 void
-etux_timer_hwheel_refresh_tick(const struct timespec * __restrict now)
+etux_timer_hwheel_refresh_tick(struct etux_timer_hwheel * __restrict hwheel,
+                               const struct timespec * __restrict    now)
 {
+	etux_timer_assert_intern(hwheel);
+
 	if (now)
-		etux_timer_the_hwheel.tick =
-			etux_timer_tick_from_tspec_lower_clamp(now);
+		hwheel->tick = etux_timer_tick_from_tspec_lower_clamp(now) >>
+		               hwheel->shift;
 	else
-		etux_timer_the_hwheel.tick = etux_timer_hwheel_tick();
+		hwheel->tick = etux_timer_hwheel_tick(hwheel);
+}
+
+static inline __utils_const __utils_nothrow __warn_result
+uint64_t
+etux_timer_hwheel_slot_bit(unsigned int slot)
+{
+	etux_timer_assert_intern(slot <
+	                         (1U << ETUX_TIMER_HWHEEL_SLOT_BITS_MAX));
+
+	return UINT64_C(1) << slot;
+}
+
+/*
+ * Rotate occupancy bitmap of a `nr' slots wide wheel right so that bit 0 of
+ * the result matches slot `start'. Finding the next occupied slot starting
+ * from `start' (included) then boils down to counting trailing zeros of the
+ * result.
+ */
+static inline __utils_const __utils_nothrow __warn_result
+uint64_t
+etux_timer_hwheel_rotate_bitmap(uint64_t     bitmap,
+                                unsigned int start,
+                                unsigned int nr)
+{
+	etux_timer_assert_intern(nr > 1);
+	etux_timer_assert_intern(nr <= (1U << ETUX_TIMER_HWHEEL_SLOT_BITS_MAX));
+	etux_timer_assert_intern(start < nr);
+	etux_timer_assert_intern(!(bitmap & ~(UINT64_MAX >> (64 - nr))));
+
+	if (!start)
+		return bitmap;
+
+	return ((bitmap >> start) | (bitmap << (nr - start))) &
+	       (UINT64_MAX >> (64 - nr));
+}
+
+static inline __utils_const __utils_nothrow __warn_result
+unsigned int
+etux_timer_hwheel_first_slot(uint64_t bitmap)
+{
+	etux_timer_assert_intern(bitmap);
+
+	return (unsigned int)__builtin_ctzll(bitmap);
+}
+
+static inline __utils_nonull(1) __utils_const __utils_nothrow __returns_nonull
+struct etux_timer *
+etux_timer_hwheel_from_heap_node(
+	const struct stroll_pprheap_node * __restrict node)
+{
+	etux_timer_assert_intern(node);
+
+	return stroll_pprheap_entry(node, struct etux_timer, heap);
+}
+
+static __utils_nonull(1, 2) __utils_pure __utils_nothrow __warn_result
+int
+etux_timer_hwheel_eternal_cmp(
+	const struct stroll_pprheap_node * __restrict first,
+	const struct stroll_pprheap_node * __restrict second,
+	void *                                        data __unused)
+{
+	etux_timer_assert_intern(first);
+	etux_timer_assert_intern(second);
+
+	const struct etux_timer * fst = etux_timer_hwheel_from_heap_node(first);
+	const struct etux_timer * snd = etux_timer_hwheel_from_heap_node(second);
+
+	etux_timer_assert_intern(fst->tick >= 0);
+	etux_timer_assert_intern(snd->tick >= 0);
+
+	return (fst->tick > snd->tick) - (fst->tick < snd->tick);
+}
+
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __returns_nonull
+struct etux_timer *
+etux_timer_hwheel_eternal_lead(
+	const struct etux_timer_hwheel * __restrict hwheel)
+{
+	etux_timer_assert_intern(hwheel);
+	etux_timer_assert_intern(!stroll_pprheap_base_isempty(&hwheel->eternal));
+
+	struct etux_timer * tmr = etux_timer_hwheel_from_heap_node(
+		stroll_pprheap_base_peek(&hwheel->eternal));
+
+	etux_timer_assert_intern(tmr->eternal);
+	etux_timer_assert_intern(tmr->expire);
+
+	return tmr;
+}
+
+static __utils_nonull(1, 2) __utils_nothrow
+void
+etux_timer_hwheel_eternal_insert(struct etux_timer_hwheel * __restrict hwheel,
+                                 struct etux_timer * __restrict        timer)
+{
+	etux_timer_assert_intern(hwheel);
+	etux_timer_assert_intern(timer);
+	etux_timer_assert_intern(!timer->eternal);
+
+	timer->eternal = true;
+	stroll_pprheap_base_insert(&hwheel->eternal,
+	                           &timer->heap,
+	                           etux_timer_hwheel_eternal_cmp,
+	                           NULL);
+	etux_timer_stats_enter_eternal(etux_timer_hwheel_base(hwheel));
+}
+
+static __utils_nonull(1, 2) __utils_nothrow
+void
+etux_timer_hwheel_eternal_remove(struct etux_timer_hwheel * __restrict hwheel,
+                                 struct etux_timer * __restrict        timer)
+{
+	etux_timer_assert_intern(hwheel);
+	etux_timer_assert_intern(timer);
+	etux_timer_assert_intern(timer->eternal);
+
+	stroll_pprheap_base_remove(&hwheel->eternal,
+	                           &timer->heap,
+	                           etux_timer_hwheel_eternal_cmp,
+	                           NULL);
+	timer->eternal = false;
+	etux_timer_stats_leave_eternal(etux_timer_hwheel_base(hwheel));
+}
+
+/*
+ * Remove timer from the slot or eternal heap it is currently linked into and
+ * clear the matching occupancy bit when the slot becomes empty.
+ */
+static __utils_nonull(1, 2) __utils_nothrow
+void
+etux_timer_hwheel_dismiss(struct etux_timer_hwheel * __restrict hwheel,
+                          struct etux_timer * __restrict        timer)
+{
+	etux_timer_assert_intern(hwheel);
+	etux_timer_assert_intern(timer);
+
+	const struct stroll_dlist_node * next;
+	uintptr_t                        off;
+
+	if (timer->eternal) {
+		etux_timer_hwheel_eternal_remove(hwheel, timer);
+		return;
+	}
+
+	next = stroll_dlist_next(&timer->list);
+	stroll_dlist_remove(&timer->list);
+	if (!stroll_dlist_empty(next))
+		return;
+
+	/*
+	 * Slot is empty now and `next' points to its head. Find out which
+	 * slot it is, if any (timer might have been linked into the local
+	 * list of expired timers for example).
+	 */
+	off = (uintptr_t)next - (uintptr_t)hwheel->slots;
+	if (off < (((uintptr_t)hwheel->levels << hwheel->bits) *
+	           sizeof(*next))) {
+		unsigned int idx = (unsigned int)(off / sizeof(*next));
+
+		hwheel->bitmaps[idx >> hwheel->bits] &=
+			~etux_timer_hwheel_slot_bit(
+				idx & (unsigned int)
+				      etux_timer_hwheel_slot_mask(hwheel));
+	}
 }
 
 static __utils_nonull(1, 2) __utils_nothrow
@@ -91,22 +308,29 @@ etux_timer_hwheel_enlist(struct etux_timer_hwheel * __restrict hwheel,
 	etux_timer_assert_intern(timer);
 	etux_timer_assert_intern(timer->expire);
 	etux_timer_assert_intern(timeout >= 0);
-	etux_timer_assert_intern(timeout < ETUX_TIMER_HWHEEL_TICKS_NR);
+	etux_timer_assert_intern(timeout < etux_timer_hwheel_ticks_nr(hwheel));
 
 	unsigned int lvl;
 	unsigned int slot;
 
-#define ETUX_TIMER_HWHEEL_TMOUT_MIN(_level) \
-(INT64_C(1) << ((_level) * ETUX_TIMER_HWHEEL_SLOT_BITS))
-	for (lvl = 0; lvl < ETUX_TIMER_HWHEEL_LEVELS_NR; lvl++) {
-		if (timeout < ETUX_TIMER_HWHEEL_TMOUT_MIN(lvl + 1))
+	for (lvl = 0; lvl < hwheel->levels; lvl++) {
+		if (timeout < (INT64_C(1) << ((lvl + 1) * hwheel->bits)))
 			break;
 	}
 
-	etux_timer_assert_intern(lvl < ETUX_TIMER_HWHEEL_LEVELS_NR);
-	slot = (timer->tick >> (lvl * ETUX_TIMER_HWHEEL_SLOT_BITS)) &
-	       ETUX_TIMER_HWHEEL_SLOT_MASK;
-	stroll_dlist_insert(&hwheel->slots[lvl][slot], &timer->list);
+	etux_timer_assert_intern(lvl < hwheel->levels);
+
+	/*
+	 * Compute slot from the current wheel tick rather than from the timer
+	 * tick so that timers armed with an expiry date in the past are
+	 * enlisted into the slot that will be processed next instead of a
+	 * slot located a full wheel rotation away.
+	 */
+	slot = (unsigned int)(((hwheel->tick + timeout) >> (lvl * hwheel->bits)) &
+	                      etux_timer_hwheel_slot_mask(hwheel));
+	stroll_dlist_insert(etux_timer_hwheel_slot(hwheel, lvl, slot),
+	                    &timer->list);
+	hwheel->bitmaps[lvl] |= etux_timer_hwheel_slot_bit(slot);
 }
 
 static __utils_nonull(1, 2) __utils_nothrow
@@ -121,15 +345,18 @@ etux_timer_hwheel_enroll(struct etux_timer_hwheel * __restrict hwheel,
 	etux_timer_assert_intern(tick >= 0);
 	etux_timer_assert_intern(tick <= ETUX_TIMER_TICK_MAX);
 
-	int64_t tmout = stroll_max(tick, hwheel->tick) - hwheel->tick;
+	int64_t tmout;
 
 	timer->tick = tick;
+	tmout = stroll_max(etux_timer_hwheel_timer_tick(hwheel, timer),
+	                   hwheel->tick) -
+	        hwheel->tick;
 
 	etux_timer_assert_intern(tmout >= 0);
-	if (tmout < ETUX_TIMER_HWHEEL_TICKS_NR)
+	if (tmout < etux_timer_hwheel_ticks_nr(hwheel))
 		etux_timer_hwheel_enlist(hwheel, timer, tmout);
 	else
-		etux_timer_insert_inorder(&hwheel->eternal, timer);
+		etux_timer_hwheel_eternal_insert(hwheel, timer);
 }
 
 static __utils_nonull(1) __utils_nothrow
@@ -144,11 +371,12 @@ etux_timer_hwheel_insert(struct etux_timer_hwheel * __restrict hwheel,
 
 	int64_t tick;
 
-	tick = etux_timer_tick_from_tspec_upper_clamp(&timer->tspec);
+	tick = etux_timer_hwheel_round_tick(hwheel,
+	                                    etux_timer_expiry_tick(timer));
 
 	if (!hwheel->count++)
-		etux_timer_hwheel_refresh_tick(now);
-	hwheel->issue = stroll_min(tick, hwheel->issue);
+		etux_timer_hwheel_refresh_tick(hwheel, now);
+	hwheel->issue = stroll_min(tick >> hwheel->shift, hwheel->issue);
 
 	timer->state = ETUX_TIMER_PEND_STAT;
 	etux_timer_hwheel_enroll(hwheel, timer, tick);
@@ -167,17 +395,18 @@ etux_timer_hwheel_adjust(struct etux_timer_hwheel * __restrict hwheel,
 
 	int64_t tick;
 
-	tick = etux_timer_tick_from_tspec_upper_clamp(&timer->tspec);
+	tick = etux_timer_hwheel_round_tick(hwheel,
+	                                    etux_timer_expiry_tick(timer));
 	if (timer->tick == tick)
 		return;
 
-	if (timer->tick == hwheel->issue)
+	if (etux_timer_hwheel_timer_tick(hwheel, timer) == hwheel->issue)
 		hwheel->issue = hwheel->tick;
-	hwheel->issue = stroll_min(tick, hwheel->issue);
+	hwheel->issue = stroll_min(tick >> hwheel->shift, hwheel->issue);
 	if (hwheel->count == 1)
-		etux_timer_hwheel_refresh_tick(now);
+		etux_timer_hwheel_refresh_tick(hwheel, now);
 
-	stroll_dlist_remove(&timer->list);
+	etux_timer_hwheel_dismiss(hwheel, timer);
 	etux_timer_hwheel_enroll(hwheel, timer, tick);
 }
 
@@ -194,14 +423,16 @@ etux_timer_hwheel_resched(struct etux_timer_hwheel * __restrict hwheel,
 
 	int64_t tick;
 
-	tick = etux_timer_tick_from_tspec_upper_clamp(&timer->tspec);
+	tick = etux_timer_hwheel_round_tick(hwheel,
+	                                    etux_timer_expiry_tick(timer));
 
+	/*
+	 * Always dismiss timer from the local expired list, even if its
+	 * rounded expiry tick did not change (period shorter than the wheel
+	 * tick or timer slack): it would be run again otherwise.
+	 */
 	timer->state = ETUX_TIMER_PEND_STAT;
-
-	if (timer->tick == tick)
-		return;
-
-	stroll_dlist_remove(&timer->list);
+	etux_timer_hwheel_dismiss(hwheel, timer);
 	etux_timer_hwheel_enroll(hwheel, timer, tick);
 }
 
@@ -233,25 +464,33 @@ etux_timer_hwheel_arm(struct etux_timer_hwheel * __restrict hwheel,
 }
 
 void
-etux_timer_arm_tspec(struct etux_timer * __restrict     timer,
-                     const struct timespec * __restrict tspec)
+etux_timer_base_arm_tspec(struct etux_timer_base * __restrict base,
+                          struct etux_timer * __restrict      timer,
+                          const struct timespec * __restrict  tspec)
 {
+	etux_timer_assert_api(base);
 	etux_timer_assert_timer_api(timer);
+	etux_timer_assert_pool_api(timer);
 	etux_timer_assert_api(timer->expire);
 	utime_assert_tspec_api(tspec);
 
 	etux_timer_arm_tspec_trace_enter(timer, tspec);
 
 	timer->tspec = *tspec;
-	etux_timer_hwheel_arm(&etux_timer_the_hwheel, timer, NULL);
+	etux_timer_stats_arm(base, timer);
+	etux_timer_hwheel_arm(&base->hwheel, timer, NULL);
 
 	etux_timer_arm_tspec_trace_exit(timer);
 }
 
 void
-etux_timer_arm_msec(struct etux_timer * __restrict timer, int msec)
+etux_timer_base_arm_msec(struct etux_timer_base * __restrict base,
+                         struct etux_timer * __restrict      timer,
+                         int                                 msec)
 {
+	etux_timer_assert_api(base);
 	etux_timer_assert_timer_api(timer);
+	etux_timer_assert_pool_api(timer);
 	etux_timer_assert_api(timer->expire);
 	etux_timer_assert_api(msec >= 0);
 
@@ -259,19 +498,24 @@ etux_timer_arm_msec(struct etux_timer * __restrict timer, int msec)
 
 	etux_timer_arm_msec_trace_enter(timer, msec);
 
-	utime_monotonic_now(&now);
+	etux_timer_base_now(base, &now);
 
 	timer->tspec = now;
 	utime_tspec_add_msec_clamp(&timer->tspec, msec);
-	etux_timer_hwheel_arm(&etux_timer_the_hwheel, timer, &now);
+	etux_timer_stats_arm(base, timer);
+	etux_timer_hwheel_arm(&base->hwheel, timer, &now);
 
 	etux_timer_arm_msec_trace_exit(timer);
 }
 
 void
-etux_timer_arm_sec(struct etux_timer * __restrict timer, int sec)
+etux_timer_base_arm_sec(struct etux_timer_base * __restrict base,
+                        struct etux_timer * __restrict      timer,
+                        int                                 sec)
 {
+	etux_timer_assert_api(base);
 	etux_timer_assert_timer_api(timer);
+	etux_timer_assert_pool_api(timer);
 	etux_timer_assert_api(timer->expire);
 	etux_timer_assert_api(sec >= 0);
 
@@ -279,61 +523,187 @@ etux_timer_arm_sec(struct etux_timer * __restrict timer, int sec)
 
 	etux_timer_arm_sec_trace_enter(timer, sec);
 
-	utime_monotonic_now(&now);
+	etux_timer_base_now(base, &now);
 
 	timer->tspec = now;
 	utime_tspec_add_sec_clamp(&timer->tspec, sec);
-	etux_timer_hwheel_arm(&etux_timer_the_hwheel, timer, &now);
+	etux_timer_stats_arm(base, timer);
+	etux_timer_hwheel_arm(&base->hwheel, timer, &now);
 
 	etux_timer_arm_sec_trace_exit(timer);
 }
 
 void
-etux_timer_cancel(struct etux_timer * __restrict timer)
+etux_timer_base_arm_many(struct etux_timer_base * __restrict    base,
+                         struct etux_timer * const * __restrict timers,
+                         unsigned int                           nr,
+                         const struct timespec * __restrict     tspec,
+                         const struct timespec * __restrict     now)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(timers);
+	etux_timer_assert_intern(tspec);
+
+	unsigned int t;
+
+	for (t = 0; t < nr; t++) {
+		struct etux_timer * tmr = timers[t];
+
+		etux_timer_assert_timer_api(tmr);
+		etux_timer_assert_pool_api(tmr);
+		etux_timer_assert_api(tmr->expire);
+
+		etux_timer_arm_tspec_trace_enter(tmr, tspec);
+
+		tmr->tspec = *tspec;
+		etux_timer_stats_arm(base, tmr);
+		etux_timer_hwheel_arm(&base->hwheel, tmr, now);
+
+		etux_timer_arm_tspec_trace_exit(tmr);
+	}
+}
+
+/*
+ * Tell whether a timer is linked into the wheel, i.e. either pending or
+ * running, in which case it is canceled from its own expiry callback and is
+ * still linked into the local list of expired timers.
+ */
+static inline __utils_nonull(1) __utils_pure __utils_nothrow __warn_result
+bool
+etux_timer_hwheel_cancelable(const struct etux_timer * __restrict timer)
+{
+	etux_timer_assert_intern(timer);
+
+	return (timer->state == ETUX_TIMER_PEND_STAT) ||
+	       (timer->state == ETUX_TIMER_RUN_STAT);
+}
+
+/*
+ * Remove a pending or running timer from the wheel, leaving the count of
+ * pending timers to the caller's care.
+ */
+static __utils_nonull(1, 2) __utils_nothrow
+void
+etux_timer_hwheel_cancel(struct etux_timer_base * __restrict base,
+                         struct etux_timer * __restrict      timer)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(etux_timer_hwheel_cancelable(timer));
+
+	struct etux_timer_hwheel * hwheel = &base->hwheel;
+
+	etux_timer_assert_intern(hwheel->count);
+
+	etux_timer_stats_cancel(base);
+
+	timer->state = ETUX_TIMER_IDLE_STAT;
+	etux_timer_hwheel_dismiss(hwheel, timer);
+
+	if (etux_timer_hwheel_timer_tick(hwheel, timer) == hwheel->issue)
+		hwheel->issue = hwheel->tick;
+}
+
+void
+etux_timer_base_cancel(struct etux_timer_base * __restrict base,
+                       struct etux_timer * __restrict      timer)
 {
+	etux_timer_assert_api(base);
 	etux_timer_assert_timer_api(timer);
+	etux_timer_assert_pool_api(timer);
 
 	etux_timer_cancel_trace_enter(timer);
 
-	if (timer->state == ETUX_TIMER_PEND_STAT) {
-		timer->state = ETUX_TIMER_IDLE_STAT;
-		stroll_dlist_remove(&timer->list);
-
-		if (timer->tick == etux_timer_the_hwheel.issue)
-			etux_timer_the_hwheel.issue =
-				etux_timer_the_hwheel.tick;
+	if (etux_timer_hwheel_cancelable(timer)) {
+		struct etux_timer_hwheel * hwheel = &base->hwheel;
 
-		if (!--etux_timer_the_hwheel.count)
-			etux_timer_the_hwheel.tick = etux_timer_hwheel_tick();
+		etux_timer_hwheel_cancel(base, timer);
+		if (!--hwheel->count)
+			hwheel->tick = etux_timer_hwheel_tick(hwheel);
 	}
 
 	etux_timer_cancel_trace_exit(timer);
 }
 
-static __utils_nonull(1, 2) __utils_nothrow
+void
+etux_timer_base_cancel_many(struct etux_timer_base * __restrict    base,
+                            struct etux_timer * const * __restrict timers,
+                            unsigned int                           nr)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_api(timers);
+
+	struct etux_timer_hwheel * hwheel = &base->hwheel;
+	unsigned int               cnt = 0;
+	unsigned int               t;
+
+	for (t = 0; t < nr; t++) {
+		struct etux_timer * tmr = timers[t];
+
+		etux_timer_assert_timer_api(tmr);
+		etux_timer_assert_pool_api(tmr);
+
+		etux_timer_cancel_trace_enter(tmr);
+
+		if (etux_timer_hwheel_cancelable(tmr)) {
+			etux_timer_hwheel_cancel(base, tmr);
+			cnt++;
+		}
+
+		etux_timer_cancel_trace_exit(tmr);
+	}
+
+	/*
+	 * Update the count of pending timers and resynchronize the wheel with
+	 * the clock once for the whole batch.
+	 */
+	if (cnt) {
+		etux_timer_assert_intern(hwheel->count >= cnt);
+
+		hwheel->count -= cnt;
+		if (!hwheel->count)
+			hwheel->tick = etux_timer_hwheel_tick(hwheel);
+	}
+}
+
+static __utils_nonull(1) __utils_nothrow
 void
 etux_timer_hwheel_cascade_timers(struct etux_timer_hwheel * __restrict hwheel,
-                                 struct stroll_dlist_node * __restrict timers)
+                                 unsigned int                          level,
+                                 unsigned int                          slot)
 {
 	etux_timer_assert_intern(hwheel);
-	etux_timer_assert_intern(timers);
+	etux_timer_assert_intern(level);
+	etux_timer_assert_intern(level < hwheel->levels);
+	etux_timer_assert_intern(slot < etux_timer_hwheel_slots_nr(hwheel));
+
+	uint64_t bit = etux_timer_hwheel_slot_bit(slot);
 
-	if (!stroll_dlist_empty(timers)) {
-		struct stroll_dlist_node head = STROLL_DLIST_INIT(head);
-		struct etux_timer *      tmr;
-		struct etux_timer *      tmp;
+	if (hwheel->bitmaps[level] & bit) {
+		struct stroll_dlist_node * timers =
+			etux_timer_hwheel_slot(hwheel, level, slot);
+		struct stroll_dlist_node   head = STROLL_DLIST_INIT(head);
+		struct etux_timer *        tmr;
+		struct etux_timer *        tmp;
 
+		etux_timer_assert_intern(!stroll_dlist_empty(timers));
+
+		hwheel->bitmaps[level] &= ~bit;
 		stroll_dlist_splice_after(&head,
 		                          stroll_dlist_next(timers),
 		                          stroll_dlist_prev(timers));
 		stroll_dlist_foreach_entry_safe(&head, tmr, list, tmp) {
-			int64_t tmout = stroll_max(tmr->tick, hwheel->tick) -
+			int64_t tmout = stroll_max(
+			                        etux_timer_hwheel_timer_tick(hwheel,
+			                                                     tmr),
+			                        hwheel->tick) -
 			                hwheel->tick;
 
 			etux_timer_assert_intern(tmout >= 0);
-			etux_timer_assert_intern(tmout <
-			                         ETUX_TIMER_HWHEEL_TICKS_NR);
+			etux_timer_assert_intern(
+				tmout < etux_timer_hwheel_ticks_nr(hwheel));
 			etux_timer_hwheel_enlist(hwheel, tmr, tmout);
+			etux_timer_stats_cascade(etux_timer_hwheel_base(hwheel),
+			                         level);
 		}
 	}
 }
@@ -344,19 +714,22 @@ etux_timer_hwheel_cascade_eternal(struct etux_timer_hwheel * __restrict hwheel)
 {
 	etux_timer_assert_intern(hwheel);
 
-	while (!stroll_dlist_empty(&hwheel->eternal)) {
+	while (!stroll_pprheap_base_isempty(&hwheel->eternal)) {
 		struct etux_timer * tmr;
 		int64_t             tmout;
 
-		tmr = etux_timer_list_lead_timer(&hwheel->eternal);
-		tmout = stroll_max(tmr->tick, hwheel->tick) - hwheel->tick;
+		tmr = etux_timer_hwheel_eternal_lead(hwheel);
+		tmout = stroll_max(etux_timer_hwheel_timer_tick(hwheel, tmr),
+		                   hwheel->tick) -
+		        hwheel->tick;
 
 		etux_timer_assert_intern(tmout >= 0);
-		if (tmout >= ETUX_TIMER_HWHEEL_TICKS_NR)
+		if (tmout >= etux_timer_hwheel_ticks_nr(hwheel))
 			break;
 
-		stroll_dlist_remove(&tmr->list);
+		etux_timer_hwheel_eternal_remove(hwheel, tmr);
 		etux_timer_hwheel_enlist(hwheel, tmr, tmout);
+		etux_timer_stats_migrate(etux_timer_hwheel_base(hwheel));
 	}
 }
 
@@ -369,13 +742,13 @@ etux_timer_hwheel_cascade(struct etux_timer_hwheel * __restrict hwheel)
 	unsigned int lvl;
 	int64_t      idx;
 
-	for (idx = hwheel->tick >> ETUX_TIMER_HWHEEL_SLOT_BITS, lvl = 1;
-	     lvl < ETUX_TIMER_HWHEEL_LEVELS_NR;
-	     idx >>= ETUX_TIMER_HWHEEL_SLOT_BITS, lvl++) {
-		int slot = idx & ETUX_TIMER_HWHEEL_SLOT_MASK;
+	for (idx = hwheel->tick >> hwheel->bits, lvl = 1;
+	     lvl < hwheel->levels;
+	     idx >>= hwheel->bits, lvl++) {
+		unsigned int slot = (unsigned int)
+		                    (idx & etux_timer_hwheel_slot_mask(hwheel));
 
-		etux_timer_hwheel_cascade_timers(hwheel,
-		                                 &hwheel->slots[lvl][slot]);
+		etux_timer_hwheel_cascade_timers(hwheel, lvl, slot);
 
 		if (slot)
 			return;
@@ -392,87 +765,110 @@ etux_timer_hwheel_cascade(struct etux_timer_hwheel * __restrict hwheel)
  *       level 1 timing wheel is required ;
  *    1: timer has been found and search is over.
  */
-static __utils_nonull(1) __utils_nothrow
+static __utils_nonull(1, 3) __utils_nothrow
 int
 etux_timer_hwheel_early_expiry(
-	const struct stroll_dlist_node * __restrict nodes,
+	const struct etux_timer_hwheel * __restrict hwheel,
 	int64_t                                     tick,
 	int64_t * __restrict                        issue)
 {
-	etux_timer_assert_intern(nodes);
+	etux_timer_assert_intern(hwheel);
 	etux_timer_assert_intern(tick <= ETUX_TIMER_TICK_MAX);
 	etux_timer_assert_intern(issue);
 
-	unsigned int start = tick & ETUX_TIMER_HWHEEL_SLOT_MASK;
-	unsigned int slot = start;
-
-	do {
-		if (!stroll_dlist_empty(&nodes[slot])) {
-			*issue = etux_timer_list_lead_timer(&nodes[slot])->tick;
-
-			/* Tell caller wether cascasding is needed or not. */
-			return (int)(start && (slot >= start));
-		}
-
-		slot = (slot + 1) & ETUX_TIMER_HWHEEL_SLOT_MASK;
-	} while (slot != start);
-
-	/* Tell caller that no timer has been found. */
-	return -1;
+	unsigned int nr = etux_timer_hwheel_slots_nr(hwheel);
+	unsigned int start = (unsigned int)(tick & (nr - 1));
+	uint64_t     bmap = etux_timer_hwheel_rotate_bitmap(hwheel->bitmaps[0],
+	                                                    start,
+	                                                    nr);
+	unsigned int off;
+
+	if (!bmap)
+		/* Tell caller that no timer has been found. */
+		return -1;
+
+	off = etux_timer_hwheel_first_slot(bmap);
+	*issue = etux_timer_hwheel_timer_tick(
+		hwheel,
+		etux_timer_list_lead_timer(
+			etux_timer_hwheel_slot(hwheel,
+			                       0,
+			                       (start + off) & (nr - 1))));
+
+	/* Tell caller wether cascasding is needed or not. */
+	return (int)(start && ((start + off) < nr));
 }
 
 /*
- * Find next timer expiry date within timing wheel slots given as `nodes'.
+ * Find next timer expiry date within timing wheel slots of level `level'.
  * Return value:
  *   -1: no timer found ;
  *    0: timer has been found but tell the caller that further searching within
  *       level 1 timing wheel is required ;
  *    1: timer has been found and search is over.
  */
-static __utils_nonull(1) __utils_nothrow
+static __utils_nonull(1, 5) __utils_nothrow
 int
 etux_timer_hwheel_cascade_expiry(
-	const struct stroll_dlist_node * __restrict nodes,
+	const struct etux_timer_hwheel * __restrict hwheel,
+	unsigned int                                level,
 	int                                         missing,
 	int64_t                                     tick,
 	int64_t * __restrict                        issue)
 {
-	etux_timer_assert_intern(nodes);
+	etux_timer_assert_intern(hwheel);
+	etux_timer_assert_intern(level);
+	etux_timer_assert_intern(level < hwheel->levels);
 	etux_timer_assert_intern(tick <= ETUX_TIMER_TICK_MAX);
 	etux_timer_assert_intern(missing <= 0);
 	etux_timer_assert_intern(issue);
 	etux_timer_assert_intern(*issue >= 0);
 	etux_timer_assert_intern(*issue <= ETUX_TIMER_TICK_MAX);
 
-	unsigned int start = tick & ETUX_TIMER_HWHEEL_SLOT_MASK;
-	unsigned int slot = start;
-	int64_t      expiry = *issue;
-
-	do {
-		const struct etux_timer * tmr;
-
-		stroll_dlist_foreach_entry(&nodes[slot], tmr, list) {
-			expiry = stroll_min(tmr->tick, expiry);
-			missing = 0;
-		}
+	unsigned int              nr = etux_timer_hwheel_slots_nr(hwheel);
+	unsigned int              start = (unsigned int)(tick & (nr - 1));
+	uint64_t                  bmap = etux_timer_hwheel_rotate_bitmap(
+	                                        hwheel->bitmaps[level],
+	                                        start,
+	                                        nr);
+	unsigned int              off;
+	int64_t                   expiry = *issue;
+	const struct etux_timer * tmr;
+
+	if (missing) {
+		/*
+		 * Nothing found within lower levels: search for the first
+		 * occupied slot.
+		 */
+		if (!bmap)
+			return -1;
+		off = etux_timer_hwheel_first_slot(bmap);
+	}
+	else {
+		/*
+		 * A timer has been found within lower levels: only timers
+		 * located into the current slot may expire earlier.
+		 */
+		if (!(bmap & 1))
+			return (int)!!start;
+		off = 0;
+	}
 
-		if (!missing)
-			break;
+	stroll_dlist_foreach_entry(
+		etux_timer_hwheel_slot(hwheel, level, (start + off) & (nr - 1)),
+		tmr,
+		list)
+		expiry = stroll_min(etux_timer_hwheel_timer_tick(hwheel, tmr),
+		                    expiry);
 
-		slot = (slot + 1) & ETUX_TIMER_HWHEEL_SLOT_MASK;
-	} while (slot != start);
+	*issue = expiry;
 
-	if (!missing) {
-		*issue = expiry;
-		return (int)(start && (slot >= start));
-	}
-
-	return -1;
+	return (int)(start && ((start + off) < nr));
 }
 
 static __utils_nonull(1) __utils_pure __utils_nothrow __warn_result
 int64_t
-etux_timer_hwheel_find_issue(struct etux_timer_hwheel * __restrict hwheel)
+etux_timer_hwheel_find_issue(const struct etux_timer_hwheel * __restrict hwheel)
 {
 	etux_timer_assert_intern(hwheel);
 
@@ -481,15 +877,16 @@ etux_timer_hwheel_find_issue(struct etux_timer_hwheel * __restrict hwheel)
 	int          res;
 	unsigned int lvl;
 
-	res = etux_timer_hwheel_early_expiry(hwheel->slots[0], tick, &issue);
+	res = etux_timer_hwheel_early_expiry(hwheel, tick, &issue);
 	if (res > 0)
 		/* Next expiry found and no further cascading needed. */
 		return issue;
 
-	for (lvl = 1; lvl < ETUX_TIMER_HWHEEL_LEVELS_NR; lvl++) {
-		tick = (tick + ETUX_TIMER_HWHEEL_SLOT_MASK) >>
-		       ETUX_TIMER_HWHEEL_SLOT_BITS;
-		res = etux_timer_hwheel_cascade_expiry(hwheel->slots[lvl],
+	for (lvl = 1; lvl < hwheel->levels; lvl++) {
+		tick = (tick + etux_timer_hwheel_slot_mask(hwheel)) >>
+		       hwheel->bits;
+		res = etux_timer_hwheel_cascade_expiry(hwheel,
+		                                       lvl,
 		                                       res,
 		                                       tick,
 		                                       &issue);
@@ -498,8 +895,10 @@ etux_timer_hwheel_find_issue(struct etux_timer_hwheel * __restrict hwheel)
 			return issue;
 	}
 
-	if (!stroll_dlist_empty(&hwheel->eternal)) {
-		tick = etux_timer_list_lead_timer(&hwheel->eternal)->tick;
+	if (!stroll_pprheap_base_isempty(&hwheel->eternal)) {
+		tick = etux_timer_hwheel_timer_tick(
+			hwheel,
+			etux_timer_hwheel_eternal_lead(hwheel));
 		issue = stroll_min(tick, issue);
 	}
 
@@ -510,87 +909,238 @@ etux_timer_hwheel_find_issue(struct etux_timer_hwheel * __restrict hwheel)
 }
 
 int64_t
-etux_timer_issue_tick(void)
+etux_timer_base_issue_tick(struct etux_timer_base * __restrict base)
 {
-	if (!etux_timer_the_hwheel.count)
+	etux_timer_assert_intern(base);
+
+	struct etux_timer_hwheel * hwheel = &base->hwheel;
+
+	if (!hwheel->count)
 		return (int64_t)-ENOENT;
 
-	if (etux_timer_the_hwheel.issue <= etux_timer_the_hwheel.tick)
-		etux_timer_the_hwheel.issue =
-			etux_timer_hwheel_find_issue(&etux_timer_the_hwheel);
+	if (hwheel->issue <= hwheel->tick)
+		hwheel->issue = etux_timer_hwheel_find_issue(hwheel);
 
-	return etux_timer_the_hwheel.issue;
+	return hwheel->issue << hwheel->shift;
 }
 
 void
-etux_timer_run(void)
+etux_timer_base_run(struct etux_timer_base * base)
 {
-	struct timespec now;
-	int64_t         tick;
+	etux_timer_assert_api(base);
+
+	struct etux_timer_hwheel * hwheel = &base->hwheel;
+	struct timespec            now;
+	int64_t                    tick;
+	int64_t                    wtick;
 
 	etux_timer_run_trace_enter();
 
-	tick = etux_timer_tick_load(&now);
-	while (tick >= etux_timer_the_hwheel.tick) {
-		unsigned int               slot;
-		struct stroll_dlist_node * expired;
+	etux_timer_base_cache_clock(base);
+	etux_timer_remote_drain(base);
 
-		if (!etux_timer_the_hwheel.count) {
-			etux_timer_the_hwheel.tick = tick;
+	tick = etux_timer_tick_load(&now);
+	wtick = tick >> hwheel->shift;
+	while (wtick >= hwheel->tick) {
+		unsigned int             slot;
+		uint64_t                 bit;
+		struct stroll_dlist_node expired = STROLL_DLIST_INIT(expired);
+
+		if (!hwheel->count) {
+			hwheel->tick = wtick;
 			goto out;
 		}
 
-		slot = etux_timer_the_hwheel.tick & ETUX_TIMER_HWHEEL_SLOT_MASK;
-		expired = &etux_timer_the_hwheel.slots[0][slot];
-
+		slot = (unsigned int)
+		       (hwheel->tick & etux_timer_hwheel_slot_mask(hwheel));
 		if (!slot)
-			etux_timer_hwheel_cascade(&etux_timer_the_hwheel);
-
-		etux_timer_the_hwheel.tick++;
+			etux_timer_hwheel_cascade(hwheel);
+
+		bit = etux_timer_hwheel_slot_bit(slot);
+		if (!(hwheel->bitmaps[0] & bit)) {
+			/*
+			 * Current slot is empty: skip to the next occupied
+			 * one, the next cascading boundary or the current
+			 * tick, whichever comes first.
+			 */
+			uint64_t bmap = hwheel->bitmaps[0] >> slot;
+			int64_t  skip;
+
+			skip = bmap ? etux_timer_hwheel_first_slot(bmap) :
+			              etux_timer_hwheel_slots_nr(hwheel) - slot;
+			hwheel->tick = stroll_min(hwheel->tick + skip,
+			                          wtick + 1);
+			continue;
+		}
 
-		while (!stroll_dlist_empty(expired)) {
+		/*
+		 * Move expired timers out of the current slot so that timers
+		 * (re)armed from within expiry callbacks and enlisted into
+		 * this very same slot are not expired one wheel rotation
+		 * early.
+		 */
+		hwheel->bitmaps[0] &= ~bit;
+		stroll_dlist_splice_after(
+			&expired,
+			stroll_dlist_next(etux_timer_hwheel_slot(hwheel,
+			                                         0,
+			                                         slot)),
+			stroll_dlist_prev(etux_timer_hwheel_slot(hwheel,
+			                                         0,
+			                                         slot)));
+		hwheel->tick++;
+
+		while (!stroll_dlist_empty(&expired)) {
 			struct etux_timer * tmr =
-				etux_timer_list_lead_timer(expired);
+				etux_timer_list_lead_timer(&expired);
 
 			etux_timer_assert_intern(tick >= tmr->tick);
 
 			tmr->state = ETUX_TIMER_RUN_STAT;
+			etux_timer_stats_expire(base, tmr, tick);
+			if (tmr->period)
+				etux_timer_count_overrun(tmr, tick);
+
+			if (etux_timer_pool_enabled(base)) {
+				etux_timer_hwheel_dismiss(hwheel, tmr);
+				hwheel->count--;
+				etux_timer_pool_submit(base, tmr);
+				continue;
+			}
 
 			etux_timer_expire_trace_enter(tmr, &now, tick);
 			tmr->expire(tmr);
 			etux_timer_expire_trace_exit(tmr);
 
 			if (tmr->state == ETUX_TIMER_RUN_STAT) {
-				tmr->state = ETUX_TIMER_IDLE_STAT;
-				stroll_dlist_remove(&tmr->list);
-				etux_timer_the_hwheel.count--;
+				if (!tmr->period) {
+					tmr->state = ETUX_TIMER_IDLE_STAT;
+					etux_timer_stats_idle(base);
+					etux_timer_hwheel_dismiss(hwheel, tmr);
+					hwheel->count--;
+				}
+				else {
+					etux_timer_forward(tmr, tick);
+					etux_timer_hwheel_resched(hwheel, tmr);
+				}
 			}
 		}
 
 		tick = etux_timer_tick_load(&now);
+		wtick = tick >> hwheel->shift;
 	}
 
 out:
 	etux_timer_run_trace_exit();
 }
 
-/* TODO: expose timer library init API ?? */
-static __ctor() __utils_nothrow
+static __utils_nonull(1, 5) __utils_nothrow
 void
-etux_timer_ctor(void)
+etux_timer_hwheel_init(struct etux_timer_hwheel * __restrict hwheel,
+                       unsigned int                          bits,
+                       unsigned int                          levels,
+                       unsigned int                          shift,
+                       struct stroll_dlist_node *            slots)
 {
-	unsigned int lvl;
+	etux_timer_assert_intern(hwheel);
+	etux_timer_assert_intern(bits);
+	etux_timer_assert_intern(bits <= ETUX_TIMER_HWHEEL_SLOT_BITS_MAX);
+	etux_timer_assert_intern(levels);
+	etux_timer_assert_intern(levels <= ETUX_TIMER_HWHEEL_LEVELS_MAX);
+	etux_timer_assert_intern(shift <= ETUX_TIMER_HWHEEL_TICK_SHIFT_MAX);
+	etux_timer_assert_intern(slots);
+
+	unsigned int s;
+
+	hwheel->count = 0;
+	hwheel->bits = bits;
+	hwheel->levels = levels;
+	hwheel->shift = shift;
+	hwheel->slots = slots;
+	hwheel->tick = etux_timer_hwheel_tick(hwheel);
+	hwheel->issue = hwheel->tick;
+
+	for (s = 0; s < levels; s++)
+		hwheel->bitmaps[s] = 0;
+
+	for (s = 0; s < (levels << bits); s++)
+		stroll_dlist_init(&slots[s]);
+
+	stroll_pprheap_base_init(&hwheel->eternal);
+}
+
+#if defined(CONFIG_ETUX_TIMER_POOL)
+
+void
+etux_timer_base_resume(struct etux_timer_base * __restrict base,
+                       struct etux_timer * __restrict      timer)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(timer->state == ETUX_TIMER_RUN_STAT);
 
-	etux_timer_the_hwheel.count = 0;
-	etux_timer_the_hwheel.tick = etux_timer_hwheel_tick();
-	etux_timer_the_hwheel.issue = etux_timer_the_hwheel.tick;
+	timer->state = ETUX_TIMER_IDLE_STAT;
+	etux_timer_hwheel_arm(&base->hwheel, timer, NULL);
+}
 
-	for (lvl = 0; lvl < ETUX_TIMER_HWHEEL_LEVELS_NR; lvl++) {
-		unsigned int slot;
+#endif /* defined(CONFIG_ETUX_TIMER_POOL) */
 
-		for (slot = 0; slot < ETUX_TIMER_HWHEEL_SLOTS_PER_WHEEL; slot++)
-			stroll_dlist_init(
-				&etux_timer_the_hwheel.slots[lvl][slot]);
+int
+etux_timer_base_init_hwheel(struct etux_timer_base * __restrict base,
+                            unsigned int                        slot_bits,
+                            unsigned int                        levels,
+                            unsigned int                        tick_shift)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_api(slot_bits);
+	etux_timer_assert_api(slot_bits <= ETUX_TIMER_HWHEEL_SLOT_BITS_MAX);
+	etux_timer_assert_api(levels);
+	etux_timer_assert_api(levels <= ETUX_TIMER_HWHEEL_LEVELS_MAX);
+	etux_timer_assert_api(tick_shift <= ETUX_TIMER_HWHEEL_TICK_SHIFT_MAX);
+
+	struct etux_timer_hwheel * hwheel = &base->hwheel;
+	struct stroll_dlist_node * slots;
+
+	if ((levels << slot_bits) > stroll_array_nr(hwheel->dflt)) {
+		slots = malloc((levels << slot_bits) * sizeof(slots[0]));
+		if (!slots)
+			return -ENOMEM;
 	}
-	stroll_dlist_init(&etux_timer_the_hwheel.eternal);
+	else
+		slots = hwheel->dflt;
+
+	etux_timer_hwheel_init(hwheel, slot_bits, levels, tick_shift, slots);
+
+	etux_timer_remote_init(base);
+	etux_timer_stats_init(base);
+	etux_timer_clock_init(base);
+
+	return 0;
+}
+
+void
+etux_timer_base_init(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_api(base);
+
+	etux_timer_hwheel_init(&base->hwheel,
+	                       ETUX_TIMER_HWHEEL_SLOT_BITS,
+	                       ETUX_TIMER_HWHEEL_DFLT_LEVELS,
+	                       0,
+	                       base->hwheel.dflt);
+
+	etux_timer_remote_init(base);
+	etux_timer_stats_init(base);
+	etux_timer_clock_init(base);
+}
+
+void
+etux_timer_base_fini(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_api(!base->hwheel.count);
+
+	if (base->hwheel.slots != base->hwheel.dflt)
+		free(base->hwheel.slots);
+
+	etux_timer_remote_fini(base);
 }
@@ -0,0 +1,33 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Utils.
+ * Copyright (C) 2017-2024 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+/*
+ * Hybrid timing wheel / heap based implementation.
+ *
+ * Relies upon the hierarchical timing wheel logic with a shallow default
+ * wheel covering at least 64 seconds whatever CONFIG_ETUX_TIMER_SUBSEC_BITS
+ * is:
+ * - near timers, typically short timeouts that get canceled before expiry,
+ *   are armed and canceled at O(1) cost into the wheel ;
+ * - far timers, typically long leases, are kept into the eternal pairing heap
+ *   and migrated to the wheel once they enter its range, saving the multi
+ *   level cascading churn of a deep wheel.
+ *
+ * The table below gives the number of wheel levels and the range covered by
+ * the wheel according to CONFIG_ETUX_TIMER_SUBSEC_BITS values:
+ *
+ *     CONFIG_ETUX_TIMER_SUBSEC_BITS  Levels  Range (seconds)
+ *                                 0       1               64
+ *                             1 - 6       2        2048 - 64
+ *                            7 - 12       3        2048 - 64
+ *                           13 - 18       4        2048 - 64
+ *                           19 - 20       5      2048 - 1024
+ */
+#define ETUX_TIMER_HWHEEL_DFLT_LEVELS \
+	(1U + ((ETUX_TIMER_TICK_SUBSEC_BITS + 5U) / 6U))
+
+#include "hwheel.c"
@@ -8,9 +8,6 @@
 #include "common.h"
 #include <errno.h>
 
-static struct stroll_dlist_node etux_timer_the_list =
-	STROLL_DLIST_INIT(etux_timer_the_list);
-
 static __utils_nonull(1, 2) __utils_nothrow
 void
 etux_timer_list_insert(struct stroll_dlist_node * __restrict nodes,
@@ -58,7 +55,7 @@ etux_timer_list_arm(struct stroll_dlist_node * __restrict nodes,
 
 	int64_t tick;
 
-	tick = etux_timer_tick_from_tspec_upper_clamp(&timer->tspec);
+	tick = etux_timer_expiry_tick(timer);
 
 	switch (timer->state) {
 	case ETUX_TIMER_IDLE_STAT:
@@ -81,63 +78,87 @@ STROLL_RESTORE_WARN
 }
 
 void
-etux_timer_arm_tspec(struct etux_timer * __restrict     timer,
-                     const struct timespec * __restrict tspec)
+etux_timer_base_arm_tspec(struct etux_timer_base * __restrict base,
+                          struct etux_timer * __restrict      timer,
+                          const struct timespec * __restrict  tspec)
 {
+	etux_timer_assert_api(base);
 	etux_timer_assert_timer_api(timer);
+	etux_timer_assert_pool_api(timer);
 	etux_timer_assert_api(timer->expire);
 	utime_assert_tspec_api(tspec);
 
 	etux_timer_arm_tspec_trace_enter(timer, tspec);
 
 	timer->tspec = *tspec;
-	etux_timer_list_arm(&etux_timer_the_list, timer);
+	etux_timer_stats_arm(base, timer);
+	etux_timer_list_arm(&base->list, timer);
 
 	etux_timer_arm_tspec_trace_exit(timer);
 }
 
 void
-etux_timer_arm_msec(struct etux_timer * __restrict timer, int msec)
+etux_timer_base_arm_msec(struct etux_timer_base * __restrict base,
+                         struct etux_timer * __restrict      timer,
+                         int                                 msec)
 {
+	etux_timer_assert_api(base);
 	etux_timer_assert_timer_api(timer);
+	etux_timer_assert_pool_api(timer);
 	etux_timer_assert_api(timer->expire);
 	etux_timer_assert_api(msec >= 0);
 
 	etux_timer_arm_msec_trace_enter(timer, msec);
 
-	utime_monotonic_now(&timer->tspec);
+	etux_timer_base_now(base, &timer->tspec);
 	utime_tspec_add_msec_clamp(&timer->tspec, msec);
 
-	etux_timer_list_arm(&etux_timer_the_list, timer);
+	etux_timer_stats_arm(base, timer);
+	etux_timer_list_arm(&base->list, timer);
 
 	etux_timer_arm_msec_trace_exit(timer);
 }
 
 void
-etux_timer_arm_sec(struct etux_timer * __restrict timer, int sec)
+etux_timer_base_arm_sec(struct etux_timer_base * __restrict base,
+                        struct etux_timer * __restrict      timer,
+                        int                                 sec)
 {
+	etux_timer_assert_api(base);
 	etux_timer_assert_timer_api(timer);
+	etux_timer_assert_pool_api(timer);
 	etux_timer_assert_api(timer->expire);
 	etux_timer_assert_api(sec >= 0);
 
 	etux_timer_arm_sec_trace_enter(timer, sec);
 
-	utime_monotonic_now(&timer->tspec);
+	etux_timer_base_now(base, &timer->tspec);
 	utime_tspec_add_sec_clamp(&timer->tspec, sec);
 
-	etux_timer_list_arm(&etux_timer_the_list, timer);
+	etux_timer_stats_arm(base, timer);
+	etux_timer_list_arm(&base->list, timer);
 
 	etux_timer_arm_sec_trace_exit(timer);
 }
 
 void
-etux_timer_cancel(struct etux_timer * __restrict timer)
+etux_timer_base_cancel(struct etux_timer_base * __restrict base,
+                       struct etux_timer * __restrict      timer)
 {
+	etux_timer_assert_api(base);
 	etux_timer_assert_timer_api(timer);
+	etux_timer_assert_pool_api(timer);
 
 	etux_timer_cancel_trace_enter(timer);
 
-	if (timer->state == ETUX_TIMER_PEND_STAT) {
+	/*
+	 * A running timer is canceled from its own expiry callback: it is
+	 * still linked into the list and making it idle prevents
+	 * etux_timer_base_run() from rearming it.
+	 */
+	if ((timer->state == ETUX_TIMER_PEND_STAT) ||
+	    (timer->state == ETUX_TIMER_RUN_STAT)) {
+		etux_timer_stats_cancel(base);
 		timer->state = ETUX_TIMER_IDLE_STAT;
 		stroll_dlist_remove(&timer->list);
 	}
@@ -145,27 +166,78 @@ etux_timer_cancel(struct etux_timer * __restrict timer)
 	etux_timer_cancel_trace_exit(timer);
 }
 
+void
+etux_timer_base_arm_many(struct etux_timer_base * __restrict    base,
+                         struct etux_timer * const * __restrict timers,
+                         unsigned int                           nr,
+                         const struct timespec * __restrict     tspec,
+                         const struct timespec * __restrict     now __unused)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(timers);
+	etux_timer_assert_intern(tspec);
+
+	unsigned int t;
+
+	for (t = 0; t < nr; t++) {
+		struct etux_timer * tmr = timers[t];
+
+		etux_timer_assert_timer_api(tmr);
+		etux_timer_assert_pool_api(tmr);
+		etux_timer_assert_api(tmr->expire);
+
+		etux_timer_arm_tspec_trace_enter(tmr, tspec);
+
+		tmr->tspec = *tspec;
+		etux_timer_stats_arm(base, tmr);
+		etux_timer_list_arm(&base->list, tmr);
+
+		etux_timer_arm_tspec_trace_exit(tmr);
+	}
+}
+
+void
+etux_timer_base_cancel_many(struct etux_timer_base * __restrict    base,
+                            struct etux_timer * const * __restrict timers,
+                            unsigned int                           nr)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_api(timers);
+
+	unsigned int t;
+
+	for (t = 0; t < nr; t++)
+		etux_timer_base_cancel(base, timers[t]);
+}
+
 int64_t
-etux_timer_issue_tick(void)
+etux_timer_base_issue_tick(struct etux_timer_base * __restrict base)
 {
-	if (!stroll_dlist_empty(&etux_timer_the_list))
-		return etux_timer_list_lead_timer(&etux_timer_the_list)->tick;
+	etux_timer_assert_intern(base);
+
+	if (!stroll_dlist_empty(&base->list))
+		return etux_timer_list_lead_timer(&base->list)->tick;
 	else
 		return (int64_t)-ENOENT;
 }
 
 void
-etux_timer_run(void)
+etux_timer_base_run(struct etux_timer_base * base)
 {
+	etux_timer_assert_api(base);
+
 	int64_t         tick = -1;
 	struct timespec now;
 
 	etux_timer_run_trace_enter();
 
-	while (!stroll_dlist_empty(&etux_timer_the_list)) {
+	etux_timer_base_cache_clock(base);
+	etux_timer_remote_drain(base);
+
+	while (!stroll_dlist_empty(&base->list)) {
 		struct etux_timer * tmr;
 
-		tmr = etux_timer_list_lead_timer(&etux_timer_the_list);
+		tmr = etux_timer_list_lead_timer(&base->list);
 		if (tick < tmr->tick) {
 			tick = etux_timer_tick_load(&now);
 			if (tick < tmr->tick)
@@ -173,17 +245,69 @@ etux_timer_run(void)
 		}
 
 		tmr->state = ETUX_TIMER_RUN_STAT;
+		etux_timer_stats_expire(base, tmr, tick);
+		if (tmr->period)
+			etux_timer_count_overrun(tmr, tick);
+
+		if (etux_timer_pool_enabled(base)) {
+			stroll_dlist_remove(&tmr->list);
+			etux_timer_pool_submit(base, tmr);
+			continue;
+		}
 
 		etux_timer_expire_trace_enter(tmr, &now, tick);
 		tmr->expire(tmr);
 		etux_timer_expire_trace_exit(tmr);
 
 		if (tmr->state == ETUX_TIMER_RUN_STAT) {
-			tmr->state = ETUX_TIMER_IDLE_STAT;
-			stroll_dlist_remove(&tmr->list);
+			if (!tmr->period) {
+				tmr->state = ETUX_TIMER_IDLE_STAT;
+				etux_timer_stats_idle(base);
+				stroll_dlist_remove(&tmr->list);
+			}
+			else {
+				etux_timer_forward(tmr, tick);
+				etux_timer_list_arm(&base->list, tmr);
+			}
 		}
 	}
 
 out:
 	etux_timer_run_trace_exit();
 }
+
+#if defined(CONFIG_ETUX_TIMER_POOL)
+
+void
+etux_timer_base_resume(struct etux_timer_base * __restrict base,
+                       struct etux_timer * __restrict      timer)
+{
+	etux_timer_assert_intern(base);
+	etux_timer_assert_intern(timer->state == ETUX_TIMER_RUN_STAT);
+
+	timer->state = ETUX_TIMER_IDLE_STAT;
+	etux_timer_list_arm(&base->list, timer);
+}
+
+#endif /* defined(CONFIG_ETUX_TIMER_POOL) */
+
+void
+etux_timer_base_init(struct etux_timer_base * __restrict base)
+{
+	etux_timer_assert_api(base);
+
+	stroll_dlist_init(&base->list);
+
+	etux_timer_remote_init(base);
+	etux_timer_stats_init(base);
+	etux_timer_clock_init(base);
+}
+
+void
+etux_timer_base_fini(struct etux_timer_base * __restrict base __unused)
+{
+	etux_timer_assert_api(base);
+	etux_timer_assert_api(stroll_dlist_empty(&base->list));
+
+	etux_timer_remote_fini(base);
+}
@@ -0,0 +1,169 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Utils.
+ * Copyright (C) 2017-2024 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "common.h"
+#include "utils/fd.h"
+#include <sys/timerfd.h>
+#include <errno.h>
+
+#define etux_timer_assert_poll_api(_tpoll) \
+	etux_timer_assert_api(_tpoll); \
+	etux_timer_assert_api((_tpoll)->fd >= 0); \
+	etux_timer_assert_api((_tpoll)->tick >= -1); \
+	etux_timer_assert_api((_tpoll)->tick <= ETUX_TIMER_TICK_MAX); \
+	etux_timer_assert_api((_tpoll)->base)
+
+void
+etux_timer_poll_update(struct etux_timer_poll * __restrict tpoll)
+{
+	etux_timer_assert_poll_api(tpoll);
+
+	int64_t           tick;
+	struct itimerspec itspec = { .it_interval = { 0, 0 } };
+	int               err __unused;
+
+	tick = etux_timer_base_issue_tick(tpoll->base);
+	if (tick < 0)
+		tick = -1;
+
+	if (tick == tpoll->tick)
+		/* Lead expiry unchanged: no need to reprogram timerfd. */
+		return;
+
+	if (tick >= 0) {
+		itspec.it_value = etux_timer_tspec_from_tick(tick);
+		if (!itspec.it_value.tv_sec && !itspec.it_value.tv_nsec)
+			/* A zero expiry date would disarm timerfd... */
+			itspec.it_value.tv_nsec = 1;
+	}
+	else
+		/* Disarm timerfd. */
+		itspec.it_value = itspec.it_interval;
+
+	/*
+	 * Cannot fail if proper arguments are given...
+	 * See <linux>/fs/timerfd.c
+	 */
+	err = timerfd_settime(tpoll->fd, TFD_TIMER_ABSTIME, &itspec, NULL);
+	etux_timer_assert_intern(!err);
+
+	tpoll->tick = tick;
+}
+
+static __utils_nonull(1)
+int
+etux_timer_poll_dispatch(struct upoll_worker * worker,
+                         uint32_t              events __unused,
+                         const struct upoll *  poller __unused)
+{
+	etux_timer_assert_intern(worker);
+	etux_timer_assert_intern(events & EPOLLIN);
+	etux_timer_assert_intern(poller);
+
+	struct etux_timer_poll * tpoll = containerof(worker,
+	                                             struct etux_timer_poll,
+	                                             work);
+	uint64_t                 cnt;
+	ssize_t                  ret __unused;
+
+	etux_timer_assert_poll_api(tpoll);
+
+	ret = ufd_read(tpoll->fd, (char *)&cnt, sizeof(cnt));
+	etux_timer_assert_intern((ret == (ssize_t)sizeof(cnt)) ||
+	                         (ret == -EAGAIN));
+
+	/*
+	 * timerfd is disarmed once expired: invalidate programmed tick to
+	 * enforce reprogramming at update time.
+	 */
+	tpoll->tick = -1;
+
+	etux_timer_base_run(tpoll->base);
+	etux_timer_poll_update(tpoll);
+
+	return 0;
+}
+
+int
+etux_timer_poll_process(struct etux_timer_poll * tpoll,
+                        const struct upoll *     poller)
+{
+	etux_timer_assert_poll_api(tpoll);
+	etux_timer_assert_api(poller);
+
+	int ret;
+
+	etux_timer_poll_update(tpoll);
+
+	ret = upoll_wait(poller, -1);
+	if (ret < 0)
+		return ret;
+
+	/*
+	 * Refresh cached clock sample right after wakeup so that timers armed
+	 * by event handlers are computed from an up-to-date date.
+	 */
+	etux_timer_base_cache_clock(tpoll->base);
+
+	return upoll_dispatch(poller, (unsigned int)ret);
+}
+
+int
+etux_timer_base_poll_open(struct etux_timer_poll * __restrict tpoll,
+                          struct etux_timer_base *            base,
+                          const struct upoll * __restrict     poller)
+{
+	etux_timer_assert_api(tpoll);
+	etux_timer_assert_api(base);
+	etux_timer_assert_api(poller);
+
+	int fd;
+	int err;
+
+	fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (fd < 0) {
+		etux_timer_assert_intern(errno != EINVAL);
+		return -errno;
+	}
+
+	err = upoll_register_dispatch(poller,
+	                              fd,
+	                              EPOLLIN,
+	                              &tpoll->work,
+	                              etux_timer_poll_dispatch);
+	if (err) {
+		ufd_close(fd);
+		return err;
+	}
+
+	tpoll->fd = fd;
+	tpoll->tick = -1;
+	tpoll->base = base;
+
+	etux_timer_poll_update(tpoll);
+
+	return 0;
+}
+
+int
+etux_timer_poll_open(struct etux_timer_poll * __restrict tpoll,
+                     const struct upoll * __restrict     poller)
+{
+	return etux_timer_base_poll_open(tpoll, &etux_timer_dflt_base, poller);
+}
+
+void
+etux_timer_poll_close(struct etux_timer_poll * __restrict tpoll,
+                      const struct upoll * __restrict     poller)
+{
+	etux_timer_assert_poll_api(tpoll);
+	etux_timer_assert_api(poller);
+
+	upoll_discard(poller, &tpoll->work);
+	upoll_unregister(poller, tpoll->fd);
+	ufd_close(tpoll->fd);
+}